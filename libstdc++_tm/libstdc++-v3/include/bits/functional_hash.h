@@ -206,6 +206,20 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     struct __is_fast_hash<hash<long double>> : public std::false_type
     { };
 
+  // Wrapper that makes the hash based containers cache the hash code of
+  // _Hash in every node, no matter how cheap _Hash is.  Under TM a cached
+  // code lets rehashing and bucket-boundary checks use the node's stored
+  // code instead of re-reading the key, which keeps keys (and, for string
+  // keys, their character buffers) out of the transaction's read set.
+  // Usage: std::unordered_map<int, T, std::__cache_hash_code<hash<int>>>.
+  template<typename _Hash>
+    struct __cache_hash_code : public _Hash
+    { using _Hash::_Hash; };
+
+  template<typename _Hash>
+    struct __is_fast_hash<__cache_hash_code<_Hash>> : public std::false_type
+    { };
+
 _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace
 
@@ -33,17 +33,25 @@
 #pragma GCC system_header
 
 #include <bits/hashtable_policy.h>
+#include <bits/node_handle.h>
 
 namespace std _GLIBCXX_VISIBILITY(default)
 {
 _GLIBCXX_BEGIN_NAMESPACE_VERSION
 
+#ifdef _GLIBCXX_TM_CACHE_HASH_CODE
+  // Build-wide override: every unordered container caches its hash codes.
+  // See __cache_hash_code in functional_hash.h for the per-container form.
+  template<typename _Tp, typename _Hash>
+    using __cache_default = true_type;
+#else
   template<typename _Tp, typename _Hash>
     using __cache_default
       =  __not_<__and_<// Do not cache for fast hasher.
 		       __is_fast_hash<_Hash>,
 		       // Mandatory to have erase not throwing.
 		       __detail::__is_noexcept_hash<_Tp, _Hash>>>;
+#endif
 
   /**
    *  Primary class template _Hashtable.
@@ -746,6 +754,45 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       void
       clear() noexcept;
 
+      // Node handles (see bits/node_handle.h): extract unlinks a node
+      // without freeing it, and the reinsert and the merge link in nodes
+      // that were made for another table, without allocating.
+      using node_type = _Node_handle<_Key, _Value, __node_alloc_type>;
+      using insert_return_type = _Node_insert_return<iterator, node_type>;
+
+      node_type
+      extract(const_iterator __pos)
+      {
+	__node_type* __n = __pos._M_cur;
+	size_type __bkt = _M_bucket_index(__n);
+	return _M_extract_node(__bkt, _M_get_previous_node(__bkt, __n));
+      }
+
+      node_type
+      extract(const _Key& __k)
+      {
+	__hash_code __code = this->_M_hash_code(__k);
+	size_type __bkt = _M_bucket_index(__k, __code);
+	if (__node_base* __prev_n = _M_find_before_node(__bkt, __k, __code))
+	  return _M_extract_node(__bkt, __prev_n);
+	return node_type();
+      }
+
+      // Reinsert when keys are unique.
+      insert_return_type
+      _M_reinsert_node(node_type&& __nh);
+
+      // Reinsert when keys are unique, with a hint that a table has no use
+      // for.  If the key is there already, __nh keeps the node.
+      iterator
+      _M_reinsert_node_hint(const_iterator __hint, node_type&& __nh);
+
+      // Move every node of __src whose key is not in this table yet over
+      // to this one.  The tables may differ in their hash and equality.
+      template<typename _Compatible_Hashtable>
+	void
+	_M_merge_unique(_Compatible_Hashtable& __src);
+
       // Set number of buckets to be appropriate for container of n element.
       void rehash(size_type __n);
 
@@ -753,6 +800,16 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       // reserve, if present, comes from _Rehash_base.
 
     private:
+      // Unlink the node after __prev_n, in bucket __bkt, into a handle.
+      node_type
+      _M_extract_node(size_type __bkt, __node_base* __prev_n);
+
+      // Rehash now if one more element needs it, so that the
+      // _M_insert_unique_node of a node that a handle still owns cannot
+      // throw, and free the node.
+      void
+      _M_rehash_for_one_more();
+
       // Helper rehash method used when keys are unique.
       void _M_rehash_aux(size_type __n, std::true_type);
 
@@ -1010,7 +1067,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	       _H1, _H2, _Hash, _RehashPolicy, _Traits>::
     _M_move_assign(_Hashtable&& __ht, std::true_type)
     {
-      this->_M_deallocate_nodes(_M_begin());
+      if (!this->_M_defer_nodes(_M_begin()))
+	this->_M_deallocate_nodes(_M_begin());
       _M_deallocate_buckets();
       __hashtable_base::operator=(std::move(__ht));
       _M_rehash_policy = __ht._M_rehash_policy;
@@ -1938,12 +1996,161 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	       _H1, _H2, _Hash, _RehashPolicy, _Traits>::
     clear() noexcept
     {
+      // Under TM, leave the nodes to a commit action, and give the bucket
+      // array back as a moved-from table does, so that the transaction
+      // neither frees every node nor writes every bucket
+      if (this->_M_defer_nodes(_M_begin()))
+	{
+	  _M_deallocate_buckets();
+	  _M_reset();
+	  return;
+	}
       this->_M_deallocate_nodes(_M_begin());
       __builtin_memset(_M_buckets, 0, _M_bucket_count * sizeof(__bucket_type));
       _M_element_count = 0;
       _M_before_begin._M_nxt = nullptr;
     }
 
+  template<typename _Key, typename _Value,
+	   typename _Alloc, typename _ExtractKey, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash, typename _RehashPolicy,
+	   typename _Traits>
+    typename _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+			_H1, _H2, _Hash, _RehashPolicy,
+			_Traits>::node_type
+    _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+	       _H1, _H2, _Hash, _RehashPolicy, _Traits>::
+    _M_extract_node(size_type __bkt, __node_base* __prev_n)
+    {
+      __node_type* __n = static_cast<__node_type*>(__prev_n->_M_nxt);
+      if (__prev_n == _M_buckets[__bkt])
+	_M_remove_bucket_begin(__bkt, __n->_M_next(),
+	   __n->_M_nxt ? _M_bucket_index(__n->_M_next()) : 0);
+      else if (__n->_M_nxt)
+	{
+	  size_type __next_bkt = _M_bucket_index(__n->_M_next());
+	  if (__next_bkt != __bkt)
+	    _M_buckets[__next_bkt] = __prev_n;
+	}
+
+      __prev_n->_M_nxt = __n->_M_nxt;
+      __n->_M_nxt = nullptr;
+      --_M_element_count;
+      return node_type(__n, this->_M_node_allocator());
+    }
+
+  template<typename _Key, typename _Value,
+	   typename _Alloc, typename _ExtractKey, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash, typename _RehashPolicy,
+	   typename _Traits>
+    void
+    _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+	       _H1, _H2, _Hash, _RehashPolicy, _Traits>::
+    _M_rehash_for_one_more()
+    {
+      const __rehash_state& __saved_state = _M_rehash_policy._M_state();
+      std::pair<bool, std::size_t> __do_rehash
+	= _M_rehash_policy._M_need_rehash(_M_bucket_count, _M_element_count, 1);
+      if (__do_rehash.first)
+	_M_rehash(__do_rehash.second, __saved_state);
+    }
+
+  template<typename _Key, typename _Value,
+	   typename _Alloc, typename _ExtractKey, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash, typename _RehashPolicy,
+	   typename _Traits>
+    typename _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+			_H1, _H2, _Hash, _RehashPolicy,
+			_Traits>::insert_return_type
+    _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+	       _H1, _H2, _Hash, _RehashPolicy, _Traits>::
+    _M_reinsert_node(node_type&& __nh)
+    {
+      insert_return_type __ret;
+      if (__nh.empty())
+	{
+	  __ret.position = end();
+	  return __ret;
+	}
+
+      const key_type& __k = this->_M_extract()(__nh._M_ptr->_M_v());
+      __hash_code __code = this->_M_hash_code(__k);
+      size_type __bkt = _M_bucket_index(__k, __code);
+      if (__node_type* __n = _M_find_node(__bkt, __k, __code))
+	{
+	  __ret.node = std::move(__nh);
+	  __ret.position = iterator(__n);
+	  return __ret;
+	}
+
+      _M_rehash_for_one_more();
+      __bkt = _M_bucket_index(__k, __code);
+      __ret.position = _M_insert_unique_node(__bkt, __code, __nh._M_ptr);
+      __nh._M_release();
+      __ret.inserted = true;
+      return __ret;
+    }
+
+  template<typename _Key, typename _Value,
+	   typename _Alloc, typename _ExtractKey, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash, typename _RehashPolicy,
+	   typename _Traits>
+    typename _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+			_H1, _H2, _Hash, _RehashPolicy,
+			_Traits>::iterator
+    _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+	       _H1, _H2, _Hash, _RehashPolicy, _Traits>::
+    _M_reinsert_node_hint(const_iterator, node_type&& __nh)
+    {
+      if (__nh.empty())
+	return end();
+
+      const key_type& __k = this->_M_extract()(__nh._M_ptr->_M_v());
+      __hash_code __code = this->_M_hash_code(__k);
+      size_type __bkt = _M_bucket_index(__k, __code);
+      if (__node_type* __n = _M_find_node(__bkt, __k, __code))
+	return iterator(__n);
+
+      _M_rehash_for_one_more();
+      __bkt = _M_bucket_index(__k, __code);
+      iterator __ret = _M_insert_unique_node(__bkt, __code, __nh._M_ptr);
+      __nh._M_release();
+      return __ret;
+    }
+
+  template<typename _Key, typename _Value,
+	   typename _Alloc, typename _ExtractKey, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash, typename _RehashPolicy,
+	   typename _Traits>
+    template<typename _Compatible_Hashtable>
+      void
+      _Hashtable<_Key, _Value, _Alloc, _ExtractKey, _Equal,
+		 _H1, _H2, _Hash, _RehashPolicy, _Traits>::
+      _M_merge_unique(_Compatible_Hashtable& __src)
+      {
+	static_assert(is_same<typename _Compatible_Hashtable::node_type,
+			      node_type>::value,
+		      "merge needs a table with the same node type");
+
+	for (auto __i = __src.begin(), __end = __src.end(); __i != __end;)
+	  {
+	    auto __pos = __i++;
+	    const key_type& __k = this->_M_extract()(*__pos);
+	    __hash_code __code = this->_M_hash_code(__k);
+	    size_type __bkt = _M_bucket_index(__k, __code);
+	    if (_M_find_node(__bkt, __k, __code))
+	      continue;
+
+	    // Grow before the node leaves __src, so that nothing can throw
+	    // while it is in neither table
+	    _M_rehash_for_one_more();
+	    __bkt = _M_bucket_index(__k, __code);
+	    node_type __nh = __src.extract(__pos);
+	    _M_insert_unique_node(__bkt, __code, __nh._M_ptr);
+	    __nh._M_release();
+	  }
+      }
+
   template<typename _Key, typename _Value,
 	   typename _Alloc, typename _ExtractKey, typename _Equal,
 	   typename _H1, typename _H2, typename _Hash, typename _RehashPolicy,
@@ -31,6 +31,8 @@
 #ifndef _HASHTABLE_POLICY_H
 #define _HASHTABLE_POLICY_H 1
 
+#include <bits/tm_defer.h>
+
 namespace std _GLIBCXX_VISIBILITY(default)
 {
 _GLIBCXX_BEGIN_NAMESPACE_VERSION
@@ -579,6 +581,18 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 
       const mapped_type&
       at(const key_type& __k) const;
+
+      // The single lookup behind unordered_map::try_emplace: only on a
+      // miss is a node made, from __k and __args.
+      template<typename _Kt, typename... _Args>
+	std::pair<iterator, bool>
+	_M_try_emplace(_Kt&& __k, _Args&&... __args);
+
+      // And behind insert_or_assign: on a hit, only the mapped value is
+      // assigned.
+      template<typename _Kt, typename _Obj>
+	std::pair<iterator, bool>
+	_M_insert_or_assign(_Kt&& __k, _Obj&& __obj);
     };
 
   template<typename _Key, typename _Pair, typename _Alloc, typename _Equal,
@@ -673,6 +687,65 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       return __p->_M_v().second;
     }
 
+  template<typename _Key, typename _Pair, typename _Alloc, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash,
+	   typename _RehashPolicy, typename _Traits>
+    template<typename _Kt, typename... _Args>
+      std::pair<typename _Map_base<_Key, _Pair, _Alloc, _Select1st, _Equal,
+				   _H1, _H2, _Hash, _RehashPolicy, _Traits,
+				   true>::iterator, bool>
+      _Map_base<_Key, _Pair, _Alloc, _Select1st, _Equal,
+		_H1, _H2, _Hash, _RehashPolicy, _Traits, true>::
+      _M_try_emplace(_Kt&& __k, _Args&&... __args)
+      {
+	__hashtable* __h = static_cast<__hashtable*>(this);
+	__hash_code __code = __h->_M_hash_code(__k);
+	std::size_t __n = __h->_M_bucket_index(__k, __code);
+	__node_type* __p = __h->_M_find_node(__n, __k, __code);
+
+	if (__p)
+	  return std::make_pair(iterator(__p), false);
+
+	__p = __h->_M_allocate_node(std::piecewise_construct,
+				    std::forward_as_tuple(
+				      std::forward<_Kt>(__k)),
+				    std::forward_as_tuple(
+				      std::forward<_Args>(__args)...));
+	return std::make_pair(__h->_M_insert_unique_node(__n, __code, __p),
+			      true);
+      }
+
+  template<typename _Key, typename _Pair, typename _Alloc, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash,
+	   typename _RehashPolicy, typename _Traits>
+    template<typename _Kt, typename _Obj>
+      std::pair<typename _Map_base<_Key, _Pair, _Alloc, _Select1st, _Equal,
+				   _H1, _H2, _Hash, _RehashPolicy, _Traits,
+				   true>::iterator, bool>
+      _Map_base<_Key, _Pair, _Alloc, _Select1st, _Equal,
+		_H1, _H2, _Hash, _RehashPolicy, _Traits, true>::
+      _M_insert_or_assign(_Kt&& __k, _Obj&& __obj)
+      {
+	__hashtable* __h = static_cast<__hashtable*>(this);
+	__hash_code __code = __h->_M_hash_code(__k);
+	std::size_t __n = __h->_M_bucket_index(__k, __code);
+	__node_type* __p = __h->_M_find_node(__n, __k, __code);
+
+	if (__p)
+	  {
+	    __p->_M_v().second = std::forward<_Obj>(__obj);
+	    return std::make_pair(iterator(__p), false);
+	  }
+
+	__p = __h->_M_allocate_node(std::piecewise_construct,
+				    std::forward_as_tuple(
+				      std::forward<_Kt>(__k)),
+				    std::forward_as_tuple(
+				      std::forward<_Obj>(__obj)));
+	return std::make_pair(__h->_M_insert_unique_node(__n, __code, __p),
+			      true);
+      }
+
   /**
    *  Primary class template _Insert_base.
    *
@@ -1933,6 +2006,35 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       void
       _M_deallocate_nodes(__node_type* __n);
 
+      // Inside a transaction, have the linked list of nodes pointed to by
+      // __n deallocated once the transaction commits (see
+      // bits/tm_defer.h).  Returns false outside of a transaction, if
+      // there are no nodes, if the node allocator has state that the
+      // commit action could not carry, or if the values have a destructor
+      // that has to run in the transaction.
+      bool
+      _M_defer_nodes(__node_type* __n) noexcept
+      {
+	return __n && _M_defer_nodes(__n,
+				     __tm_can_defer<_NodeAlloc, __value_type>());
+      }
+
+      bool
+      _M_defer_nodes(__node_type*, false_type) noexcept
+      { return false; }
+
+      bool
+      _M_defer_nodes(__node_type* __n, true_type) noexcept
+      { return std::__tm_defer_to_commit(&_S_deallocate_deferred, __n); }
+
+      // The commit action
+      static void
+      _S_deallocate_deferred(void* __p) noexcept
+      {
+	_Hashtable_alloc __h{__node_alloc_type()};
+	__h._M_deallocate_nodes(static_cast<__node_type*>(__p));
+      }
+
       __bucket_type*
       _M_allocate_buckets(std::size_t __n);
 
@@ -66,6 +66,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
     _M_clear() _GLIBCXX_NOEXCEPT
     {
       typedef _List_node<_Tp>  _Node;
+      // Under TM, leave the nodes to a commit action: the caller either
+      // reinitializes the sentinel or is destroying it
+      if (_M_impl._M_node._M_next != &_M_impl._M_node
+	  && _M_defer_chain(_M_impl._M_node._M_next, _M_impl._M_node._M_prev))
+	return;
       _Node* __cur = static_cast<_Node*>(_M_impl._M_node._M_next);
       while (__cur != &_M_impl._M_node)
 	{
@@ -80,7 +85,51 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	}
     }
 
+  template<typename _Tp, typename _Alloc>
+    bool
+    _List_base<_Tp, _Alloc>::
+    _M_defer_chain(__detail::_List_node_base* __first,
+		   __detail::_List_node_base* __last) _GLIBCXX_NOEXCEPT
+    {
+#if __cplusplus >= 201103L
+      return _M_defer_chain(__first, __last,
+			    __tm_can_defer<_Node_alloc_type, _Tp>());
+#else
+      return false;
+#endif
+    }
+
 #if __cplusplus >= 201103L
+  template<typename _Tp, typename _Alloc>
+    bool
+    _List_base<_Tp, _Alloc>::
+    _M_defer_chain(__detail::_List_node_base* __first,
+		   __detail::_List_node_base* __last, true_type) noexcept
+    {
+      if (!std::__tm_defer_to_commit(&_S_destroy_chain,
+				     static_cast<_List_node<_Tp>*>(__first)))
+	return false;
+      __last->_M_next = 0;
+      return true;
+    }
+
+  template<typename _Tp, typename _Alloc>
+    void
+    _List_base<_Tp, _Alloc>::
+    _S_destroy_chain(void* __p) noexcept
+    {
+      typedef _List_node<_Tp>  _Node;
+      _Node_alloc_type __a;
+      _Node* __cur = static_cast<_Node*>(__p);
+      while (__cur)
+	{
+	  _Node* __tmp = __cur;
+	  __cur = static_cast<_Node*>(__cur->_M_next);
+	  __a.destroy(__tmp);
+	  __a.deallocate(__tmp, 1);
+	}
+    }
+
   template<typename _Tp, typename _Alloc>
     template<typename... _Args>
       typename list<_Tp, _Alloc>::iterator
@@ -394,38 +443,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
     void
     list<_Tp, _Alloc>::
     sort()
-    {
-      // Do nothing if the list has length 0 or 1.
-      if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
-	  && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
-      {
-        list __carry;
-        list __tmp[64];
-        list * __fill = &__tmp[0];
-        list * __counter;
-
-        do
-	  {
-	    __carry.splice(__carry.begin(), *this, begin());
-
-	    for(__counter = &__tmp[0];
-		__counter != __fill && !__counter->empty();
-		++__counter)
-	      {
-		__counter->merge(__carry);
-		__carry.swap(*__counter);
-	      }
-	    __carry.swap(*__counter);
-	    if (__counter == __fill)
-	      ++__fill;
-	  }
-	while ( !empty() );
-
-        for (__counter = &__tmp[1]; __counter != __fill; ++__counter)
-          __counter->merge(*(__counter - 1));
-        swap( *(__fill - 1) );
-      }
-    }
+    { _M_sort(__gnu_cxx::__ops::__iter_less_iter()); }
 
   template<typename _Tp, typename _Alloc>
     template <typename _Predicate>
@@ -471,37 +489,127 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       void
       list<_Tp, _Alloc>::
       sort(_StrictWeakOrdering __comp)
+      { _M_sort(__gnu_cxx::__ops::__iter_comp_iter(__comp)); }
+
+  template<typename _Tp, typename _Alloc>
+    template<typename _Compare>
+      void
+      list<_Tp, _Alloc>::
+      _M_sort(_Compare __comp)
       {
+	typedef __detail::_List_node_base __base;
+	__base* const __end = &this->_M_impl._M_node;
+	__base* __rest = __end->_M_next;
+
 	// Do nothing if the list has length 0 or 1.
-	if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
-	    && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
-	  {
-	    list __carry;
-	    list __tmp[64];
-	    list * __fill = &__tmp[0];
-	    list * __counter;
+	if (__rest == __end || __rest->_M_next == __end)
+	  return;
 
+	// __runs[__i] is empty, or a chain merged from 2^__i runs, whose
+	// elements came before those of __runs[__j] for every __j < __i.
+	__base* __runs[64];
+	int __fill = 0;
+	__base* __head = 0;
+	__end->_M_prev->_M_next = 0;
+	__try
+	  {
 	    do
 	      {
-		__carry.splice(__carry.begin(), *this, begin());
-
-		for(__counter = &__tmp[0];
-		    __counter != __fill && !__counter->empty();
-		    ++__counter)
+		// Cut off the next run that is already in order
+		__base* __run = __rest;
+		__base* __last = __rest;
+		while (__last->_M_next
+		       && !__comp(iterator(__last->_M_next), iterator(__last)))
+		  __last = __last->_M_next;
+		__rest = __last->_M_next;
+		if (__rest)
+		  __last->_M_next = 0;
+
+		int __i = 0;
+		for (; __i < __fill && __runs[__i]; ++__i)
 		  {
-		    __counter->merge(__carry, __comp);
-		    __carry.swap(*__counter);
+		    __run = _S_merge_chains(__runs[__i], __run, __comp);
+		    __runs[__i] = 0;
 		  }
-		__carry.swap(*__counter);
-		if (__counter == __fill)
+		__runs[__i] = __run;
+		if (__i == __fill)
 		  ++__fill;
 	      }
-	    while ( !empty() );
+	    while (__rest);
 
-	    for (__counter = &__tmp[1]; __counter != __fill; ++__counter)
-	      __counter->merge(*(__counter - 1), __comp);
-	    swap(*(__fill - 1));
+	    for (int __i = 0; __i < __fill; ++__i)
+	      if (__runs[__i])
+		__head = __head ? _S_merge_chains(__runs[__i], __head, __comp)
+				: __runs[__i];
 	  }
+	__catch(...)
+	  {
+	    // Only _M_next links have changed, and the _M_prev links still
+	    // give the original order, so put that back.
+	    __base* __n = __end;
+	    do
+	      {
+		__n->_M_prev->_M_next = __n;
+		__n = __n->_M_prev;
+	      }
+	    while (__n != __end);
+	    __throw_exception_again;
+	  }
+
+	// One pass to set the _M_prev links, and to close the ring
+	__base* __prev = __end;
+	for (__base* __n = __head; __n; __prev = __n, __n = __n->_M_next)
+	  if (__n->_M_prev != __prev)
+	    __n->_M_prev = __prev;
+	__prev->_M_next = __end;
+	if (__end->_M_prev != __prev)
+	  __end->_M_prev = __prev;
+	if (__end->_M_next != __head)
+	  __end->_M_next = __head;
+      }
+
+  template<typename _Tp, typename _Alloc>
+    template<typename _Compare>
+      __detail::_List_node_base*
+      list<_Tp, _Alloc>::
+      _S_merge_chains(__detail::_List_node_base* __a,
+		      __detail::_List_node_base* __b, _Compare& __comp)
+      {
+	typedef __detail::_List_node_base __base;
+
+	// __tail is the last node taken, and still links to the rest of
+	// its own chain, so that the only links written are where the
+	// merge switches chains.  Ties go to __a.
+	bool __in_b = __comp(iterator(__b), iterator(__a));
+	__base* const __head = __in_b ? __b : __a;
+	__base* __tail = __head;
+	if (__in_b)
+	  __b = __b->_M_next;
+	else
+	  __a = __a->_M_next;
+
+	while (__a && __b)
+	  if (__comp(iterator(__b), iterator(__a)))
+	    {
+	      if (!__in_b)
+		__tail->_M_next = __b;
+	      __tail = __b;
+	      __b = __b->_M_next;
+	      __in_b = true;
+	    }
+	  else
+	    {
+	      if (__in_b)
+		__tail->_M_next = __a;
+	      __tail = __a;
+	      __a = __a->_M_next;
+	      __in_b = false;
+	    }
+
+	// If __tail's chain ran out first, the rest of the other follows it
+	if (__in_b ? !__b : !__a)
+	  __tail->_M_next = __in_b ? __a : __b;
+	return __head;
       }
 
 _GLIBCXX_END_NAMESPACE_CONTAINER
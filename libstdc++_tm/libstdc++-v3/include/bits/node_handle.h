@@ -0,0 +1,213 @@
+// Node handles for the associative containers -*- C++ -*-
+
+// This file is part of the transactional version of the GNU ISO C++
+// Library, and is distributed under the same terms.
+
+/** @file bits/node_handle.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{map, unordered_map}
+ *
+ *  C++17's node handles, which the transactional library provides from
+ *  C++11 on, for map and unordered_map.  extract() unlinks a node and hands
+ *  it over in a handle, and insert() of a handle, or merge(), links it into
+ *  another container of the same kind.  The node is never freed and
+ *  reallocated on the way, so that moving an element between containers in
+ *  a transaction costs a few writes to links, instead of a logged free and
+ *  a logged malloc.
+ */
+
+#ifndef _NODE_HANDLE
+#define _NODE_HANDLE 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <new>
+#include <bits/move.h>
+#include <ext/alloc_traits.h>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    class _Rb_tree;
+
+  template<typename _Key, typename _Value, typename _Alloc,
+	   typename _ExtractKey, typename _Equal,
+	   typename _H1, typename _H2, typename _Hash,
+	   typename _RehashPolicy, typename _Traits>
+    class _Hashtable;
+
+  /// Base class for node handles: owns a node, and the allocator to free
+  /// it with, which only exists while there is a node.
+  template<typename _Val, typename _NodeAlloc>
+    class _Node_handle_common
+    {
+      typedef __gnu_cxx::__alloc_traits<_NodeAlloc> _AllocTraits;
+
+    public:
+      typedef typename _AllocTraits::template rebind<_Val>::other
+							allocator_type;
+
+      allocator_type
+      get_allocator() const noexcept
+      {
+	__glibcxx_assert(!this->empty());
+	return allocator_type(_M_alloc);
+      }
+
+      explicit operator bool() const noexcept
+      { return _M_ptr != nullptr; }
+
+      bool
+      empty() const noexcept
+      { return _M_ptr == nullptr; }
+
+    protected:
+      _Node_handle_common() noexcept
+      : _M_ptr() { }
+
+      ~_Node_handle_common()
+      { _M_destroy(); }
+
+      _Node_handle_common(_Node_handle_common&& __nh) noexcept
+      : _M_ptr(__nh._M_ptr)
+      {
+	if (_M_ptr)
+	  _M_move(std::move(__nh));
+      }
+
+      _Node_handle_common&
+      operator=(_Node_handle_common&& __nh) noexcept
+      {
+	if (this != &__nh)
+	  {
+	    _M_destroy();
+	    _M_ptr = __nh._M_ptr;
+	    if (_M_ptr)
+	      _M_move(std::move(__nh));
+	  }
+	return *this;
+      }
+
+      _Node_handle_common(typename _AllocTraits::pointer __ptr,
+			  const _NodeAlloc& __alloc)
+      : _M_ptr(__ptr)
+      { ::new ((void*)std::__addressof(_M_alloc)) _NodeAlloc(__alloc); }
+
+      // Let go of the node, which a container has linked in
+      void
+      _M_release() noexcept
+      {
+	if (_M_ptr)
+	  {
+	    _M_alloc.~_NodeAlloc();
+	    _M_ptr = nullptr;
+	  }
+      }
+
+      typename _AllocTraits::pointer _M_ptr;
+
+    private:
+      void
+      _M_move(_Node_handle_common&& __nh) noexcept
+      {
+	::new ((void*)std::__addressof(_M_alloc))
+	  _NodeAlloc(std::move(__nh._M_alloc));
+	__nh._M_release();
+      }
+
+      void
+      _M_destroy() noexcept
+      {
+	if (_M_ptr)
+	  {
+	    _AllocTraits::destroy(_M_alloc, _M_ptr->_M_valptr());
+	    _AllocTraits::deallocate(_M_alloc, _M_ptr, 1);
+	    _M_release();
+	  }
+      }
+
+      union { _NodeAlloc _M_alloc; };
+    };
+
+  /// The node_type of map and unordered_map.
+  template<typename _Key, typename _Value, typename _NodeAlloc>
+    class _Node_handle : public _Node_handle_common<_Value, _NodeAlloc>
+    {
+      typedef _Node_handle_common<_Value, _NodeAlloc> _Base;
+
+    public:
+      typedef _Key				key_type;
+      typedef typename _Value::second_type	mapped_type;
+
+      _Node_handle() noexcept = default;
+
+      _Node_handle(_Node_handle&&) noexcept = default;
+
+      _Node_handle&
+      operator=(_Node_handle&&) noexcept = default;
+
+      key_type&
+      key() const noexcept
+      {
+	__glibcxx_assert(!this->empty());
+	return const_cast<key_type&>(this->_M_ptr->_M_valptr()->first);
+      }
+
+      mapped_type&
+      mapped() const noexcept
+      {
+	__glibcxx_assert(!this->empty());
+	return this->_M_ptr->_M_valptr()->second;
+      }
+
+      void
+      swap(_Node_handle& __nh) noexcept
+      {
+	_Node_handle __tmp(std::move(__nh));
+	__nh = std::move(*this);
+	*this = std::move(__tmp);
+      }
+
+      friend void
+      swap(_Node_handle& __x, _Node_handle& __y) noexcept
+      { __x.swap(__y); }
+
+    private:
+      typedef typename __gnu_cxx::__alloc_traits<_NodeAlloc>::pointer
+							_Node_ptr;
+
+      _Node_handle(_Node_ptr __ptr, const _NodeAlloc& __alloc)
+      : _Base(__ptr, __alloc) { }
+
+      template<typename _Key2, typename _Val2, typename _KeyOfValue2,
+	       typename _Compare2, typename _Alloc2>
+	friend class _Rb_tree;
+
+      template<typename _Key2, typename _Value2, typename _Alloc2,
+	       typename _ExtractKey2, typename _Equal2,
+	       typename _H12, typename _H22, typename _Hash2,
+	       typename _RehashPolicy2, typename _Traits2>
+	friend class _Hashtable;
+    };
+
+  /// The insert_return_type of map and unordered_map: where the key is, and
+  /// if it was there already, the node that did not go in.
+  template<typename _Iterator, typename _NodeHandle>
+    struct _Node_insert_return
+    {
+      _Iterator		position = _Iterator();
+      bool		inserted = false;
+      _NodeHandle	node;
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++11
+
+#endif /* _NODE_HANDLE */
@@ -57,6 +57,7 @@
 #define _STL_LIST_H 1
 
 #include <bits/concept_check.h>
+#include <bits/tm_defer.h>
 #if __cplusplus >= 201103L
 #include <initializer_list>
 #endif
@@ -396,6 +397,32 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       void
       _M_clear() _GLIBCXX_NOEXCEPT;
 
+      // Inside a transaction, cut the chain of nodes from __first to
+      // __last (inclusive) off at __last, and destroy it once the
+      // transaction commits (see bits/tm_defer.h).  The caller relinks
+      // the list around the chain.  Returns false, having changed
+      // nothing, outside of a transaction, if the node allocator has
+      // state that the teardown could not carry, or if _Tp has a
+      // destructor that has to run in the transaction.
+      bool
+      _M_defer_chain(__detail::_List_node_base* __first,
+		     __detail::_List_node_base* __last) _GLIBCXX_NOEXCEPT;
+
+#if __cplusplus >= 201103L
+      bool
+      _M_defer_chain(__detail::_List_node_base*, __detail::_List_node_base*,
+		     false_type) noexcept
+      { return false; }
+
+      bool
+      _M_defer_chain(__detail::_List_node_base* __first,
+		     __detail::_List_node_base* __last, true_type) noexcept;
+
+      // The commit action: destroy the null-terminated chain at __p
+      static void
+      _S_destroy_chain(void* __p) noexcept;
+#endif
+
       void
       _M_init() _GLIBCXX_NOEXCEPT
       {
@@ -1273,6 +1300,20 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       erase(iterator __first, iterator __last)
 #endif
       {
+	// Under TM, unlink the whole range in two writes, and destroy it
+	// after the transaction commits
+	if (__first != __last)
+	  {
+	    __detail::_List_node_base* __prev = __first._M_node->_M_prev;
+	    __detail::_List_node_base* __end = __last._M_const_cast()._M_node;
+	    if (this->_M_defer_chain(__first._M_const_cast()._M_node,
+				     __end->_M_prev))
+	      {
+		__prev->_M_next = __end;
+		__end->_M_prev = __prev;
+		return __last._M_const_cast();
+	      }
+	  }
 	while (__first != __last)
 	  __first = erase(__first);
 	return __last._M_const_cast();
@@ -1679,6 +1720,25 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       _M_transfer(iterator __position, iterator __first, iterator __last)
       { __position._M_node->_M_transfer(__first._M_node, __last._M_node); }
 
+      // The sort behind both sort()s: a bottom-up merge of the runs that
+      // are already in order.  The runs are merged as null-terminated
+      // chains of _M_next links, and a link is only written where a merge
+      // switches from one chain to the other; the _M_prev links are set
+      // in one pass at the end.  Inside a transaction, that logs far
+      // fewer writes than splicing through 64 temporary lists, and the
+      // temporary state is an array of pointers on the stack.  If __comp
+      // throws, the list is left as it was.
+      template<typename _Compare>
+        void
+        _M_sort(_Compare __comp);
+
+      // Merge the sorted null-terminated chains __a and __b, where __a
+      // came first, and return the head of the result
+      template<typename _Compare>
+        static __detail::_List_node_base*
+        _S_merge_chains(__detail::_List_node_base* __a,
+			__detail::_List_node_base* __b, _Compare& __comp);
+
       // Inserts new element at position given and with value given.
 #if __cplusplus < 201103L
       void
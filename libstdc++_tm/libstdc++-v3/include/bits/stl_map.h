@@ -152,6 +152,10 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       typedef typename _Rep_type::difference_type        difference_type;
       typedef typename _Rep_type::reverse_iterator       reverse_iterator;
       typedef typename _Rep_type::const_reverse_iterator const_reverse_iterator;
+#if __cplusplus >= 201103L
+      typedef typename _Rep_type::node_type              node_type;
+      typedef typename _Rep_type::insert_return_type     insert_return_type;
+#endif
 
       // [23.3.1.1] construct/copy/destroy
       // (get_allocator() is also listed in this section)
@@ -607,6 +611,237 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	  return _M_t._M_emplace_hint_unique(__pos,
 					     std::forward<_Args>(__args)...);
 	}
+
+      /**
+       *  @brief Attempts to build and insert a std::pair into the %map.
+       *
+       *  @param __k     Key of the pair.
+       *  @param __args  Arguments used to build the mapped value of a new
+       *                 pair.
+       *  @return  A pair, of which the first element is an iterator that points
+       *           to the possibly inserted pair, and the second is a bool that
+       *           is true if the pair was actually inserted.
+       *
+       *  This is C++17's try_emplace, which the transactional library
+       *  provides from C++11 on.  The key is looked up first, and the
+       *  pair is only built if the key is not already present, in which
+       *  case @a __args are left as they were.  Unlike emplace(), no
+       *  node is made and then thrown away, and unlike operator[], no
+       *  mapped value is built and then assigned over: inside a
+       *  transaction, each of those is an allocation or stores that
+       *  have to be logged.
+       *
+       *  Insertion requires logarithmic time.
+       */
+      template<typename... _Args>
+	std::pair<iterator, bool>
+	try_emplace(const key_type& __k, _Args&&... __args)
+	{
+	  return _M_t._M_try_emplace_unique(__k, std::piecewise_construct,
+					    std::forward_as_tuple(__k),
+					    std::forward_as_tuple(
+					      std::forward<_Args>(__args)...));
+	}
+
+      template<typename... _Args>
+	std::pair<iterator, bool>
+	try_emplace(key_type&& __k, _Args&&... __args)
+	{
+	  return _M_t._M_try_emplace_unique(__k, std::piecewise_construct,
+					    std::forward_as_tuple(std::move(__k)),
+					    std::forward_as_tuple(
+					      std::forward<_Args>(__args)...));
+	}
+
+      /**
+       *  @brief Attempts to build and insert a std::pair into the %map.
+       *
+       *  @param  __hint  An iterator that serves as a hint as to where the
+       *                  pair should be inserted.
+       *  @param  __k     Key of the pair.
+       *  @param  __args  Arguments used to build the mapped value of a new
+       *                  pair.
+       *  @return An iterator that points to the element with key @a __k
+       *          (may or may not be a new pair).
+       *
+       *  As try_emplace(__k, __args...), with a hint as for emplace_hint().
+       *
+       *  Insertion requires logarithmic time (if the hint is not taken).
+       */
+      template<typename... _Args>
+	iterator
+	try_emplace(const_iterator __hint, const key_type& __k,
+		    _Args&&... __args)
+	{
+	  return _M_t._M_try_emplace_hint_unique(__hint, __k,
+					std::piecewise_construct,
+					std::forward_as_tuple(__k),
+					std::forward_as_tuple(
+					  std::forward<_Args>(__args)...)).first;
+	}
+
+      template<typename... _Args>
+	iterator
+	try_emplace(const_iterator __hint, key_type&& __k, _Args&&... __args)
+	{
+	  return _M_t._M_try_emplace_hint_unique(__hint, __k,
+					std::piecewise_construct,
+					std::forward_as_tuple(std::move(__k)),
+					std::forward_as_tuple(
+					  std::forward<_Args>(__args)...)).first;
+	}
+
+      /**
+       *  @brief Inserts a std::pair into the %map, or assigns to the
+       *         mapped value of the pair that has its key.
+       *
+       *  @param __k    Key of the pair.
+       *  @param __obj  Value to insert or assign.
+       *  @return  A pair, of which the first element is an iterator that points
+       *           to the pair with key @a __k, and the second is a bool that
+       *           is true if the pair was inserted, and false if it was
+       *           assigned to.
+       *
+       *  This is C++17's insert_or_assign, which the transactional library
+       *  provides from C++11 on.  As with try_emplace(), the key is looked
+       *  up once, and a pair is only built if the key is not present.
+       *
+       *  Insertion requires logarithmic time.
+       */
+      template<typename _Obj>
+	std::pair<iterator, bool>
+	insert_or_assign(const key_type& __k, _Obj&& __obj)
+	{
+	  auto __res = _M_t._M_try_emplace_unique(__k, std::piecewise_construct,
+					std::forward_as_tuple(__k),
+					std::forward_as_tuple(
+					  std::forward<_Obj>(__obj)));
+	  if (!__res.second)
+	    (*__res.first).second = std::forward<_Obj>(__obj);
+	  return __res;
+	}
+
+      template<typename _Obj>
+	std::pair<iterator, bool>
+	insert_or_assign(key_type&& __k, _Obj&& __obj)
+	{
+	  auto __res = _M_t._M_try_emplace_unique(__k, std::piecewise_construct,
+					std::forward_as_tuple(std::move(__k)),
+					std::forward_as_tuple(
+					  std::forward<_Obj>(__obj)));
+	  if (!__res.second)
+	    (*__res.first).second = std::forward<_Obj>(__obj);
+	  return __res;
+	}
+
+      /**
+       *  @brief Inserts a std::pair into the %map, or assigns to the
+       *         mapped value of the pair that has its key.
+       *
+       *  @param  __hint  An iterator that serves as a hint as to where the
+       *                  pair should be inserted.
+       *  @param  __k     Key of the pair.
+       *  @param  __obj   Value to insert or assign.
+       *  @return An iterator that points to the pair with key @a __k.
+       *
+       *  As insert_or_assign(__k, __obj), with a hint as for
+       *  emplace_hint().
+       *
+       *  Insertion requires logarithmic time (if the hint is not taken).
+       */
+      template<typename _Obj>
+	iterator
+	insert_or_assign(const_iterator __hint, const key_type& __k,
+			 _Obj&& __obj)
+	{
+	  auto __res = _M_t._M_try_emplace_hint_unique(__hint, __k,
+					std::piecewise_construct,
+					std::forward_as_tuple(__k),
+					std::forward_as_tuple(
+					  std::forward<_Obj>(__obj)));
+	  if (!__res.second)
+	    (*__res.first).second = std::forward<_Obj>(__obj);
+	  return __res.first;
+	}
+
+      template<typename _Obj>
+	iterator
+	insert_or_assign(const_iterator __hint, key_type&& __k, _Obj&& __obj)
+	{
+	  auto __res = _M_t._M_try_emplace_hint_unique(__hint, __k,
+					std::piecewise_construct,
+					std::forward_as_tuple(std::move(__k)),
+					std::forward_as_tuple(
+					  std::forward<_Obj>(__obj)));
+	  if (!__res.second)
+	    (*__res.first).second = std::forward<_Obj>(__obj);
+	  return __res.first;
+	}
+
+      /**
+       *  @brief Takes the element at a position out of the %map.
+       *  @param  __pos  An iterator into the %map.
+       *  @return A node handle that owns the element.
+       *
+       *  This is C++17's extract, which the transactional library provides
+       *  from C++11 on.  The node is unlinked but not freed, so that it can
+       *  go into another %map with insert(node_type&&), without an
+       *  allocation, or be destroyed with the handle.
+       */
+      node_type
+      extract(const_iterator __pos)
+      { return _M_t.extract(__pos); }
+
+      /**
+       *  @brief Takes the element with a key out of the %map.
+       *  @param  __x  Key of the element to be extracted.
+       *  @return A node handle that owns the element, or an empty one if
+       *          there is no such element.
+       */
+      node_type
+      extract(const key_type& __x)
+      { return _M_t.extract(__x); }
+
+      /**
+       *  @brief Links the node of a handle into the %map.
+       *  @param  __nh  A node handle from extract() on a %map of this type.
+       *  @return Where the key is, whether the node went in, and, if it did
+       *          not, the handle, which still owns it.
+       *
+       *  Insertion requires logarithmic time, and no allocation.
+       */
+      insert_return_type
+      insert(node_type&& __nh)
+      { return _M_t._M_reinsert_node_unique(std::move(__nh)); }
+
+      /**
+       *  @brief Links the node of a handle into the %map, with a hint as
+       *         for emplace_hint().
+       *  @return An iterator to the element with the node's key.  If that
+       *          is not the node, @a __nh still owns the node.
+       */
+      iterator
+      insert(const_iterator __hint, node_type&& __nh)
+      { return _M_t._M_reinsert_node_hint_unique(__hint, std::move(__nh)); }
+
+      /**
+       *  @brief Moves the elements of another %map over to this one.
+       *  @param  __source  A %map with the same allocator, which may order
+       *                    its keys differently.
+       *
+       *  Each element whose key is not in this %map yet is relinked into
+       *  it; the others stay in @a __source.  No element is copied,
+       *  moved or allocated.
+       */
+      template<typename _Compare2>
+	void
+	merge(map<_Key, _Tp, _Compare2, _Alloc>& __source)
+	{ _M_t._M_merge_unique(__source._M_t); }
+
+      template<typename _Compare2>
+	void
+	merge(map<_Key, _Tp, _Compare2, _Alloc>&& __source)
+	{ merge(__source); }
 #endif
 
       /**
@@ -983,6 +1218,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
         friend bool
         operator<(const map<_K1, _T1, _C1, _A1>&,
 		  const map<_K1, _T1, _C1, _A1>&);
+
+#if __cplusplus >= 201103L
+      // For merge() from a map that orders its keys differently
+      template<typename _K1, typename _T1, typename _C1, typename _A1>
+	friend class map;
+#endif
     };
 
   /**
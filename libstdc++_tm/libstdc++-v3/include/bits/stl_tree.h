@@ -65,8 +65,10 @@
 #include <bits/stl_function.h>
 #include <bits/cpp_type_traits.h>
 #include <ext/alloc_traits.h>
+#include <bits/tm_defer.h>
 #if __cplusplus >= 201103L
 #include <ext/aligned_buffer.h>
+#include <bits/node_handle.h>
 #endif
 
 namespace std _GLIBCXX_VISIBILITY(default)
@@ -645,6 +647,31 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       void
       _M_erase(_Link_type __x);
 
+      void
+      _M_erase_now(_Link_type __x);
+
+      // Inside a transaction, have the subtree at __x, which the caller
+      // is dropping from the tree, destroyed once the transaction commits
+      // (see bits/tm_defer.h).  Returns false outside of a transaction, if
+      // the node allocator has state that the teardown could not carry, or
+      // if _Val has a destructor that has to run in the transaction.
+      bool
+      _M_defer_erase(_Link_type __x) _GLIBCXX_NOEXCEPT;
+
+#if __cplusplus >= 201103L
+      bool
+      _M_defer_erase(_Link_type, false_type) noexcept
+      { return false; }
+
+      bool
+      _M_defer_erase(_Link_type __x, true_type) noexcept
+      { return std::__tm_defer_to_commit(&_S_erase_deferred, __x); }
+
+      // The commit action: destroy the subtree at __p
+      static void
+      _S_erase_deferred(void* __p) noexcept;
+#endif
+
       iterator
       _M_lower_bound(_Link_type __x, _Link_type __y,
 		     const _Key& __k);
@@ -817,6 +844,60 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       template<typename... _Args>
 	iterator
 	_M_emplace_hint_equal(const_iterator __pos, _Args&&... __args);
+
+      // The single lookup behind map::try_emplace and insert_or_assign:
+      // find where __k goes first, and only make a node from __args, which
+      // build the whole value, if __k is not in the tree yet.
+      template<typename... _Args>
+	pair<iterator, bool>
+	_M_try_emplace_unique(const key_type& __k, _Args&&... __args);
+
+      template<typename... _Args>
+	pair<iterator, bool>
+	_M_try_emplace_hint_unique(const_iterator __pos, const key_type& __k,
+				   _Args&&... __args);
+
+      // Node handles (see bits/node_handle.h): extract unlinks a node
+      // without freeing it, and the reinserts and the merge link in nodes
+      // that were made for another tree, without allocating.
+      typedef _Node_handle<_Key, _Val, _Node_allocator> node_type;
+      typedef _Node_insert_return<iterator, node_type> insert_return_type;
+
+      node_type
+      extract(const_iterator __pos)
+      {
+	_Base_ptr __ptr = _Rb_tree_rebalance_for_erase
+	  (__pos._M_const_cast()._M_node, _M_impl._M_header);
+	--_M_impl._M_node_count;
+	return node_type(static_cast<_Link_type>(__ptr),
+			 _M_get_Node_allocator());
+      }
+
+      node_type
+      extract(const key_type& __k)
+      {
+	iterator __pos = find(__k);
+	if (__pos == end())
+	  return node_type();
+	return extract(const_iterator(__pos));
+      }
+
+      insert_return_type
+      _M_reinsert_node_unique(node_type&& __nh);
+
+      iterator
+      _M_reinsert_node_hint_unique(const_iterator __hint, node_type&& __nh);
+
+      // Move every node of __src whose key is not in this tree yet over to
+      // this one.  The trees may differ in their comparison.
+      template<typename _Compare2>
+	void
+	_M_merge_unique(_Rb_tree<_Key, _Val, _KeyOfValue, _Compare2, _Alloc>&
+			__src);
+
+      template<typename _Key2, typename _Val2, typename _KeyOfValue2,
+	       typename _Compare2, typename _Alloc2>
+	friend class _Rb_tree;
 #else
       pair<iterator, bool>
       _M_insert_unique(const value_type& __x);
@@ -840,6 +921,30 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
         _M_insert_equal(_InputIterator __first, _InputIterator __last);
 
     private:
+      // Into an empty tree, a range that is already in order is built
+      // as a balanced tree in one pass, rather than inserted one element
+      // at a time, with a rebalance per element.  Returns false, having
+      // done nothing, if the range is out of order (or, with __unique,
+      // has equal keys), or can only be read once.
+      template<typename _InputIterator>
+        bool
+        _M_build_sorted(_InputIterator, _InputIterator, bool,
+			std::input_iterator_tag)
+        { return false; }
+
+      template<typename _ForwardIterator>
+        bool
+        _M_build_sorted(_ForwardIterator __first, _ForwardIterator __last,
+			bool __unique, std::forward_iterator_tag);
+
+      // Build the subtree of the next __n elements from __first, whose
+      // root is at __depth.  The nodes at __red_depth, the deepest level,
+      // are red, and the others black.
+      template<typename _ForwardIterator>
+        _Link_type
+        _M_build_subtree(_ForwardIterator& __first, size_type __n,
+			 size_type __depth, size_type __red_depth);
+
       void
       _M_erase_aux(const_iterator __position);
 
@@ -1240,17 +1345,64 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     void
     _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
     _M_erase(_Link_type __x)
+    {
+      // Under TM, a commit action frees the subtree, so that the
+      // transaction only writes the header that the caller resets
+      if (__x != 0 && _M_defer_erase(__x))
+	return;
+      _M_erase_now(__x);
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    void
+    _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_erase_now(_Link_type __x)
     {
       // Erase without rebalancing.
       while (__x != 0)
 	{
-	  _M_erase(_S_right(__x));
+	  _M_erase_now(_S_right(__x));
 	  _Link_type __y = _S_left(__x);
 	  _M_destroy_node(__x);
 	  __x = __y;
 	}
     }
 
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    bool
+    _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_defer_erase(_Link_type __x) _GLIBCXX_NOEXCEPT
+    {
+#if __cplusplus >= 201103L
+      return _M_defer_erase(__x, __tm_can_defer<_Node_allocator, _Val>());
+#else
+      return false;
+#endif
+    }
+
+#if __cplusplus >= 201103L
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    void
+    _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _S_erase_deferred(void* __p) noexcept
+    {
+      _Node_allocator __a;
+      _Link_type __x = static_cast<_Link_type>(__p);
+      while (__x != 0)
+	{
+	  _S_erase_deferred(_S_right(__x));
+	  _Link_type __y = _S_left(__x);
+	  _Alloc_traits::destroy(__a, __x->_M_valptr());
+	  __x->~_Rb_tree_node<_Val>();
+	  _Alloc_traits::deallocate(__a, __x, 1);
+	  __x = __y;
+	}
+    }
+#endif
+
   template<typename _Key, typename _Val, typename _KeyOfValue,
            typename _Compare, typename _Alloc>
     typename _Rb_tree<_Key, _Val, _KeyOfValue,
@@ -1761,6 +1913,126 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	  }
       }
 
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    template<typename... _Args>
+      pair<typename _Rb_tree<_Key, _Val, _KeyOfValue,
+			     _Compare, _Alloc>::iterator, bool>
+      _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+      _M_try_emplace_unique(const key_type& __k, _Args&&... __args)
+      {
+	typedef pair<iterator, bool> _Res;
+	auto __res = _M_get_insert_unique_pos(__k);
+	if (!__res.second)
+	  return _Res(iterator(static_cast<_Link_type>(__res.first)), false);
+
+	_Link_type __z = _M_create_node(std::forward<_Args>(__args)...);
+	__try
+	  { return _Res(_M_insert_node(__res.first, __res.second, __z), true); }
+	__catch(...)
+	  {
+	    _M_destroy_node(__z);
+	    __throw_exception_again;
+	  }
+      }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    template<typename... _Args>
+      pair<typename _Rb_tree<_Key, _Val, _KeyOfValue,
+			     _Compare, _Alloc>::iterator, bool>
+      _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+      _M_try_emplace_hint_unique(const_iterator __pos, const key_type& __k,
+				 _Args&&... __args)
+      {
+	typedef pair<iterator, bool> _Res;
+	auto __res = _M_get_insert_hint_unique_pos(__pos, __k);
+	if (!__res.second)
+	  return _Res(iterator(static_cast<_Link_type>(__res.first)), false);
+
+	_Link_type __z = _M_create_node(std::forward<_Args>(__args)...);
+	__try
+	  { return _Res(_M_insert_node(__res.first, __res.second, __z), true); }
+	__catch(...)
+	  {
+	    _M_destroy_node(__z);
+	    __throw_exception_again;
+	  }
+      }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    typename _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    insert_return_type
+    _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_reinsert_node_unique(node_type&& __nh)
+    {
+      insert_return_type __ret;
+      if (__nh.empty())
+	__ret.position = end();
+      else
+	{
+	  auto __res = _M_get_insert_unique_pos(_S_key(__nh._M_ptr));
+	  if (__res.second)
+	    {
+	      __ret.position
+		= _M_insert_node(__res.first, __res.second, __nh._M_ptr);
+	      __nh._M_release();
+	      __ret.inserted = true;
+	    }
+	  else
+	    {
+	      __ret.node = std::move(__nh);
+	      __ret.position = iterator(static_cast<_Link_type>(__res.first));
+	    }
+	}
+      return __ret;
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    typename _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::iterator
+    _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_reinsert_node_hint_unique(const_iterator __hint, node_type&& __nh)
+    {
+      if (__nh.empty())
+	return end();
+
+      auto __res = _M_get_insert_hint_unique_pos(__hint, _S_key(__nh._M_ptr));
+      if (!__res.second)
+	return iterator(static_cast<_Link_type>(__res.first));
+
+      iterator __ret = _M_insert_node(__res.first, __res.second, __nh._M_ptr);
+      __nh._M_release();
+      return __ret;
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+           typename _Compare, typename _Alloc>
+    template<typename _Compare2>
+      void
+      _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+      _M_merge_unique(_Rb_tree<_Key, _Val, _KeyOfValue, _Compare2, _Alloc>&
+		      __src)
+      {
+	typedef typename _Rb_tree<_Key, _Val, _KeyOfValue, _Compare2,
+				  _Alloc>::iterator _Src_iterator;
+	for (_Src_iterator __i = __src.begin(), __end = __src.end();
+	     __i != __end;)
+	  {
+	    _Src_iterator __pos = __i++;
+	    auto __res = _M_get_insert_unique_pos(_KeyOfValue()(*__pos));
+	    if (__res.second)
+	      {
+		_Base_ptr __ptr = _Rb_tree_rebalance_for_erase
+		  (__pos._M_node, __src._M_impl._M_header);
+		--__src._M_impl._M_node_count;
+		_M_insert_node(__res.first, __res.second,
+			       static_cast<_Link_type>(__ptr));
+	      }
+	  }
+      }
+
   template<typename _Key, typename _Val, typename _KeyOfValue,
            typename _Compare, typename _Alloc>
     template<typename... _Args>
@@ -1841,6 +2113,10 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       _Rb_tree<_Key, _Val, _KoV, _Cmp, _Alloc>::
       _M_insert_unique(_II __first, _II __last)
       {
+	if (_M_impl._M_node_count == 0
+	    && _M_build_sorted(__first, __last, true,
+			       std::__iterator_category(__first)))
+	  return;
 	for (; __first != __last; ++__first)
 	  _M_insert_unique_(end(), *__first);
       }
@@ -1852,10 +2128,100 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       _Rb_tree<_Key, _Val, _KoV, _Cmp, _Alloc>::
       _M_insert_equal(_II __first, _II __last)
       {
+	if (_M_impl._M_node_count == 0
+	    && _M_build_sorted(__first, __last, false,
+			       std::__iterator_category(__first)))
+	  return;
 	for (; __first != __last; ++__first)
 	  _M_insert_equal_(end(), *__first);
       }
 
+  template<typename _Key, typename _Val, typename _KoV,
+           typename _Cmp, typename _Alloc>
+    template<typename _ForwardIterator>
+      bool
+      _Rb_tree<_Key, _Val, _KoV, _Cmp, _Alloc>::
+      _M_build_sorted(_ForwardIterator __first, _ForwardIterator __last,
+		      bool __unique, std::forward_iterator_tag)
+      {
+	// Count the range, and make sure that it is in order
+	size_type __n = 0;
+	if (__first != __last)
+	  {
+	    _ForwardIterator __prev = __first;
+	    _ForwardIterator __next = __first;
+	    for (++__n; ++__next != __last; __prev = __next, ++__n)
+	      if (__unique
+		  ? !_M_impl._M_key_compare(_KoV()(*__prev), _KoV()(*__next))
+		  : _M_impl._M_key_compare(_KoV()(*__next), _KoV()(*__prev)))
+		return false;
+	  }
+	if (__n == 0)
+	  return true;
+
+	// A subtree of __n nodes split as evenly as they go has all of its
+	// leaves at depth log2(__n) or one less, so coloring the deepest
+	// level red balances the black heights.
+	size_type __red_depth = 0;
+	for (size_type __m = __n; __m > 1; __m >>= 1)
+	  ++__red_depth;
+	_Link_type __root = _M_build_subtree(__first, __n, 0, __red_depth);
+	__root->_M_color = _S_black;
+	__root->_M_parent = _M_end();
+	_M_root() = __root;
+	_M_leftmost() = _S_minimum(__root);
+	_M_rightmost() = _S_maximum(__root);
+	_M_impl._M_node_count = __n;
+	return true;
+      }
+
+  template<typename _Key, typename _Val, typename _KoV,
+           typename _Cmp, typename _Alloc>
+    template<typename _ForwardIterator>
+      typename _Rb_tree<_Key, _Val, _KoV, _Cmp, _Alloc>::_Link_type
+      _Rb_tree<_Key, _Val, _KoV, _Cmp, _Alloc>::
+      _M_build_subtree(_ForwardIterator& __first, size_type __n,
+		       size_type __depth, size_type __red_depth)
+      {
+	// The nodes are made in order, so the left subtree comes first
+	const size_type __left_n = (__n - 1) / 2;
+	_Link_type __left = 0;
+	if (__left_n)
+	  __left = _M_build_subtree(__first, __left_n, __depth + 1,
+				    __red_depth);
+
+	_Link_type __x;
+	__try
+	  { __x = _M_create_node(*__first); }
+	__catch(...)
+	  {
+	    _M_erase(__left);
+	    __throw_exception_again;
+	  }
+	++__first;
+	__x->_M_color = __depth == __red_depth ? _S_red : _S_black;
+	__x->_M_left = __left;
+	__x->_M_right = 0;
+	if (__left)
+	  __left->_M_parent = __x;
+
+	if (__n - 1 - __left_n)
+	  {
+	    __try
+	      {
+		__x->_M_right = _M_build_subtree(__first, __n - 1 - __left_n,
+						 __depth + 1, __red_depth);
+	      }
+	    __catch(...)
+	      {
+		_M_erase(__x);
+		__throw_exception_again;
+	      }
+	    __x->_M_right->_M_parent = __x;
+	  }
+	return __x;
+      }
+
   template<typename _Key, typename _Val, typename _KeyOfValue,
            typename _Compare, typename _Alloc>
     void
@@ -65,6 +65,64 @@
 
 namespace std _GLIBCXX_VISIBILITY(default)
 {
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // How much a full vector grows by.  Under TM, the reallocation copies
+  // every element into a new buffer, in the transaction that pushes the
+  // element that does not fit, so the shape of the growth decides how often
+  // an append-heavy transaction carries the whole vector in its read and
+  // write sets.  The next capacity is _Num / _Den of the size (at least
+  // __n more), grows by at most _MaxStep elements if that is not zero, and
+  // then fills the allocation up to a multiple of _RoundBytes bytes, such
+  // as a page, if that is not zero.  The default is the usual doubling.
+  template<size_t _Num = 2, size_t _Den = 1, size_t _MaxStep = 0,
+	   size_t _RoundBytes = 0>
+    struct __vector_growth
+    {
+#if __cplusplus >= 201103L
+      // A full vector has to get bigger, and _Num - _Den must not wrap
+      static_assert(_Den > 0 && _Num > _Den,
+		    "__vector_growth needs _Num / _Den greater than 1");
+#endif
+
+      // The capacity to give a vector of __size elements of __elt bytes
+      // that needs room for __n more, where __size + __n <= __max
+      static size_t
+      _S_next(size_t __size, size_t __n, size_t __max, size_t __elt)
+      {
+	size_t __grow = __size > __max / _Num
+	  ? __max : __size / _Den * (_Num - _Den)
+		    + __size % _Den * (_Num - _Den) / _Den;
+	if (_MaxStep && __grow > _MaxStep)
+	  __grow = _MaxStep;
+	if (__grow < __n)
+	  __grow = __n;
+	size_t __len = __size + __grow;
+	if (__len < __size || __len > __max)
+	  return __max;
+	if (_RoundBytes && __len <= (size_t(-1) - _RoundBytes) / __elt)
+	  {
+	    __len = (__len * __elt + _RoundBytes - 1)
+		    / _RoundBytes * _RoundBytes / __elt;
+	    if (__len > __max)
+	      __len = __max;
+	  }
+	return __len;
+      }
+    };
+
+  // The growth of vector<_Tp, _Alloc>.  Specialize it to give one kind of
+  // vector another __vector_growth, e.g.
+  //   template<>
+  //     struct __vector_growth_policy<T, std::allocator<T>>
+  //     : std::__vector_growth<3, 2, 0, 4096> { };
+  // for 1.5x growth, in whole pages.
+  template<typename _Tp, typename _Alloc>
+    struct __vector_growth_policy : public __vector_growth<>
+    { };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+
 _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 
   /// See bits/stl_deque.h's _Deque_base for an explanation.
@@ -1417,15 +1475,16 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
         _M_emplace_back_aux(_Args&&... __args);
 #endif
 
-      // Called by the latter.
+      // Called by the latter.  The new capacity is up to the vector's
+      // __vector_growth_policy.
       size_type
       _M_check_len(size_type __n, const char* __s) const
       {
 	if (max_size() - size() < __n)
 	  __throw_length_error(__N(__s));
 
-	const size_type __len = size() + std::max(size(), __n);
-	return (__len < size() || __len > max_size()) ? max_size() : __len;
+	return __vector_growth_policy<_Tp, _Alloc>::
+	  _S_next(size(), __n, max_size(), sizeof(_Tp));
       }
 
       // Internal erase functions follow.
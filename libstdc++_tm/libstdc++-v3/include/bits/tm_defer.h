@@ -0,0 +1,102 @@
+// Deferred reclamation for the transactional containers -*- C++ -*-
+
+// This file is part of the transactional version of the GNU ISO C++
+// Library, and is distributed under the same terms.
+
+/** @file bits/tm_defer.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly.
+ *
+ *  Inside a transaction, destroying a large structure node by node puts
+ *  every node in the read set and logs every free, so that clearing a big
+ *  container makes for a huge transaction that is likely to abort.  The
+ *  containers instead unlink the whole structure in a constant number of
+ *  transactional writes, and hand it to __tm_defer_to_commit, which runs
+ *  the teardown on the committing thread once the transaction has
+ *  committed.  If the transaction aborts, the unlinking is rolled back and
+ *  the teardown is dropped.  The runtime quiesces before it runs commit
+ *  actions, so no concurrent transaction can still be reading the nodes.
+ *
+ *  A commit action runs outside of the transaction, so it may only free
+ *  memory: a value's destructor has to run inside the transaction that
+ *  destroys it, where its effects are isolated and rolled back on abort.
+ *  Containers therefore only defer when their values are trivially
+ *  destructible, and otherwise destroy node by node, in place.
+ */
+
+#ifndef _TM_DEFER_H
+#define _TM_DEFER_H 1
+
+#include <bits/c++config.h>
+#if __cplusplus >= 201103L
+#include <type_traits>
+#endif
+
+#ifdef __i386__
+# define _GLIBCXX_ITM_REGPARM __attribute__((regparm(2)))
+#else
+# define _GLIBCXX_ITM_REGPARM
+#endif
+
+extern "C"
+{
+  // From the GCC TM ABI (libitm.h, or libtm/itm.h in this tree).  The real
+  // return type of _ITM_inTransaction is the _ITM_howExecuting enum, which
+  // is zero outside of a transaction.  Declaring it under its own name
+  // would clash with those headers, so bind a private name to the symbol.
+  int
+  __tm_in_transaction() __asm__("_ITM_inTransaction") _GLIBCXX_ITM_REGPARM;
+
+  void
+  _ITM_addUserCommitAction(void (*)(void*), __UINT64_TYPE__,
+			   void*) _GLIBCXX_ITM_REGPARM;
+}
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // Have __fn(__arg) run after the enclosing transaction commits, and
+  // return true; or, outside of a transaction, return false, in which case
+  // the caller has to do the work itself, now.  Setting
+  // _GLIBCXX_TM_NO_DEFER makes every container tear down in place, as the
+  // baseline to compare with.
+  __attribute__((transaction_pure))
+  inline bool
+  __tm_defer_to_commit(void (*__fn)(void*), void* __arg) _GLIBCXX_NOEXCEPT
+  {
+#ifdef _GLIBCXX_TM_NO_DEFER
+    return false;
+#else
+    if (__tm_in_transaction() == 0)
+      return false;
+    // 1 is _ITM_noTransactionId: the action belongs to the current
+    // transaction
+    _ITM_addUserCommitAction(__fn, 1, __arg);
+    return true;
+#endif
+  }
+
+#if __cplusplus >= 201103L
+  // Whether a commit action can make its own copy of an _Alloc to free
+  // with, so that it only has to carry the nodes
+  template<typename _Alloc>
+    using __tm_stateless_alloc
+      = integral_constant<bool, is_empty<_Alloc>::value
+				&& is_default_constructible<_Alloc>::value>;
+
+  // Whether nodes of _Tp, from an _Alloc, can be left to a commit action:
+  // the action has to be able to free them, and tearing them down must
+  // not run any code of the value type's
+  template<typename _Alloc, typename _Tp>
+    using __tm_can_defer
+      = integral_constant<bool, __tm_stateless_alloc<_Alloc>::value
+				&& is_trivially_destructible<_Tp>::value>;
+#endif
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#undef _GLIBCXX_ITM_REGPARM
+
+#endif /* _TM_DEFER_H */
@@ -126,6 +126,10 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       typedef typename _Hashtable::difference_type	difference_type;
       //@}
 
+      /// Node handle typedefs.
+      typedef typename _Hashtable::node_type		node_type;
+      typedef typename _Hashtable::insert_return_type	insert_return_type;
+
       //construct/destroy/copy
 
       /**
@@ -370,6 +374,205 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	emplace_hint(const_iterator __pos, _Args&&... __args)
 	{ return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
 
+      /**
+       *  @brief Attempts to build and insert a std::pair into the
+       *         %unordered_map.
+       *
+       *  @param __k     Key of the pair.
+       *  @param __args  Arguments used to build the mapped value of a new
+       *                 pair.
+       *  @return  A pair, of which the first element is an iterator that points
+       *           to the possibly inserted pair, and the second is a bool that
+       *           is true if the pair was actually inserted.
+       *
+       *  This is C++17's try_emplace, which the transactional library
+       *  provides from C++11 on.  The key is hashed and looked up once,
+       *  and the pair is only built if the key is not already present, in
+       *  which case @a __args are left as they were.  Unlike emplace(), no
+       *  node is made and then thrown away, and unlike operator[], no
+       *  mapped value is built and then assigned over: inside a
+       *  transaction, each of those is an allocation or stores that have
+       *  to be logged.
+       *
+       *  Insertion requires amortized constant time.
+       */
+      template<typename... _Args>
+	std::pair<iterator, bool>
+	try_emplace(const key_type& __k, _Args&&... __args)
+	{ return _M_h._M_try_emplace(__k, std::forward<_Args>(__args)...); }
+
+      template<typename... _Args>
+	std::pair<iterator, bool>
+	try_emplace(key_type&& __k, _Args&&... __args)
+	{
+	  return _M_h._M_try_emplace(std::move(__k),
+				     std::forward<_Args>(__args)...);
+	}
+
+      /**
+       *  @brief Attempts to build and insert a std::pair into the
+       *         %unordered_map.
+       *
+       *  @param  __hint  An iterator that serves as a hint as to where the
+       *                  pair should be inserted.
+       *  @param  __k     Key of the pair.
+       *  @param  __args  Arguments used to build the mapped value of a new
+       *                  pair.
+       *  @return An iterator that points to the element with key @a __k
+       *          (may or may not be a new pair).
+       *
+       *  As try_emplace(__k, __args...); like emplace_hint(), this
+       *  container has no use for the hint.
+       *
+       *  Insertion requires amortized constant time.
+       */
+      template<typename... _Args>
+	iterator
+	try_emplace(const_iterator __hint, const key_type& __k,
+		    _Args&&... __args)
+	{
+	  return _M_h._M_try_emplace(__k,
+				     std::forward<_Args>(__args)...).first;
+	}
+
+      template<typename... _Args>
+	iterator
+	try_emplace(const_iterator __hint, key_type&& __k, _Args&&... __args)
+	{
+	  return _M_h._M_try_emplace(std::move(__k),
+				     std::forward<_Args>(__args)...).first;
+	}
+
+      /**
+       *  @brief Inserts a std::pair into the %unordered_map, or assigns to
+       *         the mapped value of the pair that has its key.
+       *
+       *  @param __k    Key of the pair.
+       *  @param __obj  Value to insert or assign.
+       *  @return  A pair, of which the first element is an iterator that points
+       *           to the pair with key @a __k, and the second is a bool that
+       *           is true if the pair was inserted, and false if it was
+       *           assigned to.
+       *
+       *  This is C++17's insert_or_assign, which the transactional library
+       *  provides from C++11 on.  As with try_emplace(), the key is looked
+       *  up once, and a pair is only built if the key is not present.
+       *
+       *  Insertion requires amortized constant time.
+       */
+      template<typename _Obj>
+	std::pair<iterator, bool>
+	insert_or_assign(const key_type& __k, _Obj&& __obj)
+	{ return _M_h._M_insert_or_assign(__k, std::forward<_Obj>(__obj)); }
+
+      template<typename _Obj>
+	std::pair<iterator, bool>
+	insert_or_assign(key_type&& __k, _Obj&& __obj)
+	{
+	  return _M_h._M_insert_or_assign(std::move(__k),
+					  std::forward<_Obj>(__obj));
+	}
+
+      /**
+       *  @brief Inserts a std::pair into the %unordered_map, or assigns to
+       *         the mapped value of the pair that has its key.
+       *
+       *  @param  __hint  An iterator that serves as a hint as to where the
+       *                  pair should be inserted.
+       *  @param  __k     Key of the pair.
+       *  @param  __obj   Value to insert or assign.
+       *  @return An iterator that points to the pair with key @a __k.
+       *
+       *  As insert_or_assign(__k, __obj); like emplace_hint(), this
+       *  container has no use for the hint.
+       *
+       *  Insertion requires amortized constant time.
+       */
+      template<typename _Obj>
+	iterator
+	insert_or_assign(const_iterator __hint, const key_type& __k,
+			 _Obj&& __obj)
+	{
+	  return _M_h._M_insert_or_assign(__k,
+					  std::forward<_Obj>(__obj)).first;
+	}
+
+      template<typename _Obj>
+	iterator
+	insert_or_assign(const_iterator __hint, key_type&& __k, _Obj&& __obj)
+	{
+	  return _M_h._M_insert_or_assign(std::move(__k),
+					  std::forward<_Obj>(__obj)).first;
+	}
+
+      /**
+       *  @brief Takes the element at a position out of the %unordered_map.
+       *  @param  __pos  An iterator into the %unordered_map.
+       *  @return A node handle that owns the element.
+       *
+       *  This is C++17's extract, which the transactional library provides
+       *  from C++11 on.  The node is unlinked but not freed, so that it can
+       *  go into another %unordered_map with insert(node_type&&), without
+       *  an allocation, or be destroyed with the handle.
+       */
+      node_type
+      extract(const_iterator __pos)
+      { return _M_h.extract(__pos); }
+
+      /**
+       *  @brief Takes the element with a key out of the %unordered_map.
+       *  @param  __key  Key of the element to be extracted.
+       *  @return A node handle that owns the element, or an empty one if
+       *          there is no such element.
+       */
+      node_type
+      extract(const key_type& __key)
+      { return _M_h.extract(__key); }
+
+      /**
+       *  @brief Links the node of a handle into the %unordered_map.
+       *  @param  __nh  A node handle from extract() on an %unordered_map of
+       *                this type.
+       *  @return Where the key is, whether the node went in, and, if it did
+       *          not, the handle, which still owns it.
+       *
+       *  Insertion requires amortized constant time, and no allocation
+       *  unless the table grows.
+       */
+      insert_return_type
+      insert(node_type&& __nh)
+      { return _M_h._M_reinsert_node(std::move(__nh)); }
+
+      /**
+       *  @brief As insert(node_type&&); this container has no use for the
+       *         hint.
+       *  @return An iterator to the element with the node's key.  If that
+       *          is not the node, @a __nh still owns the node.
+       */
+      iterator
+      insert(const_iterator __hint, node_type&& __nh)
+      { return _M_h._M_reinsert_node_hint(__hint, std::move(__nh)); }
+
+      /**
+       *  @brief Moves the elements of another %unordered_map over to this
+       *         one.
+       *  @param  __source  An %unordered_map with the same allocator, which
+       *                    may hash and compare keys differently.
+       *
+       *  Each element whose key is not in this %unordered_map yet is
+       *  relinked into it; the others stay in @a __source.  No element is
+       *  copied, moved or allocated.
+       */
+      template<typename _H2, typename _P2>
+	void
+	merge(unordered_map<_Key, _Tp, _H2, _P2, _Alloc>& __source)
+	{ _M_h._M_merge_unique(__source._M_h); }
+
+      template<typename _H2, typename _P2>
+	void
+	merge(unordered_map<_Key, _Tp, _H2, _P2, _Alloc>&& __source)
+	{ merge(__source); }
+
       //@{
       /**
        *  @brief Attempts to insert a std::pair into the %unordered_map.
@@ -778,6 +981,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
         friend bool
       operator==(const unordered_map<_Key1, _Tp1, _Hash1, _Pred1, _Alloc1>&,
 		 const unordered_map<_Key1, _Tp1, _Hash1, _Pred1, _Alloc1>&);
+
+      // For merge() from an unordered_map that hashes differently
+      template<typename _Key1, typename _Tp1, typename _Hash1, typename _Pred1,
+	       typename _Alloc1>
+	friend class unordered_map;
     };
 
   /**
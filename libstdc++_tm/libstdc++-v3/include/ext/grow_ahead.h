@@ -0,0 +1,83 @@
+// Growing a shared vector ahead of its appends -*- C++ -*-
+
+// This file is part of the transactional version of the GNU ISO C++
+// Library, and is distributed under the same terms.
+
+/** @file ext/grow_ahead.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  A push_back that finds a vector full reallocates it in the pushing
+ *  transaction, which then reads every element and writes all of them to
+ *  the new buffer.  When many threads append to one vector, that
+ *  transaction conflicts with every other append, and the reallocation is
+ *  what aborts.  Instead, the appending transaction can check first
+ *  whether its elements fit, and if they do not, commit without appending;
+ *  the thread then grows the vector in a transaction of its own, which
+ *  does nothing else, and tries the append again:
+ *
+ *  @code
+ *    for (bool __appended = false; !__appended; )
+ *      {
+ *        __transaction_atomic
+ *        {
+ *          __appended = __gnu_cxx::append_fits(__v);
+ *          if (__appended)
+ *            __v.push_back(__x);
+ *        }
+ *        if (!__appended)
+ *          __transaction_atomic { __gnu_cxx::grow_for_append(__v); }
+ *      }
+ *  @endcode
+ *
+ *  The appends then never reallocate, and the growth takes the next
+ *  capacity from the vector's std::__vector_growth_policy, as push_back
+ *  would.  A vector that no other thread can reach may grow outside of
+ *  any transaction.
+ */
+
+#ifndef _GROW_AHEAD_H
+#define _GROW_AHEAD_H 1
+
+#pragma GCC system_header
+
+#include <vector>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Whether @a __n more elements fit in @a __v without reallocating it.
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    append_fits(const std::vector<_Tp, _Alloc>& __v,
+		typename std::vector<_Tp, _Alloc>::size_type __n = 1)
+    { return __v.capacity() - __v.size() >= __n; }
+
+  /**
+   *  @brief Make room for @a __n more elements in @a __v, as an append
+   *         would, if they do not fit.
+   *  @return Whether @a __v had to grow.
+   *
+   *  Growing takes the capacity that the next reallocating append would
+   *  have picked, from the vector's std::__vector_growth_policy, so that
+   *  a vector that only ever grows ahead has the same capacities as one
+   *  that grows in push_back.
+   */
+  template<typename _Tp, typename _Alloc>
+    bool
+    grow_for_append(std::vector<_Tp, _Alloc>& __v,
+		    typename std::vector<_Tp, _Alloc>::size_type __n = 1)
+    {
+      if (append_fits(__v, __n))
+	return false;
+      if (__v.max_size() - __v.size() < __n)
+	std::__throw_length_error(__N("__gnu_cxx::grow_for_append"));
+      __v.reserve(std::__vector_growth_policy<_Tp, _Alloc>::
+		  _S_next(__v.size(), __n, __v.max_size(), sizeof(_Tp)));
+      return true;
+    }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#endif /* _GROW_AHEAD_H */
@@ -0,0 +1,180 @@
+// Resumable scans of the ordered containers -*- C++ -*-
+
+// This file is part of the transactional version of the GNU ISO C++
+// Library, and is distributed under the same terms.
+
+/** @file ext/scan_cursor.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Walking a big map, set, multimap or multiset in one transaction puts
+ *  every node it visits in the read set, so that the transaction conflicts
+ *  with any write to any of them, and a long scan hardly ever commits
+ *  while other threads update the container.  A scan_cursor instead splits
+ *  the scan into batches of a bounded size, each meant to run in a
+ *  transaction of its own.  Between batches, it only keeps the last key
+ *  that it visited: the next batch starts at upper_bound() of that key, so
+ *  that each batch is a consistent view of a range of keys, and the scan
+ *  as a whole visits keys in order and never visits one twice, but it is
+ *  not a snapshot of the container.  Elements that are inserted behind the
+ *  cursor are missed, and ones that are erased ahead of it are not seen.
+ */
+
+#ifndef _SCAN_CURSOR_H
+#define _SCAN_CURSOR_H 1
+
+#pragma GCC system_header
+
+#include <bits/c++config.h>
+#include <bits/stl_pair.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief A position in an ordered container that survives between
+   *         transactions, as a key.
+   *
+   *  @tparam _Container  A std::map, std::set, std::multimap or
+   *                      std::multiset, whose key_type is default
+   *                      constructible and copy assignable.
+   *
+   *  The cursor belongs to one thread, and may be used with the container
+   *  inside transactions: if a batch aborts, the cursor goes back to where
+   *  it was with the rest of the transaction's writes.
+   */
+  template<typename _Container>
+    class scan_cursor
+    {
+    public:
+      typedef _Container				container_type;
+      typedef typename _Container::key_type		key_type;
+      typedef typename _Container::value_type		value_type;
+      typedef typename _Container::size_type		size_type;
+      typedef typename _Container::const_iterator	const_iterator;
+
+      /// A cursor at the start of the container, for batches of at most
+      /// @a __batch elements (at least one).
+      explicit
+      scan_cursor(size_type __batch)
+      : _M_last(), _M_batch(__batch ? __batch : 1),
+	_M_started(false), _M_done(false), _M_inclusive(false) { }
+
+      size_type
+      batch_size() const
+      { return _M_batch; }
+
+      void
+      set_batch_size(size_type __batch)
+      { _M_batch = __batch ? __batch : 1; }
+
+      /// Go back to the start of the container.
+      void
+      rewind()
+      {
+	_M_started = false;
+	_M_done = false;
+      }
+
+      /// Go to the first element whose key is not less than @a __k.
+      void
+      seek(const key_type& __k)
+      {
+	_M_last = __k;
+	_M_started = true;
+	_M_done = false;
+	_M_inclusive = true;
+      }
+
+      /// Whether a batch has reached the end of the container.
+      bool
+      done() const
+      { return _M_done; }
+
+      /// The key that the last batch ended with.  Only valid once a batch
+      /// has visited something.
+      const key_type&
+      last_key() const
+      { return _M_last; }
+
+      /**
+       *  @brief Visit the next batch of elements.
+       *  @param  __c  The container, which should be the same one in every
+       *               batch of a scan.
+       *  @param  __f  Called with each element, in key order, as const
+       *               value_type&.
+       *  @return The number of elements visited.  Zero means that the scan
+       *          is done().
+       *
+       *  A batch visits batch_size() elements, or fewer at the end of the
+       *  container.  In a multi container, it also visits the rest of the
+       *  elements with the same key as its last one, since the next batch
+       *  starts after that key.  Run each batch in a transaction of its
+       *  own: one lookup, and then the batch's elements, join its read set.
+       */
+      template<typename _Function>
+	size_type
+	next(const _Container& __c, _Function __f)
+	{
+	  if (_M_done)
+	    return 0;
+
+	  const_iterator __i = _M_start(__c);
+	  const_iterator __end = __c.end();
+	  const_iterator __last = __end;
+	  size_type __n = 0;
+	  for (; __i != __end && __n < _M_batch; ++__n)
+	    {
+	      __f(*__i);
+	      __last = __i++;
+	    }
+
+	  if (__n)
+	    {
+	      typename _Container::key_compare __comp = __c.key_comp();
+	      for (; __i != __end && !__comp(_S_key(*__last), _S_key(*__i));
+		   ++__i, ++__n)
+		__f(*__i);
+	      _M_last = _S_key(*__last);
+	      _M_started = true;
+	      _M_inclusive = false;
+	    }
+	  if (__i == __end)
+	    _M_done = true;
+	  return __n;
+	}
+
+    private:
+      const_iterator
+      _M_start(const _Container& __c) const
+      {
+	if (!_M_started)
+	  return __c.begin();
+	if (_M_inclusive)
+	  return __c.lower_bound(_M_last);
+	return __c.upper_bound(_M_last);
+      }
+
+      // The key of a set's element, and of a map's
+      static const key_type&
+      _S_key(const key_type& __k)
+      { return __k; }
+
+      template<typename _Tp>
+	static const key_type&
+	_S_key(const std::pair<const key_type, _Tp>& __v)
+	{ return __v.first; }
+
+      key_type	_M_last;
+      size_type	_M_batch;
+      bool	_M_started;
+      bool	_M_done;
+      // Whether the next batch starts at _M_last, after a seek(), rather
+      // than after it
+      bool	_M_inclusive;
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#endif /* _SCAN_CURSOR_H */
@@ -0,0 +1,693 @@
+// A vector whose elements never move -*- C++ -*-
+
+// This file is part of the transactional version of the GNU ISO C++
+// Library, and is distributed under the same terms.
+
+/** @file ext/segmented_vector.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  A std::vector that fills up reallocates, and moves every element to the
+ *  new buffer, so that under TM the append that does it carries the whole
+ *  vector in its read and write sets (see ext/grow_ahead.h for avoiding
+ *  that, with a vector).  A segmented_vector instead keeps its elements in
+ *  segments that double in size, from a table of segment pointers that is
+ *  part of the object, and adds a segment when it fills up.  Nothing ever
+ *  moves: push_back writes the new element and the size, and the pointer
+ *  to a new segment once per segment, so that a transactional append stays
+ *  small however big the container is, and pointers, references and
+ *  iterators to elements stay valid until their elements are removed.
+ *  Finding an element takes a log2 of its index.
+ *
+ *  It has the parts of the vector interface that do not move elements:
+ *  construction, assignment, element access, random access iterators,
+ *  size and capacity, and changes at the end.  There is no insert or
+ *  erase in the middle, and no data(), since the elements are not
+ *  contiguous.
+ */
+
+#ifndef _SEGMENTED_VECTOR_H
+#define _SEGMENTED_VECTOR_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+# include <bits/c++0x_warning.h>
+#else
+
+#include <initializer_list>
+#include <bits/allocator.h>
+#include <bits/functexcept.h>
+#include <bits/stl_algobase.h>
+#include <bits/stl_construct.h>
+#include <bits/stl_iterator.h>
+#include <ext/alloc_traits.h>
+#include <ext/numeric_traits.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// An index into a segmented_vector, as a random access iterator.  It
+  /// stays valid while the container does, and while the element exists.
+  template<typename _Container, typename _Value>
+    class _Segmented_iterator
+    {
+      template<typename _Container2, typename _Value2>
+	friend class _Segmented_iterator;
+
+      _Container*				_M_c;
+      typename _Container::size_type		_M_i;
+
+    public:
+      typedef std::random_access_iterator_tag		iterator_category;
+      typedef _Value					value_type;
+      typedef typename _Container::difference_type	difference_type;
+      typedef _Value*					pointer;
+      typedef _Value&					reference;
+
+      _Segmented_iterator() noexcept
+      : _M_c(), _M_i() { }
+
+      _Segmented_iterator(_Container* __c,
+			  typename _Container::size_type __i) noexcept
+      : _M_c(__c), _M_i(__i) { }
+
+      // iterator to const_iterator
+      template<typename _Container2, typename _Value2>
+	_Segmented_iterator(const _Segmented_iterator<_Container2, _Value2>&
+			    __it) noexcept
+	: _M_c(__it._M_c), _M_i(__it._M_i) { }
+
+      reference
+      operator*() const
+      { return (*_M_c)[_M_i]; }
+
+      pointer
+      operator->() const
+      { return std::__addressof((*_M_c)[_M_i]); }
+
+      reference
+      operator[](difference_type __n) const
+      { return (*_M_c)[_M_i + __n]; }
+
+      _Segmented_iterator&
+      operator++() noexcept
+      {
+	++_M_i;
+	return *this;
+      }
+
+      _Segmented_iterator
+      operator++(int) noexcept
+      { return _Segmented_iterator(_M_c, _M_i++); }
+
+      _Segmented_iterator&
+      operator--() noexcept
+      {
+	--_M_i;
+	return *this;
+      }
+
+      _Segmented_iterator
+      operator--(int) noexcept
+      { return _Segmented_iterator(_M_c, _M_i--); }
+
+      _Segmented_iterator&
+      operator+=(difference_type __n) noexcept
+      {
+	_M_i += __n;
+	return *this;
+      }
+
+      _Segmented_iterator&
+      operator-=(difference_type __n) noexcept
+      {
+	_M_i -= __n;
+	return *this;
+      }
+
+      _Segmented_iterator
+      operator+(difference_type __n) const noexcept
+      { return _Segmented_iterator(_M_c, _M_i + __n); }
+
+      friend _Segmented_iterator
+      operator+(difference_type __n, const _Segmented_iterator& __it) noexcept
+      { return __it + __n; }
+
+      _Segmented_iterator
+      operator-(difference_type __n) const noexcept
+      { return _Segmented_iterator(_M_c, _M_i - __n); }
+
+      template<typename _Container2, typename _Value2>
+	difference_type
+	operator-(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return difference_type(_M_i - __it._M_i); }
+
+      template<typename _Container2, typename _Value2>
+	bool
+	operator==(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return _M_i == __it._M_i; }
+
+      template<typename _Container2, typename _Value2>
+	bool
+	operator!=(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return _M_i != __it._M_i; }
+
+      template<typename _Container2, typename _Value2>
+	bool
+	operator<(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return _M_i < __it._M_i; }
+
+      template<typename _Container2, typename _Value2>
+	bool
+	operator>(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return _M_i > __it._M_i; }
+
+      template<typename _Container2, typename _Value2>
+	bool
+	operator<=(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return _M_i <= __it._M_i; }
+
+      template<typename _Container2, typename _Value2>
+	bool
+	operator>=(const _Segmented_iterator<_Container2, _Value2>& __it)
+	const noexcept
+	{ return _M_i >= __it._M_i; }
+    };
+
+  /**
+   *  @brief A sequence of elements that never move, with indexed access.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Alloc  Allocator type, defaults to allocator<_Tp>.
+   *
+   *  Segment k holds _S_first << k elements, so that element i is in
+   *  segment log2(i + _S_first) - log2(_S_first).  The segments are
+   *  allocated in order, and only freed by shrink_to_fit() and the
+   *  destructor.
+   */
+  template<typename _Tp, typename _Alloc = std::allocator<_Tp> >
+    class segmented_vector
+    {
+      typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other
+							_Tp_alloc_type;
+      typedef __alloc_traits<_Tp_alloc_type>		_Alloc_traits;
+
+    public:
+      typedef _Tp					value_type;
+      typedef typename _Alloc_traits::pointer		pointer;
+      typedef typename _Alloc_traits::const_pointer	const_pointer;
+      typedef typename _Alloc_traits::reference		reference;
+      typedef typename _Alloc_traits::const_reference	const_reference;
+      typedef _Segmented_iterator<segmented_vector, _Tp>	iterator;
+      typedef _Segmented_iterator<const segmented_vector, const _Tp>
+							const_iterator;
+      typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+      typedef std::reverse_iterator<iterator>		reverse_iterator;
+      typedef std::size_t				size_type;
+      typedef std::ptrdiff_t				difference_type;
+      typedef _Alloc					allocator_type;
+
+    private:
+      // The elements in the first segment, a power of two
+      static const size_type _S_first_log2 = 4;
+      static const size_type _S_first = size_type(1) << _S_first_log2;
+
+      // Enough segments for any index
+      static const size_type _S_max_segments
+	= __numeric_traits<size_type>::__digits - _S_first_log2;
+
+      struct _Impl : public _Tp_alloc_type
+      {
+	pointer		_M_segments[_S_max_segments];
+	size_type	_M_size;
+
+	_Impl() noexcept
+	: _Tp_alloc_type(), _M_segments(), _M_size(0) { }
+
+	_Impl(const _Tp_alloc_type& __a) noexcept
+	: _Tp_alloc_type(__a), _M_segments(), _M_size(0) { }
+
+	_Impl(_Tp_alloc_type&& __a) noexcept
+	: _Tp_alloc_type(std::move(__a)), _M_segments(), _M_size(0) { }
+      };
+
+      _Impl _M_impl;
+
+    public:
+      // [23.2.4.1] construct/copy/destroy
+
+      segmented_vector() noexcept
+      { }
+
+      explicit
+      segmented_vector(const allocator_type& __a) noexcept
+      : _M_impl(__a) { }
+
+      explicit
+      segmented_vector(size_type __n,
+		       const allocator_type& __a = allocator_type())
+      : _M_impl(__a)
+      { resize(__n); }
+
+      segmented_vector(size_type __n, const value_type& __value,
+		       const allocator_type& __a = allocator_type())
+      : _M_impl(__a)
+      { resize(__n, __value); }
+
+      template<typename _InputIterator,
+	       typename = std::_RequireInputIter<_InputIterator>>
+	segmented_vector(_InputIterator __first, _InputIterator __last,
+			 const allocator_type& __a = allocator_type())
+	: _M_impl(__a)
+	{
+	  for (; __first != __last; ++__first)
+	    emplace_back(*__first);
+	}
+
+      segmented_vector(std::initializer_list<value_type> __l,
+		       const allocator_type& __a = allocator_type())
+      : segmented_vector(__l.begin(), __l.end(), __a) { }
+
+      segmented_vector(const segmented_vector& __x)
+      : _M_impl(_Alloc_traits::_S_select_on_copy(__x._M_get_Tp_allocator()))
+      { _M_append_copy(__x); }
+
+      segmented_vector(segmented_vector&& __x) noexcept
+      : _M_impl(std::move(__x._M_get_Tp_allocator()))
+      { _M_steal(__x); }
+
+      ~segmented_vector()
+      {
+	clear();
+	_M_free_segments(0);
+      }
+
+      segmented_vector&
+      operator=(const segmented_vector& __x)
+      {
+	if (this != &__x)
+	  {
+	    clear();
+	    if (_Alloc_traits::_S_propagate_on_copy_assign())
+	      {
+		_M_free_segments(0);
+		std::__alloc_on_copy(_M_get_Tp_allocator(),
+				     __x._M_get_Tp_allocator());
+	      }
+	    _M_append_copy(__x);
+	  }
+	return *this;
+      }
+
+      segmented_vector&
+      operator=(segmented_vector&& __x)
+      noexcept(_Alloc_traits::_S_nothrow_move())
+      {
+	if (this != &__x)
+	  {
+	    clear();
+	    if (_Alloc_traits::_S_nothrow_move()
+		|| _M_get_Tp_allocator() == __x._M_get_Tp_allocator())
+	      {
+		_M_free_segments(0);
+		std::__alloc_on_move(_M_get_Tp_allocator(),
+				     __x._M_get_Tp_allocator());
+		_M_steal(__x);
+	      }
+	    else
+	      {
+		for (size_type __i = 0; __i < __x.size(); ++__i)
+		  emplace_back(std::move(__x[__i]));
+		__x.clear();
+	      }
+	  }
+	return *this;
+      }
+
+      segmented_vector&
+      operator=(std::initializer_list<value_type> __l)
+      {
+	clear();
+	for (const value_type& __v : __l)
+	  emplace_back(__v);
+	return *this;
+      }
+
+      allocator_type
+      get_allocator() const noexcept
+      { return allocator_type(_M_get_Tp_allocator()); }
+
+      // iterators
+      iterator
+      begin() noexcept
+      { return iterator(this, 0); }
+
+      const_iterator
+      begin() const noexcept
+      { return const_iterator(this, 0); }
+
+      iterator
+      end() noexcept
+      { return iterator(this, size()); }
+
+      const_iterator
+      end() const noexcept
+      { return const_iterator(this, size()); }
+
+      reverse_iterator
+      rbegin() noexcept
+      { return reverse_iterator(end()); }
+
+      const_reverse_iterator
+      rbegin() const noexcept
+      { return const_reverse_iterator(end()); }
+
+      reverse_iterator
+      rend() noexcept
+      { return reverse_iterator(begin()); }
+
+      const_reverse_iterator
+      rend() const noexcept
+      { return const_reverse_iterator(begin()); }
+
+      const_iterator
+      cbegin() const noexcept
+      { return begin(); }
+
+      const_iterator
+      cend() const noexcept
+      { return end(); }
+
+      const_reverse_iterator
+      crbegin() const noexcept
+      { return rbegin(); }
+
+      const_reverse_iterator
+      crend() const noexcept
+      { return rend(); }
+
+      // [23.2.4.2] capacity
+      size_type
+      size() const noexcept
+      { return _M_impl._M_size; }
+
+      size_type
+      max_size() const noexcept
+      {
+	return std::min(_Alloc_traits::max_size(_M_get_Tp_allocator()),
+			_S_start(_S_max_segments - 1)
+			+ ((_S_first << (_S_max_segments - 1)) - 1));
+      }
+
+      /// The elements that fit in the segments there are.
+      size_type
+      capacity() const noexcept
+      {
+	size_type __k = 0;
+	while (__k < _S_max_segments && _M_impl._M_segments[__k])
+	  ++__k;
+	return _S_start(__k);
+      }
+
+      bool
+      empty() const noexcept
+      { return size() == 0; }
+
+      void
+      resize(size_type __n)
+      {
+	while (size() > __n)
+	  pop_back();
+	while (size() < __n)
+	  emplace_back();
+      }
+
+      void
+      resize(size_type __n, const value_type& __value)
+      {
+	while (size() > __n)
+	  pop_back();
+	while (size() < __n)
+	  emplace_back(__value);
+      }
+
+      /// Allocate the segments for @a __n elements, now.
+      void
+      reserve(size_type __n)
+      {
+	if (__n > max_size())
+	  std::__throw_length_error(__N("segmented_vector::reserve"));
+	for (size_type __k = 0; __n > _S_start(__k); ++__k)
+	  if (!_M_impl._M_segments[__k])
+	    _M_new_segment(__k);
+      }
+
+      /// Free the segments that hold no element.
+      void
+      shrink_to_fit()
+      { _M_free_segments(empty() ? 0 : _S_segment(size() - 1) + 1); }
+
+      // element access
+      reference
+      operator[](size_type __n) noexcept
+      {
+	const size_type __k = _S_segment(__n);
+	return *(_M_impl._M_segments[__k] + (__n - _S_start(__k)));
+      }
+
+      const_reference
+      operator[](size_type __n) const noexcept
+      {
+	const size_type __k = _S_segment(__n);
+	return *(_M_impl._M_segments[__k] + (__n - _S_start(__k)));
+      }
+
+      reference
+      at(size_type __n)
+      {
+	_M_range_check(__n);
+	return (*this)[__n];
+      }
+
+      const_reference
+      at(size_type __n) const
+      {
+	_M_range_check(__n);
+	return (*this)[__n];
+      }
+
+      reference
+      front() noexcept
+      { return (*this)[0]; }
+
+      const_reference
+      front() const noexcept
+      { return (*this)[0]; }
+
+      reference
+      back() noexcept
+      { return (*this)[size() - 1]; }
+
+      const_reference
+      back() const noexcept
+      { return (*this)[size() - 1]; }
+
+      // [23.2.4.3] modifiers
+      void
+      push_back(const value_type& __x)
+      { emplace_back(__x); }
+
+      void
+      push_back(value_type&& __x)
+      { emplace_back(std::move(__x)); }
+
+      /**
+       *  Construct an element at the end.  Only the new element and the
+       *  size are written, and the pointer to a new segment, when the last
+       *  one is full.
+       */
+      template<typename... _Args>
+	void
+	emplace_back(_Args&&... __args)
+	{
+	  const size_type __n = size();
+	  const size_type __k = _S_segment(__n);
+	  pointer __seg = _M_impl._M_segments[__k];
+	  if (!__seg)
+	    __seg = _M_new_segment(__k);
+	  _Alloc_traits::construct(_M_impl,
+				   std::__addressof(*(__seg
+						      + (__n - _S_start(__k)))),
+				   std::forward<_Args>(__args)...);
+	  _M_impl._M_size = __n + 1;
+	}
+
+      void
+      pop_back() noexcept
+      {
+	__glibcxx_requires_nonempty();
+	_Alloc_traits::destroy(_M_impl, std::__addressof(back()));
+	--_M_impl._M_size;
+      }
+
+      void
+      swap(segmented_vector& __x)
+      noexcept(_Alloc_traits::_S_nothrow_swap())
+      {
+	for (size_type __k = 0; __k < _S_max_segments; ++__k)
+	  std::swap(_M_impl._M_segments[__k], __x._M_impl._M_segments[__k]);
+	std::swap(_M_impl._M_size, __x._M_impl._M_size);
+	_Alloc_traits::_S_on_swap(_M_get_Tp_allocator(),
+				  __x._M_get_Tp_allocator());
+      }
+
+      /// Destroy every element, and keep the segments.
+      void
+      clear() noexcept
+      {
+	const size_type __n = size();
+	for (size_type __k = 0; __n > _S_start(__k); ++__k)
+	  {
+	    pointer __seg = _M_impl._M_segments[__k];
+	    const size_type __len = std::min(__n - _S_start(__k),
+					     _S_first << __k);
+	    std::_Destroy(__seg, __seg + __len, _M_get_Tp_allocator());
+	  }
+	_M_impl._M_size = 0;
+      }
+
+    private:
+      _Tp_alloc_type&
+      _M_get_Tp_allocator() noexcept
+      { return _M_impl; }
+
+      const _Tp_alloc_type&
+      _M_get_Tp_allocator() const noexcept
+      { return _M_impl; }
+
+      // The segment that element __n is in
+      static size_type
+      _S_segment(size_type __n) noexcept
+      { return std::__lg(__n + _S_first) - _S_first_log2; }
+
+      // The index of the first element of segment __k
+      static size_type
+      _S_start(size_type __k) noexcept
+      { return (_S_first << __k) - _S_first; }
+
+      void
+      _M_range_check(size_type __n) const
+      {
+	if (__n >= size())
+	  std::__throw_out_of_range_fmt(__N("segmented_vector::_M_range_check:"
+					    " __n (which is %zu) >= "
+					    "this->size() (which is %zu)"),
+					__n, size());
+      }
+
+      pointer
+      _M_new_segment(size_type __k)
+      {
+	if (__k >= _S_max_segments)
+	  std::__throw_length_error(__N("segmented_vector::_M_new_segment"));
+	pointer __seg = _Alloc_traits::allocate(_M_impl, _S_first << __k);
+	_M_impl._M_segments[__k] = __seg;
+	return __seg;
+      }
+
+      // Free the segments from __k on, which hold no elements
+      void
+      _M_free_segments(size_type __k) noexcept
+      {
+	for (; __k < _S_max_segments && _M_impl._M_segments[__k]; ++__k)
+	  {
+	    _Alloc_traits::deallocate(_M_impl, _M_impl._M_segments[__k],
+				      _S_first << __k);
+	    _M_impl._M_segments[__k] = pointer();
+	  }
+      }
+
+      // Take __x's segments, and leave it empty, with none
+      void
+      _M_steal(segmented_vector& __x) noexcept
+      {
+	for (size_type __k = 0; __k < _S_max_segments; ++__k)
+	  {
+	    _M_impl._M_segments[__k] = __x._M_impl._M_segments[__k];
+	    __x._M_impl._M_segments[__k] = pointer();
+	  }
+	_M_impl._M_size = __x._M_impl._M_size;
+	__x._M_impl._M_size = 0;
+      }
+
+      void
+      _M_append_copy(const segmented_vector& __x)
+      {
+	reserve(size() + __x.size());
+	for (size_type __i = 0; __i < __x.size(); ++__i)
+	  emplace_back(__x[__i]);
+      }
+    };
+
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    operator==(const segmented_vector<_Tp, _Alloc>& __x,
+	       const segmented_vector<_Tp, _Alloc>& __y)
+    {
+      return __x.size() == __y.size()
+	     && std::equal(__x.begin(), __x.end(), __y.begin());
+    }
+
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    operator<(const segmented_vector<_Tp, _Alloc>& __x,
+	      const segmented_vector<_Tp, _Alloc>& __y)
+    {
+      return std::lexicographical_compare(__x.begin(), __x.end(),
+					  __y.begin(), __y.end());
+    }
+
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    operator!=(const segmented_vector<_Tp, _Alloc>& __x,
+	       const segmented_vector<_Tp, _Alloc>& __y)
+    { return !(__x == __y); }
+
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    operator>(const segmented_vector<_Tp, _Alloc>& __x,
+	      const segmented_vector<_Tp, _Alloc>& __y)
+    { return __y < __x; }
+
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    operator<=(const segmented_vector<_Tp, _Alloc>& __x,
+	       const segmented_vector<_Tp, _Alloc>& __y)
+    { return !(__y < __x); }
+
+  template<typename _Tp, typename _Alloc>
+    inline bool
+    operator>=(const segmented_vector<_Tp, _Alloc>& __x,
+	       const segmented_vector<_Tp, _Alloc>& __y)
+    { return !(__x < __y); }
+
+  template<typename _Tp, typename _Alloc>
+    inline void
+    swap(segmented_vector<_Tp, _Alloc>& __x,
+	 segmented_vector<_Tp, _Alloc>& __y)
+    noexcept(noexcept(__x.swap(__y)))
+    { __x.swap(__y); }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#endif // C++11
+
+#endif /* _SEGMENTED_VECTOR_H */
@@ -114,7 +114,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       void
       deque<_Tp, _Alloc>::
       emplace_front(_Args&&... __args)
-      { TRACE("deque: emplace_front(1)");
+      { TRACE("deque: emplace_front(1)", this);
 	if (this->_M_impl._M_start._M_cur != this->_M_impl._M_start._M_first)
 	  {
 	    this->_M_impl.construct(this->_M_impl._M_start._M_cur - 1,
@@ -130,7 +130,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       void
       deque<_Tp, _Alloc>::
       emplace_back(_Args&&... __args)
-      { TRACE("deque: emplace_back(1)");
+      { TRACE("deque: emplace_back(1)", this);
 	if (this->_M_impl._M_finish._M_cur
 	    != this->_M_impl._M_finish._M_last - 1)
 	  {
@@ -149,7 +149,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       typename deque<_Tp, _Alloc>::iterator
       deque<_Tp, _Alloc>::
       emplace(const_iterator __position, _Args&&... __args)
-      { TRACE("deque: emplace(1)");
+      { TRACE("deque: emplace(1)", this);
 	if (__position._M_cur == this->_M_impl._M_start._M_cur)
 	  {
 	    emplace_front(std::forward<_Args>(__args)...);
@@ -176,7 +176,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #else
     insert(iterator __position, const value_type& __x)
 #endif
-    { TRACE("deque: insert: single(1)");
+    { TRACE("deque: insert: single(1)", this, __x);
       if (__position._M_cur == this->_M_impl._M_start._M_cur)
 	{
 	  push_front(__x);
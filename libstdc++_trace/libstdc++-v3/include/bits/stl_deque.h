@@ -1040,7 +1040,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: begin(1a)"); return this->_M_impl._M_start; }
+      { TRACE("deque: iterator: begin(1a)", this); return this->_M_impl._M_start; }
 
       /**
        *  Returns a read-only (constant) iterator that points to the first
@@ -1048,7 +1048,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       begin() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: begin(1b)"); return this->_M_impl._M_start; }
+      { TRACE("deque: iterator: begin(1b)", this); return this->_M_impl._M_start; }
 
       /**
        *  Returns a read/write iterator that points one past the last
@@ -1057,7 +1057,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: end(1a)"); return this->_M_impl._M_finish; }
+      { TRACE("deque: iterator: end(1a)", this); return this->_M_impl._M_finish; }
 
       /**
        *  Returns a read-only (constant) iterator that points one past
@@ -1066,7 +1066,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       end() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: end(1b)"); return this->_M_impl._M_finish; }
+      { TRACE("deque: iterator: end(1b)", this); return this->_M_impl._M_finish; }
 
       /**
        *  Returns a read/write reverse iterator that points to the
@@ -1075,7 +1075,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rbegin() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: rbegin(1a)"); return reverse_iterator(this->_M_impl._M_finish); }
+      { TRACE("deque: iterator: rbegin(1a)", this); return reverse_iterator(this->_M_impl._M_finish); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -1084,7 +1084,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rbegin() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: rbegin(1b)"); return const_reverse_iterator(this->_M_impl._M_finish); }
+      { TRACE("deque: iterator: rbegin(1b)", this); return const_reverse_iterator(this->_M_impl._M_finish); }
 
       /**
        *  Returns a read/write reverse iterator that points to one
@@ -1093,7 +1093,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rend() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: rend(1a)"); return reverse_iterator(this->_M_impl._M_start); }
+      { TRACE("deque: iterator: rend(1a)", this); return reverse_iterator(this->_M_impl._M_start); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -1102,7 +1102,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rend() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: iterator: rend(1b)"); return const_reverse_iterator(this->_M_impl._M_start); }
+      { TRACE("deque: iterator: rend(1b)", this); return const_reverse_iterator(this->_M_impl._M_start); }
 
 #if __cplusplus >= 201103L
       /**
@@ -1111,7 +1111,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cbegin() const noexcept
-      { TRACE("deque: iterator: cbegin(1)"); return this->_M_impl._M_start; }
+      { TRACE("deque: iterator: cbegin(1)", this); return this->_M_impl._M_start; }
 
       /**
        *  Returns a read-only (constant) iterator that points one past
@@ -1120,7 +1120,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cend() const noexcept
-      { TRACE("deque: iterator: cend(1)"); return this->_M_impl._M_finish; }
+      { TRACE("deque: iterator: cend(1)", this); return this->_M_impl._M_finish; }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -1129,7 +1129,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crbegin() const noexcept
-      { TRACE("deque: iterator: crbegin(1)"); return const_reverse_iterator(this->_M_impl._M_finish); }
+      { TRACE("deque: iterator: crbegin(1)", this); return const_reverse_iterator(this->_M_impl._M_finish); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -1138,14 +1138,14 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crend() const noexcept
-      { TRACE("deque: iterator: crend(1)"); return const_reverse_iterator(this->_M_impl._M_start); }
+      { TRACE("deque: iterator: crend(1)", this); return const_reverse_iterator(this->_M_impl._M_start); }
 #endif
 
       // [23.2.1.2] capacity
       /**  Returns the number of elements in the %deque.  */
       size_type
       size() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: size(1)"); return this->_M_impl._M_finish - this->_M_impl._M_start; }
+      { TRACE("deque: size(1)", this); return this->_M_impl._M_finish - this->_M_impl._M_start; }
 
       /**  Returns the size() of the largest possible %deque.  */
       size_type
@@ -1164,7 +1164,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       resize(size_type __new_size)
-      { TRACE("deque: resize(1a)");
+      { TRACE("deque: resize(1a)", this, __new_size);
 	const size_type __len = size();
 	if (__new_size > __len)
 	  _M_default_append(__new_size - __len);
@@ -1186,7 +1186,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       resize(size_type __new_size, const value_type& __x)
-      { TRACE("deque: resize(1b)");
+      { TRACE("deque: resize(1b)", this, __new_size);
 	const size_type __len = size();
 	if (__new_size > __len)
 	  insert(this->_M_impl._M_finish, __new_size - __len, __x);
@@ -1231,7 +1231,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       bool
       empty() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: empty(1)"); return this->_M_impl._M_finish == this->_M_impl._M_start; }
+      { TRACE("deque: empty(1)", this); return this->_M_impl._M_finish == this->_M_impl._M_start; }
 
       // element access
       /**
@@ -1247,7 +1247,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       operator[](size_type __n) _GLIBCXX_NOEXCEPT
-      { TRACE("deque: operator[](1a)"); return this->_M_impl._M_start[difference_type(__n)]; }
+      { TRACE("deque: operator[](1a)", this, __n); return this->_M_impl._M_start[difference_type(__n)]; }
 
       /**
        *  @brief Subscript access to the data contained in the %deque.
@@ -1262,7 +1262,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       operator[](size_type __n) const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: operator[](1b)"); return this->_M_impl._M_start[difference_type(__n)]; }
+      { TRACE("deque: operator[](1b)", this, __n); return this->_M_impl._M_start[difference_type(__n)]; }
 
     protected:
       /// Safety check used only from at().
@@ -1290,7 +1290,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       at(size_type __n)
-      { TRACE("deque: at(1a)");
+      { TRACE("deque: at(1a)", this, __n);
 	_M_range_check(__n);
 	return (*this)[__n];
       }
@@ -1308,7 +1308,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       at(size_type __n) const
-      { TRACE("deque: at(1b)");
+      { TRACE("deque: at(1b)", this, __n);
 	_M_range_check(__n);
 	return (*this)[__n];
       }
@@ -1319,7 +1319,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       front() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: front(1a)"); return *begin(); }
+      { TRACE("deque: front(1a)", this); return *begin(); }
 
       /**
        *  Returns a read-only (constant) reference to the data at the first
@@ -1327,7 +1327,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       front() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: front(1b)"); return *begin(); }
+      { TRACE("deque: front(1b)", this); return *begin(); }
 
       /**
        *  Returns a read/write reference to the data at the last element of the
@@ -1335,7 +1335,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       back() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: back(1a)");
+      { TRACE("deque: back(1a)", this);
 	iterator __tmp = end();
 	--__tmp;
 	return *__tmp;
@@ -1347,7 +1347,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       back() const _GLIBCXX_NOEXCEPT
-      { TRACE("deque: back(1b)");
+      { TRACE("deque: back(1b)", this);
 	const_iterator __tmp = end();
 	--__tmp;
 	return *__tmp;
@@ -1365,7 +1365,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       push_front(const value_type& __x)
-      { TRACE("deque: push_front(1a)");
+      { TRACE("deque: push_front(1a)", this, __x);
 	if (this->_M_impl._M_start._M_cur != this->_M_impl._M_start._M_first)
 	  {
 	    this->_M_impl.construct(this->_M_impl._M_start._M_cur - 1, __x);
@@ -1378,7 +1378,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #if __cplusplus >= 201103L
       void
       push_front(value_type&& __x)
-      { TRACE("deque: push_front(1b)"); emplace_front(std::move(__x)); }
+      { TRACE("deque: push_front(1b)", this, __x); emplace_front(std::move(__x)); }
 
       template<typename... _Args>
         void
@@ -1396,7 +1396,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       push_back(const value_type& __x)
-      { TRACE("deque: push_back(1a)");
+      { TRACE("deque: push_back(1a)", this, __x);
 	if (this->_M_impl._M_finish._M_cur
 	    != this->_M_impl._M_finish._M_last - 1)
 	  {
@@ -1410,7 +1410,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #if __cplusplus >= 201103L
       void
       push_back(value_type&& __x)
-      { TRACE("deque: push_back(1b)"); emplace_back(std::move(__x)); }
+      { TRACE("deque: push_back(1b)", this, __x); emplace_back(std::move(__x)); }
 
       template<typename... _Args>
         void
@@ -1427,7 +1427,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       pop_front() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: pop_front(1)");
+      { TRACE("deque: pop_front(1)", this);
 	if (this->_M_impl._M_start._M_cur
 	    != this->_M_impl._M_start._M_last - 1)
 	  {
@@ -1448,7 +1448,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       pop_back() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: pop_back(1)");
+      { TRACE("deque: pop_back(1)", this);
 	if (this->_M_impl._M_finish._M_cur
 	    != this->_M_impl._M_finish._M_first)
 	  {
@@ -1510,7 +1510,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __position, value_type&& __x)
-      { TRACE("deque: insert: move(4)"); return emplace(__position, std::move(__x)); }
+      { TRACE("deque: insert: move(4)", this, __x); return emplace(__position, std::move(__x)); }
 
       /**
        *  @brief  Inserts an initializer list into the %deque.
@@ -1523,7 +1523,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __p, initializer_list<value_type> __l)
-      { TRACE("deque: insert: ilist(5)"); return this->insert(__p, __l.begin(), __l.end()); }
+      { TRACE("deque: insert: ilist(5)", this); return this->insert(__p, __l.begin(), __l.end()); }
 #endif
 
 #if __cplusplus >= 201103L
@@ -1539,7 +1539,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __position, size_type __n, const value_type& __x)
-      { TRACE("deque: insert: fill(2)");
+      { TRACE("deque: insert: fill(2)", this, __x);
 	difference_type __offset = __position - cbegin();
 	_M_fill_insert(__position._M_const_cast(), __n, __x);
 	return begin() + __offset;
@@ -1576,7 +1576,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
         iterator
         insert(const_iterator __position, _InputIterator __first,
 	       _InputIterator __last)
-        { TRACE("deque: insert: range(3)");
+        { TRACE("deque: insert: range(3)", this);
 	  difference_type __offset = __position - cbegin();
 	  _M_insert_dispatch(__position._M_const_cast(),
 			     __first, __last, __false_type());
@@ -1623,7 +1623,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #else
       erase(iterator __position)
 #endif
-      { TRACE("deque: erase (1a)"); return _M_erase(__position._M_const_cast()); }
+      { TRACE("deque: erase (1a)", this); return _M_erase(__position._M_const_cast()); }
 
       /**
        *  @brief  Remove a range of elements.
@@ -1647,7 +1647,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #else
       erase(iterator __first, iterator __last)
 #endif
-      { TRACE("deque: erase(1b)"); return _M_erase(__first._M_const_cast(), __last._M_const_cast()); }
+      { TRACE("deque: erase(1b)", this); return _M_erase(__first._M_const_cast(), __last._M_const_cast()); }
 
       /**
        *  @brief  Swaps data with another %deque.
@@ -1680,7 +1680,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() _GLIBCXX_NOEXCEPT
-      { TRACE("deque: clear(1)"); _M_erase_at_end(begin()); }
+      { TRACE("deque: clear(1)", this); _M_erase_at_end(begin()); }
 
     protected:
       // Internal constructor functions follow.
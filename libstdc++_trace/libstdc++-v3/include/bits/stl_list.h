@@ -769,7 +769,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: begin (1/2)"); return iterator(this->_M_impl._M_node._M_next); }
+      { TRACE("iterator: begin (1/2)", this); return iterator(this->_M_impl._M_node._M_next); }
 
       /**
        *  Returns a read-only (constant) iterator that points to the
@@ -778,7 +778,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       begin() const _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: begin (2/2)"); return const_iterator(this->_M_impl._M_node._M_next); }
+      { TRACE("iterator: begin (2/2)", this); return const_iterator(this->_M_impl._M_node._M_next); }
 
       /**
        *  Returns a read/write iterator that points one past the last
@@ -787,7 +787,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: end (1/2)"); return iterator(&this->_M_impl._M_node); }
+      { TRACE("iterator: end (1/2)", this); return iterator(&this->_M_impl._M_node); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past
@@ -796,7 +796,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       end() const _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: end (2/2)"); return const_iterator(&this->_M_impl._M_node); }
+      { TRACE("iterator: end (2/2)", this); return const_iterator(&this->_M_impl._M_node); }
 
       /**
        *  Returns a read/write reverse iterator that points to the last
@@ -805,7 +805,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rbegin() _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: rbegin (1/2)"); return reverse_iterator(end()); }
+      { TRACE("iterator: rbegin (1/2)", this); return reverse_iterator(end()); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to
@@ -814,7 +814,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rbegin() const _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: rbegin (2/2)"); return const_reverse_iterator(end()); }
+      { TRACE("iterator: rbegin (2/2)", this); return const_reverse_iterator(end()); }
 
       /**
        *  Returns a read/write reverse iterator that points to one
@@ -823,7 +823,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rend() _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: rend (1/2)"); return reverse_iterator(begin()); }
+      { TRACE("iterator: rend (1/2)", this); return reverse_iterator(begin()); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to one
@@ -832,7 +832,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rend() const _GLIBCXX_NOEXCEPT
-      { TRACE("iterator: rend (2/2)"); return const_reverse_iterator(begin()); }
+      { TRACE("iterator: rend (2/2)", this); return const_reverse_iterator(begin()); }
 
 #if __cplusplus >= 201103L
       /**
@@ -842,7 +842,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cbegin() const noexcept
-      { TRACE("iterator: cbegin (1)"); return const_iterator(this->_M_impl._M_node._M_next); }
+      { TRACE("iterator: cbegin (1)", this); return const_iterator(this->_M_impl._M_node._M_next); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past
@@ -851,7 +851,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cend() const noexcept
-      { TRACE("iterator: cend (1)"); return const_iterator(&this->_M_impl._M_node); }
+      { TRACE("iterator: cend (1)", this); return const_iterator(&this->_M_impl._M_node); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to
@@ -860,7 +860,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crbegin() const noexcept
-      { TRACE("iterator: crbegin (1)"); return const_reverse_iterator(end()); }
+      { TRACE("iterator: crbegin (1)", this); return const_reverse_iterator(end()); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to one
@@ -869,7 +869,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crend() const noexcept
-      { TRACE("iterator: crend (1)"); return const_reverse_iterator(begin()); }
+      { TRACE("iterator: crend (1)", this); return const_reverse_iterator(begin()); }
 #endif
 
       // [23.2.2.2] capacity
@@ -879,12 +879,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       bool
       empty() const _GLIBCXX_NOEXCEPT
-      { TRACE("capacity: empty (1)"); return this->_M_impl._M_node._M_next == &this->_M_impl._M_node; }
+      { TRACE("capacity: empty (1)", this); return this->_M_impl._M_node._M_next == &this->_M_impl._M_node; }
 
       /**  Returns the number of elements in the %list.  */
       size_type
       size() const _GLIBCXX_NOEXCEPT
-      { TRACE("capacity: size (1)"); return std::distance(begin(), end()); }
+      { TRACE("capacity: size (1)", this); return std::distance(begin(), end()); }
 
       /**  Returns the size() of the largest possible %list.  */
       size_type
@@ -938,7 +938,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       front() _GLIBCXX_NOEXCEPT
-      { TRACE("access: front (1/2)"); return *begin(); }
+      { TRACE("access: front (1/2)", this); return *begin(); }
 
       /**
        *  Returns a read-only (constant) reference to the data at the first
@@ -946,7 +946,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       front() const _GLIBCXX_NOEXCEPT
-      { TRACE("access: front (2/2)"); return *begin(); }
+      { TRACE("access: front (2/2)", this); return *begin(); }
 
       /**
        *  Returns a read/write reference to the data at the last element
@@ -954,7 +954,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       back() _GLIBCXX_NOEXCEPT
-      { TRACE("access: back (1/2)");
+      { TRACE("access: back (1/2)", this);
 	iterator __tmp = end();
 	--__tmp;
 	return *__tmp;
@@ -966,7 +966,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       back() const _GLIBCXX_NOEXCEPT
-      { TRACE("access: back (2/2)");
+      { TRACE("access: back (2/2)", this);
 	const_iterator __tmp = end();
 	--__tmp;
 	return *__tmp;
@@ -985,17 +985,17 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       push_front(const value_type& __x)
-      { TRACE("modifiers: push_front (1/2)"); this->_M_insert(begin(), __x); }
+      { TRACE("modifiers: push_front (1/2)", this, __x); this->_M_insert(begin(), __x); }
 
 #if __cplusplus >= 201103L
       void
       push_front(value_type&& __x)
-      { TRACE("modifiers: push_front (2/2)"); this->_M_insert(begin(), std::move(__x)); }
+      { TRACE("modifiers: push_front (2/2)", this, __x); this->_M_insert(begin(), std::move(__x)); }
 
       template<typename... _Args>
         void
         emplace_front(_Args&&... __args)
-        { TRACE("modifiers: emplace_front (1)"); this->_M_insert(begin(), std::forward<_Args>(__args)...); }
+        { TRACE("modifiers: emplace_front (1)", this); this->_M_insert(begin(), std::forward<_Args>(__args)...); }
 #endif
 
       /**
@@ -1012,7 +1012,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       pop_front() _GLIBCXX_NOEXCEPT
-      { TRACE("modifiers: pop_front (1)"); this->_M_erase(begin()); }
+      { TRACE("modifiers: pop_front (1)", this); this->_M_erase(begin()); }
 
       /**
        *  @brief  Add data to the end of the %list.
@@ -1026,17 +1026,17 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       push_back(const value_type& __x)
-      { TRACE("modifiers: push_back (1/2)");this->_M_insert(end(), __x); }
+      { TRACE("modifiers: push_back (1/2)", this, __x);this->_M_insert(end(), __x); }
 
 #if __cplusplus >= 201103L
       void
       push_back(value_type&& __x)
-      { TRACE("modifiers: push_back (2/2)"); this->_M_insert(end(), std::move(__x)); }
+      { TRACE("modifiers: push_back (2/2)", this, __x); this->_M_insert(end(), std::move(__x)); }
 
       template<typename... _Args>
         void
         emplace_back(_Args&&... __args)
-        { TRACE("modifiers: emplace_back (1)");this->_M_insert(end(), std::forward<_Args>(__args)...); }
+        { TRACE("modifiers: emplace_back (1)", this);this->_M_insert(end(), std::forward<_Args>(__args)...); }
 #endif
 
       /**
@@ -1052,7 +1052,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       pop_back() _GLIBCXX_NOEXCEPT
-      { TRACE("modifiers: pop_back (1)"); this->_M_erase(iterator(this->_M_impl._M_node._M_prev)); }
+      { TRACE("modifiers: pop_back (1)", this); this->_M_erase(iterator(this->_M_impl._M_node._M_prev)); }
 
 #if __cplusplus >= 201103L
       /**
@@ -1114,7 +1114,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
         */
       iterator
       insert(const_iterator __position, value_type&& __x)
-      { TRACE("modifiers: insert (2/5)"); return emplace(__position, std::move(__x)); }
+      { TRACE("modifiers: insert (2/5)", this, __x); return emplace(__position, std::move(__x)); }
 
       /**
        *  @brief  Inserts the contents of an initializer_list into %list
@@ -1133,7 +1133,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __p, initializer_list<value_type> __l)
-      { TRACE("modifiers: insert (3/5)"); return this->insert(__p, __l.begin(), __l.end()); }
+      { TRACE("modifiers: insert (3/5)", this); return this->insert(__p, __l.begin(), __l.end()); }
 #endif
 
 #if __cplusplus >= 201103L
@@ -1265,7 +1265,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #else
       erase(iterator __first, iterator __last)
 #endif
-      { TRACE("modifiers: erase (2/2)");
+      { TRACE("modifiers: erase (2/2)", this);
 	while (__first != __last)
 	  __first = erase(__first);
 	return __last._M_const_cast();
@@ -1300,7 +1300,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() _GLIBCXX_NOEXCEPT
-      { TRACE("modifiers: clear (1)");
+      { TRACE("modifiers: clear (1)", this);
         _Base::_M_clear();
         _Base::_M_init();
       }
@@ -1574,7 +1574,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       reverse() _GLIBCXX_NOEXCEPT
-      { TRACE("operations: reverse (1)"); this->_M_impl._M_node._M_reverse(); }
+      { TRACE("operations: reverse (1)", this); this->_M_impl._M_node._M_reverse(); }
 
       /**
        *  @brief  Sort the elements.
@@ -353,7 +353,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() _GLIBCXX_NOEXCEPT
-      { TRACE("map: begin(1a))"); return _M_t.begin(); }
+      { TRACE("map: begin(1a))", this); return _M_t.begin(); }
 
       /**
        *  Returns a read-only (constant) iterator that points to the first pair
@@ -362,7 +362,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       begin() const _GLIBCXX_NOEXCEPT
-      { TRACE("map: begin(1b)"); return _M_t.begin(); }
+      { TRACE("map: begin(1b)", this); return _M_t.begin(); }
 
       /**
        *  Returns a read/write iterator that points one past the last
@@ -371,7 +371,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() _GLIBCXX_NOEXCEPT
-      { TRACE("map: end(1a)"); return _M_t.end(); }
+      { TRACE("map: end(1a)", this); return _M_t.end(); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past the last
@@ -380,7 +380,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       end() const _GLIBCXX_NOEXCEPT
-      { TRACE("map: end(1b)"); return _M_t.end(); }
+      { TRACE("map: end(1b)", this); return _M_t.end(); }
 
       /**
        *  Returns a read/write reverse iterator that points to the last pair in
@@ -389,7 +389,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rbegin() _GLIBCXX_NOEXCEPT
-      { TRACE("map: rbegin(1a)"); return _M_t.rbegin(); }
+      { TRACE("map: rbegin(1a)", this); return _M_t.rbegin(); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to the
@@ -398,7 +398,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rbegin() const _GLIBCXX_NOEXCEPT
-      { TRACE("map: rbegin(1b)"); return _M_t.rbegin(); }
+      { TRACE("map: rbegin(1b)", this); return _M_t.rbegin(); }
 
       /**
        *  Returns a read/write reverse iterator that points to one before the
@@ -407,7 +407,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rend() _GLIBCXX_NOEXCEPT
-      { TRACE("map: rend(1a)"); return _M_t.rend(); }
+      { TRACE("map: rend(1a)", this); return _M_t.rend(); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to one
@@ -416,7 +416,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rend() const _GLIBCXX_NOEXCEPT
-      { TRACE("map: rend(1b)"); return _M_t.rend(); }
+      { TRACE("map: rend(1b)", this); return _M_t.rend(); }
 
 #if __cplusplus >= 201103L
       /**
@@ -426,7 +426,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cbegin() const noexcept
-      { TRACE("map: cbegin(1)"); return _M_t.begin(); }
+      { TRACE("map: cbegin(1)", this); return _M_t.begin(); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past the last
@@ -435,7 +435,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cend() const noexcept
-      { TRACE("map: cend(1)"); return _M_t.end(); }
+      { TRACE("map: cend(1)", this); return _M_t.end(); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to the
@@ -444,7 +444,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crbegin() const noexcept
-      { TRACE("map: crbegin(1)"); return _M_t.rbegin(); }
+      { TRACE("map: crbegin(1)", this); return _M_t.rbegin(); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points to one
@@ -453,7 +453,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crend() const noexcept
-      { TRACE("map: crend(1)"); return _M_t.rend(); }
+      { TRACE("map: crend(1)", this); return _M_t.rend(); }
 #endif
 
       // capacity
@@ -462,12 +462,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       */
       bool
       empty() const _GLIBCXX_NOEXCEPT
-      { TRACE("map: empty(1)"); return _M_t.empty(); }
+      { TRACE("map: empty(1)", this); return _M_t.empty(); }
 
       /** Returns the size of the %map.  */
       size_type
       size() const _GLIBCXX_NOEXCEPT
-      { TRACE("map: size(1)"); return _M_t.size(); }
+      { TRACE("map: size(1)", this); return _M_t.size(); }
 
       /** Returns the maximum size of the %map.  */
       size_type
@@ -489,7 +489,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       mapped_type&
       operator[](const key_type& __k)
-      { TRACE("map: operator[] (1a)"); 
+      { TRACE("map: operator[] (1a)", this, __k); 
 	// concept requirements
 	__glibcxx_function_requires(_DefaultConstructibleConcept<mapped_type>)
 
@@ -509,7 +509,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #if __cplusplus >= 201103L
       mapped_type&
       operator[](key_type&& __k)
-      { TRACE("map: operator[](1b)"); 
+      { TRACE("map: operator[](1b)", this, __k); 
 	// concept requirements
 	__glibcxx_function_requires(_DefaultConstructibleConcept<mapped_type>)
 
@@ -534,7 +534,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       mapped_type&
       at(const key_type& __k)
-      { TRACE("map: at(1a)"); 
+      { TRACE("map: at(1a)", this, __k); 
 	iterator __i = lower_bound(__k);
 	if (__i == end() || key_comp()(__k, (*__i).first))
 	  __throw_out_of_range(__N("map::at"));
@@ -543,7 +543,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 
       const mapped_type&
       at(const key_type& __k) const
-      { TRACE("map: at(1b)"); 
+      { TRACE("map: at(1b)", this, __k); 
 	const_iterator __i = lower_bound(__k);
 	if (__i == end() || key_comp()(__k, (*__i).first))
 	  __throw_out_of_range(__N("map::at"));
@@ -573,7 +573,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	std::pair<iterator, bool>
 	emplace(_Args&&... __args)
-	{ TRACE("map: emplace(1)"); return _M_t._M_emplace_unique(std::forward<_Args>(__args)...); }
+	{ TRACE("map: emplace(1)", this); return _M_t._M_emplace_unique(std::forward<_Args>(__args)...); }
 
       /**
        *  @brief Attempts to build and insert a std::pair into the %map.
@@ -603,7 +603,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	iterator
 	emplace_hint(const_iterator __pos, _Args&&... __args)
-	{ TRACE("map: emplace_hint(1)"); 
+	{ TRACE("map: emplace_hint(1)", this); 
 	  return _M_t._M_emplace_hint_unique(__pos,
 					     std::forward<_Args>(__args)...);
 	}
@@ -627,7 +627,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       std::pair<iterator, bool>
       insert(const value_type& __x)
-      { TRACE("map: insert(1a)"); return _M_t._M_insert_unique(__x); }
+      { TRACE("map: insert(1a)", this, __x); return _M_t._M_insert_unique(__x); }
 
 #if __cplusplus >= 201103L
       template<typename _Pair, typename = typename
@@ -635,7 +635,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 						    _Pair&&>::value>::type>
         std::pair<iterator, bool>
         insert(_Pair&& __x)
-        { TRACE("map: insert(1b)"); return _M_t._M_insert_unique(std::forward<_Pair>(__x)); }
+        { TRACE("map: insert(1b)", this, __x); return _M_t._M_insert_unique(std::forward<_Pair>(__x)); }
 #endif
 
 #if __cplusplus >= 201103L
@@ -648,7 +648,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       insert(std::initializer_list<value_type> __list)
-      { TRACE("map: insert(4)"); insert(__list.begin(), __list.end()); }
+      { TRACE("map: insert(4)", this); insert(__list.begin(), __list.end()); }
 #endif
 
       /**
@@ -680,7 +680,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #else
       insert(iterator __position, const value_type& __x)
 #endif
-      { TRACE("map: insert(2a)"); return _M_t._M_insert_unique_(__position, __x); }
+      { TRACE("map: insert(2a)", this, __x); return _M_t._M_insert_unique_(__position, __x); }
 
 #if __cplusplus >= 201103L
       template<typename _Pair, typename = typename
@@ -688,7 +688,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 						    _Pair&&>::value>::type>
         iterator
         insert(const_iterator __position, _Pair&& __x)
-        { TRACE("map: insert(2b)"); return _M_t._M_insert_unique_(__position,
+        { TRACE("map: insert(2b)", this, __x); return _M_t._M_insert_unique_(__position,
 					std::forward<_Pair>(__x)); }
 #endif
 
@@ -703,7 +703,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename _InputIterator>
         void
         insert(_InputIterator __first, _InputIterator __last)
-        { TRACE("map: insert(3)"); _M_t._M_insert_unique(__first, __last); }
+        { TRACE("map: insert(3)", this); _M_t._M_insert_unique(__first, __last); }
 
 #if __cplusplus >= 201103L
       // _GLIBCXX_RESOLVE_LIB_DEFECTS
@@ -723,13 +723,13 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __position)
-      { TRACE("map: erase(1a)"); return _M_t.erase(__position); }
+      { TRACE("map: erase(1a)", this); return _M_t.erase(__position); }
 
       // LWG 2059
       _GLIBCXX_ABI_TAG_CXX11
       iterator
       erase(iterator __position)
-      { TRACE("map: erase(1b)"); return _M_t.erase(__position); }
+      { TRACE("map: erase(1b)", this); return _M_t.erase(__position); }
 #else
       /**
        *  @brief Erases an element from a %map.
@@ -759,7 +759,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       erase(const key_type& __x)
-      { TRACE("map: erase(2)"); return _M_t.erase(__x); }
+      { TRACE("map: erase(2)", this, __x); return _M_t.erase(__x); }
 
 #if __cplusplus >= 201103L
       // _GLIBCXX_RESOLVE_LIB_DEFECTS
@@ -779,7 +779,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __first, const_iterator __last)
-      { TRACE("map: erase(3)"); return _M_t.erase(__first, __last); }
+      { TRACE("map: erase(3)", this); return _M_t.erase(__first, __last); }
 #else
       /**
        *  @brief Erases a [__first,__last) range of elements from a %map.
@@ -824,7 +824,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() _GLIBCXX_NOEXCEPT
-      { TRACE("map: clear(1)"); _M_t.clear(); }
+      { TRACE("map: clear(1)", this); _M_t.clear(); }
 
       // observers
       /**
@@ -857,7 +857,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       find(const key_type& __x)
-      { TRACE("map: find(1a)"); return _M_t.find(__x); }
+      { TRACE("map: find(1a)", this, __x); return _M_t.find(__x); }
 
       /**
        *  @brief Tries to locate an element in a %map.
@@ -872,7 +872,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       find(const key_type& __x) const
-      { TRACE("map: find(1b)"); return _M_t.find(__x); }
+      { TRACE("map: find(1b)", this, __x); return _M_t.find(__x); }
 
       /**
        *  @brief  Finds the number of elements with given key.
@@ -884,7 +884,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       count(const key_type& __x) const
-      { TRACE("map: count(1)"); return _M_t.find(__x) == _M_t.end() ? 0 : 1; }
+      { TRACE("map: count(1)", this, __x); return _M_t.find(__x) == _M_t.end() ? 0 : 1; }
 
       /**
        *  @brief Finds the beginning of a subsequence matching given key.
@@ -547,7 +547,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() _GLIBCXX_NOEXCEPT
-      { TRACE("vector: begin: (1a)");return iterator(this->_M_impl._M_start); }
+      { TRACE("vector: begin: (1a)", this);return iterator(this->_M_impl._M_start); }
 
       /**
        *  Returns a read-only (constant) iterator that points to the
@@ -556,7 +556,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       begin() const _GLIBCXX_NOEXCEPT
-      { TRACE("vector: begin: (1b)");return const_iterator(this->_M_impl._M_start); }
+      { TRACE("vector: begin: (1b)", this);return const_iterator(this->_M_impl._M_start); }
 
       /**
        *  Returns a read/write iterator that points one past the last
@@ -565,7 +565,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() _GLIBCXX_NOEXCEPT
-      { TRACE("vector: end: (1a)");return iterator(this->_M_impl._M_finish); }
+      { TRACE("vector: end: (1a)", this);return iterator(this->_M_impl._M_finish); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past
@@ -574,7 +574,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       end() const _GLIBCXX_NOEXCEPT
-      { TRACE("vector: end: (1b)");return const_iterator(this->_M_impl._M_finish); }
+      { TRACE("vector: end: (1b)", this);return const_iterator(this->_M_impl._M_finish); }
 
       /**
        *  Returns a read/write reverse iterator that points to the
@@ -583,7 +583,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rbegin() _GLIBCXX_NOEXCEPT
-      { TRACE("vector: rbegin: (1a)");return reverse_iterator(end()); }
+      { TRACE("vector: rbegin: (1a)", this);return reverse_iterator(end()); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -592,7 +592,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rbegin() const _GLIBCXX_NOEXCEPT
-      { TRACE("vector: rbegin: (1b)");return const_reverse_iterator(end()); }
+      { TRACE("vector: rbegin: (1b)", this);return const_reverse_iterator(end()); }
 
       /**
        *  Returns a read/write reverse iterator that points to one
@@ -601,7 +601,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reverse_iterator
       rend() _GLIBCXX_NOEXCEPT
-      { TRACE("vector: rend: (1a)");return reverse_iterator(begin()); }
+      { TRACE("vector: rend: (1a)", this);return reverse_iterator(begin()); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -610,7 +610,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       rend() const _GLIBCXX_NOEXCEPT
-      { TRACE("vector: rend: (1b)");return const_reverse_iterator(begin()); }
+      { TRACE("vector: rend: (1b)", this);return const_reverse_iterator(begin()); }
 
 #if __cplusplus >= 201103L
       /**
@@ -620,7 +620,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cbegin() const noexcept
-      { TRACE("vector: cbegin: (1)");return const_iterator(this->_M_impl._M_start); }
+      { TRACE("vector: cbegin: (1)", this);return const_iterator(this->_M_impl._M_start); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past
@@ -629,7 +629,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cend() const noexcept
-      { TRACE("vector: cend: (1)");return const_iterator(this->_M_impl._M_finish); }
+      { TRACE("vector: cend: (1)", this);return const_iterator(this->_M_impl._M_finish); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -638,7 +638,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crbegin() const noexcept
-      { TRACE("vector: crbegin: (1)");return const_reverse_iterator(end()); }
+      { TRACE("vector: crbegin: (1)", this);return const_reverse_iterator(end()); }
 
       /**
        *  Returns a read-only (constant) reverse iterator that points
@@ -647,14 +647,14 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reverse_iterator
       crend() const noexcept
-      { TRACE("vector: crend: (1)");return const_reverse_iterator(begin()); }
+      { TRACE("vector: crend: (1)", this);return const_reverse_iterator(begin()); }
 #endif
 
       // [23.2.4.2] capacity
       /**  Returns the number of elements in the %vector.  */
       size_type
       size() const _GLIBCXX_NOEXCEPT
-      { TRACE("vector: size: (1)");return size_type(this->_M_impl._M_finish - this->_M_impl._M_start); }
+      { TRACE("vector: size: (1)", this);return size_type(this->_M_impl._M_finish - this->_M_impl._M_start); }
 
       /**  Returns the size() of the largest possible %vector.  */
       size_type
@@ -674,7 +674,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       void
       resize(size_type __new_size)
       {
-	TRACE("vector: resize: (1a)");
+	TRACE("vector: resize: (1a)", this, __new_size);
 	if (__new_size > size())
 	  _M_default_append(__new_size - size());
 	else if (__new_size < size())
@@ -694,7 +694,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       resize(size_type __new_size, const value_type& __x)
-      {TRACE("vector: resize: (1b)");
+      {TRACE("vector: resize: (1b)", this, __new_size);
 	if (__new_size > size())
 	  insert(end(), __new_size - size(), __x);
 	else if (__new_size < size())
@@ -744,7 +744,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       bool
       empty() const _GLIBCXX_NOEXCEPT
-      { TRACE("vector: empty: (1)");return begin() == end(); }
+      { TRACE("vector: empty: (1)", this);return begin() == end(); }
 
       /**
        *  @brief  Attempt to preallocate enough memory for specified number of
@@ -824,7 +824,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       reference
       at(size_type __n)
       {
-	TRACE("vector: at: (1a)");
+	TRACE("vector: at: (1a)", this, __n);
 	_M_range_check(__n);
 	return (*this)[__n]; 
       }
@@ -843,7 +843,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       const_reference
       at(size_type __n) const
       {
-	TRACE("vector: at: (1b)");
+	TRACE("vector: at: (1b)", this, __n);
 	_M_range_check(__n);
 	return (*this)[__n];
       }
@@ -854,7 +854,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       front() _GLIBCXX_NOEXCEPT
-      { TRACE("vector: front: (1a)"); return *begin(); }
+      { TRACE("vector: front: (1a)", this); return *begin(); }
 
       /**
        *  Returns a read-only (constant) reference to the data at the first
@@ -862,7 +862,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       front() const _GLIBCXX_NOEXCEPT
-      {TRACE("vector: front: (1b)"); return *begin(); }
+      {TRACE("vector: front: (1b)", this); return *begin(); }
 
       /**
        *  Returns a read/write reference to the data at the last
@@ -870,7 +870,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       reference
       back() _GLIBCXX_NOEXCEPT
-      {TRACE("vector: back: (1a)"); return *(end() - 1); }
+      {TRACE("vector: back: (1a)", this); return *(end() - 1); }
       
       /**
        *  Returns a read-only (constant) reference to the data at the
@@ -878,7 +878,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_reference
       back() const _GLIBCXX_NOEXCEPT
-      {TRACE("vector: back: (1b)"); return *(end() - 1); }
+      {TRACE("vector: back: (1b)", this); return *(end() - 1); }
 
       // _GLIBCXX_RESOLVE_LIB_DEFECTS
       // DR 464. Suggestion for new member functions in standard containers.
@@ -916,7 +916,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       push_back(const value_type& __x)
-      {TRACE("vector: push_back: (1a)");
+      {TRACE("vector: push_back: (1a)", this, __x);
 	if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage)
 	  {
 	    _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish,
@@ -934,7 +934,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #if __cplusplus >= 201103L
       void
       push_back(value_type&& __x)
-      {TRACE("vector: push_back: (1b)"); emplace_back(std::move(__x)); }
+      {TRACE("vector: push_back: (1b)", this, __x); emplace_back(std::move(__x)); }
 
       template<typename... _Args>
         void
@@ -952,7 +952,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       pop_back() _GLIBCXX_NOEXCEPT
-      {TRACE("vector: pop_back: (1)");
+      {TRACE("vector: pop_back: (1)", this);
 	--this->_M_impl._M_finish;
 	_Alloc_traits::destroy(this->_M_impl, this->_M_impl._M_finish);
       }
@@ -1017,7 +1017,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __position, value_type&& __x)
-      {TRACE("vector: insert: move(4)"); return emplace(__position, std::move(__x)); }
+      {TRACE("vector: insert: move(4)", this, __x); return emplace(__position, std::move(__x)); }
 
       /**
        *  @brief  Inserts an initializer_list into the %vector.
@@ -1034,7 +1034,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __position, initializer_list<value_type> __l)
-      {TRACE("vector: insert: initList(5)"); return this->insert(__position, __l.begin(), __l.end()); }
+      {TRACE("vector: insert: initList(5)", this); return this->insert(__position, __l.begin(), __l.end()); }
 #endif
 
 #if __cplusplus >= 201103L
@@ -1054,7 +1054,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __position, size_type __n, const value_type& __x)
-      {TRACE("vector: insert: fill(2)");
+      {TRACE("vector: insert: fill(2)", this, __x);
 	difference_type __offset = __position - cbegin();
 	_M_fill_insert(begin() + __offset, __n, __x);
 	return begin() + __offset;
@@ -1099,7 +1099,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
         iterator
         insert(const_iterator __position, _InputIterator __first,
 	       _InputIterator __last)
-      {TRACE("vector: insert: range(3)");
+      {TRACE("vector: insert: range(3)", this);
 	  difference_type __offset = __position - cbegin();
 	  _M_insert_dispatch(begin() + __offset,
 			     __first, __last, __false_type());
@@ -1149,7 +1149,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       iterator
 #if __cplusplus >= 201103L
       erase(const_iterator __position)
-      {TRACE("vector: erase: (1a)"); return _M_erase(begin() + (__position - cbegin())); }
+      {TRACE("vector: erase: (1a)", this); return _M_erase(begin() + (__position - cbegin())); }
 #else
       erase(iterator __position)
       { return _M_erase(__position); }
@@ -1176,7 +1176,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       iterator
 #if __cplusplus >= 201103L
       erase(const_iterator __first, const_iterator __last)
-      {TRACE("vector: erase: (1b)");
+      {TRACE("vector: erase: (1b)", this);
 	const auto __beg = begin();
 	const auto __cbeg = cbegin();
 	return _M_erase(__beg + (__first - __cbeg), __beg + (__last - __cbeg));
@@ -1214,7 +1214,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() _GLIBCXX_NOEXCEPT
-      {TRACE("vector: clear: (1)"); _M_erase_at_end(this->_M_impl._M_start); }
+      {TRACE("vector: clear: (1)", this); _M_erase_at_end(this->_M_impl._M_start); }
 
     protected:
       /**
@@ -256,12 +256,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       ///  Returns true if the %unordered_map is empty.
       bool
       empty() const noexcept
-      { TRACE("unordered_map: empty(1)"); return _M_h.empty(); }
+      { TRACE("unordered_map: empty(1)", this); return _M_h.empty(); }
 
       ///  Returns the size of the %unordered_map.
       size_type
       size() const noexcept
-      { TRACE("unordered_map: size(1)"); return _M_h.size(); }
+      { TRACE("unordered_map: size(1)", this); return _M_h.size(); }
 
       ///  Returns the maximum size of the %unordered_map.
       size_type
@@ -276,7 +276,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() noexcept
-      { TRACE("unordered_map: begin(1a)"); return _M_h.begin(); }
+      { TRACE("unordered_map: begin(1a)", this); return _M_h.begin(); }
 
       //@{
       /**
@@ -285,11 +285,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       begin() const noexcept
-      { TRACE("unordered_map: begin(1b)"); return _M_h.begin(); }
+      { TRACE("unordered_map: begin(1b)", this); return _M_h.begin(); }
 
       const_iterator
       cbegin() const noexcept
-      { TRACE("unordered_map: cbegin(1)"); return _M_h.begin(); }
+      { TRACE("unordered_map: cbegin(1)", this); return _M_h.begin(); }
       //@}
 
       /**
@@ -298,7 +298,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() noexcept
-      { TRACE("unordered_map: end(1a)"); return _M_h.end(); }
+      { TRACE("unordered_map: end(1a)", this); return _M_h.end(); }
 
       //@{
       /**
@@ -307,11 +307,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       end() const noexcept
-      { TRACE("unordered_map: end(1b)"); return _M_h.end(); }
+      { TRACE("unordered_map: end(1b)", this); return _M_h.end(); }
 
       const_iterator
       cend() const noexcept
-      { TRACE("unordered_map: cend(1)"); return _M_h.end(); }
+      { TRACE("unordered_map: cend(1)", this); return _M_h.end(); }
       //@}
 
       // modifiers.
@@ -338,7 +338,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	std::pair<iterator, bool>
 	emplace(_Args&&... __args)
-	{ TRACE("unordered_map: emplace(1)"); return _M_h.emplace(std::forward<_Args>(__args)...); }
+	{ TRACE("unordered_map: emplace(1)", this); return _M_h.emplace(std::forward<_Args>(__args)...); }
 
       /**
        *  @brief Attempts to build and insert a std::pair into the %unordered_map.
@@ -368,7 +368,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	iterator
 	emplace_hint(const_iterator __pos, _Args&&... __args)
-	{ TRACE("unordered_map: emplace_hint(1)"); return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
+	{ TRACE("unordered_map: emplace_hint(1)", this); return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
 
       //@{
       /**
@@ -390,14 +390,14 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       std::pair<iterator, bool>
       insert(const value_type& __x)
-      { TRACE("unordered_map: insert(1)"); return _M_h.insert(__x); }
+      { TRACE("unordered_map: insert(1)", this, __x); return _M_h.insert(__x); }
 
       template<typename _Pair, typename = typename
 	       std::enable_if<std::is_constructible<value_type,
 						    _Pair&&>::value>::type>
 	std::pair<iterator, bool>
 	insert(_Pair&& __x)
-        { TRACE("unordered_map: insert(2)"); return _M_h.insert(std::forward<_Pair>(__x)); }
+        { TRACE("unordered_map: insert(2)", this, __x); return _M_h.insert(std::forward<_Pair>(__x)); }
       //@}
 
       //@{
@@ -424,14 +424,14 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __hint, const value_type& __x)
-      { TRACE("unordered_map: insert(3)"); return _M_h.insert(__hint, __x); }
+      { TRACE("unordered_map: insert(3)", this, __x); return _M_h.insert(__hint, __x); }
 
       template<typename _Pair, typename = typename
 	       std::enable_if<std::is_constructible<value_type,
 						    _Pair&&>::value>::type>
 	iterator
 	insert(const_iterator __hint, _Pair&& __x)
-	{ TRACE("unordered_map: insert(4)"); return _M_h.insert(__hint, std::forward<_Pair>(__x)); }
+	{ TRACE("unordered_map: insert(4)", this, __x); return _M_h.insert(__hint, std::forward<_Pair>(__x)); }
       //@}
 
       /**
@@ -446,7 +446,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename _InputIterator>
 	void
 	insert(_InputIterator __first, _InputIterator __last)
-	{ TRACE("unordered_map: insert(5)"); _M_h.insert(__first, __last); }
+	{ TRACE("unordered_map: insert(5)", this); _M_h.insert(__first, __last); }
 
       /**
        *  @brief Attempts to insert a list of elements into the %unordered_map.
@@ -457,7 +457,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       insert(initializer_list<value_type> __l)
-      { TRACE("unordered_map: insert(6)"); _M_h.insert(__l); }
+      { TRACE("unordered_map: insert(6)", this); _M_h.insert(__l); }
 
       //@{
       /**
@@ -475,12 +475,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __position)
-      { TRACE("unordered_map: erase(1a)"); return _M_h.erase(__position); }
+      { TRACE("unordered_map: erase(1a)", this); return _M_h.erase(__position); }
 
       // LWG 2059.
       iterator
       erase(iterator __position)
-      { TRACE("unordered_map: erase(1b)"); return _M_h.erase(__position); }
+      { TRACE("unordered_map: erase(1b)", this); return _M_h.erase(__position); }
       //@}
 
       /**
@@ -497,7 +497,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       erase(const key_type& __x)
-      { TRACE("unordered_map: erase(2)"); return _M_h.erase(__x); }
+      { TRACE("unordered_map: erase(2)", this, __x); return _M_h.erase(__x); }
 
       /**
        *  @brief Erases a [__first,__last) range of elements from an
@@ -515,7 +515,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __first, const_iterator __last)
-      { TRACE("unordered_map: erase(3)"); return _M_h.erase(__first, __last); }
+      { TRACE("unordered_map: erase(3)", this); return _M_h.erase(__first, __last); }
 
       /**
        *  Erases all elements in an %unordered_map.
@@ -525,7 +525,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() noexcept
-      { TRACE("unordered_map: clear(1)"); _M_h.clear(); }
+      { TRACE("unordered_map: clear(1)", this); _M_h.clear(); }
 
       /**
        *  @brief  Swaps data with another %unordered_map.
@@ -571,11 +571,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       find(const key_type& __x)
-      { TRACE("unordered_map: find(1)"); return _M_h.find(__x); }
+      { TRACE("unordered_map: find(1)", this, __x); return _M_h.find(__x); }
 
       const_iterator
       find(const key_type& __x) const
-      { TRACE("unordered_map: find(2)"); return _M_h.find(__x); }
+      { TRACE("unordered_map: find(2)", this, __x); return _M_h.find(__x); }
       //@}
 
       /**
@@ -589,7 +589,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       count(const key_type& __x) const
-      { TRACE("unordered_map: count(1)"); return _M_h.count(__x); }
+      { TRACE("unordered_map: count(1)", this, __x); return _M_h.count(__x); }
 
       //@{
       /**
@@ -624,11 +624,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       mapped_type&
       operator[](const key_type& __k)
-      { TRACE("unordered_map: operator[](1)"); return _M_h[__k]; }
+      { TRACE("unordered_map: operator[](1)", this, __k); return _M_h[__k]; }
 
       mapped_type&
       operator[](key_type&& __k)
-      { TRACE("unordered_map: operator[](2)"); return _M_h[std::move(__k)]; }
+      { TRACE("unordered_map: operator[](2)", this, __k); return _M_h[std::move(__k)]; }
       //@}
 
       //@{
@@ -641,11 +641,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       mapped_type&
       at(const key_type& __k)
-      { TRACE("unordered_map: at(1)"); return _M_h.at(__k); }
+      { TRACE("unordered_map: at(1)", this, __k); return _M_h.at(__k); }
 
       const mapped_type&
       at(const key_type& __k) const
-      { TRACE("unordered_map: at(2)"); return _M_h.at(__k); }
+      { TRACE("unordered_map: at(2)", this, __k); return _M_h.at(__k); }
       //@}
 
       // bucket interface.
@@ -676,7 +676,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       bucket(const key_type& __key) const
-      { return TRACE("unordered_map: bucket(1)"); _M_h.bucket(__key); }
+      { TRACE("unordered_map: bucket(1)"); return _M_h.bucket(__key); }
       
       /**
        *  @brief  Returns a read/write iterator pointing to the first bucket
@@ -686,7 +686,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       local_iterator
       begin(size_type __n)
-      { TRACE("unordered_map: begin(2a)"); return _M_h.begin(__n); }
+      { TRACE("unordered_map: begin(2a)", this, __n); return _M_h.begin(__n); }
 
       //@{
       /**
@@ -697,11 +697,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_local_iterator
       begin(size_type __n) const
-      { TRACE("unordered_map: begin(2b)"); return _M_h.begin(__n); }
+      { TRACE("unordered_map: begin(2b)", this, __n); return _M_h.begin(__n); }
 
       const_local_iterator
       cbegin(size_type __n) const
-      { TRACE("unordered_map: cbegin(2)"); return _M_h.cbegin(__n); }
+      { TRACE("unordered_map: cbegin(2)", this, __n); return _M_h.cbegin(__n); }
       //@}
 
       /**
@@ -712,7 +712,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       local_iterator
       end(size_type __n)
-      { TRACE("unordered_map: end(2a)"); return _M_h.end(__n); }
+      { TRACE("unordered_map: end(2a)", this, __n); return _M_h.end(__n); }
 
       //@{
       /**
@@ -723,11 +723,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_local_iterator
       end(size_type __n) const
-      { TRACE("unordered_map: end(2b)"); _M_h.end(__n); }
+      { TRACE("unordered_map: end(2b)", this, __n); _M_h.end(__n); }
 
       const_local_iterator
       cend(size_type __n) const
-      { TRACE("unordered_map: cend(2)"); return _M_h.cend(__n); }
+      { TRACE("unordered_map: cend(2)", this, __n); return _M_h.cend(__n); }
       //@}
 
       // hash policy.
@@ -249,12 +249,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       ///  Returns true if the %unordered_set is empty.
       bool
       empty() const noexcept
-      { TRACE("unordered_set: empty: (1)"); return _M_h.empty(); }
+      { TRACE("unordered_set: empty: (1)", this); return _M_h.empty(); }
 
       ///  Returns the size of the %unordered_set.
       size_type
       size() const noexcept
-      { TRACE("unordered_set: size: (1)"); return _M_h.size(); }
+      { TRACE("unordered_set: size: (1)", this); return _M_h.size(); }
 
       ///  Returns the maximum size of the %unordered_set.
       size_type
@@ -270,11 +270,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() noexcept
-      { TRACE("unordered_set: begin: container iterator(1a)"); return _M_h.begin(); }
+      { TRACE("unordered_set: begin: container iterator(1a)", this); return _M_h.begin(); }
 
       const_iterator
       begin() const noexcept
-      { TRACE("unordered_set: begin: container iterator(1b)"); return _M_h.begin(); }
+      { TRACE("unordered_set: begin: container iterator(1b)", this); return _M_h.begin(); }
       //@}
 
       //@{
@@ -284,11 +284,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() noexcept
-      { TRACE("unordered_set: end: container iterator(1a)"); return _M_h.end(); }
+      { TRACE("unordered_set: end: container iterator(1a)", this); return _M_h.end(); }
 
       const_iterator
       end() const noexcept
-      { TRACE("unordered_set: end: container iterator(1b)"); return _M_h.end(); }
+      { TRACE("unordered_set: end: container iterator(1b)", this); return _M_h.end(); }
       //@}
 
       /**
@@ -297,7 +297,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cbegin() const noexcept
-      { TRACE("unordered_set: cbegin: container iterator(1)"); return _M_h.begin(); }
+      { TRACE("unordered_set: cbegin: container iterator(1)", this); return _M_h.begin(); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past the last
@@ -305,7 +305,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cend() const noexcept
-      { TRACE("unordered_set: cend: container iterator(1)"); return _M_h.end(); }
+      { TRACE("unordered_set: cend: container iterator(1)", this); return _M_h.end(); }
 
       // modifiers.
 
@@ -327,7 +327,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	std::pair<iterator, bool>
 	emplace(_Args&&... __args)
-	{TRACE("unordered_set: emplace: (1)");  return _M_h.emplace(std::forward<_Args>(__args)...); }
+	{TRACE("unordered_set: emplace: (1)", this);  return _M_h.emplace(std::forward<_Args>(__args)...); }
 
       /**
        *  @brief Attempts to insert an element into the %unordered_set.
@@ -353,7 +353,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	iterator
 	emplace_hint(const_iterator __pos, _Args&&... __args)
-	{ TRACE("unordered_set: emplace_hint: (1)"); return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
+	{ TRACE("unordered_set: emplace_hint: (1)", this); return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
 
       //@{
       /**
@@ -371,11 +371,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       std::pair<iterator, bool>
       insert(const value_type& __x)
-      { TRACE("unordered_set: insert: (1)"); return _M_h.insert(__x); }
+      { TRACE("unordered_set: insert: (1)", this, __x); return _M_h.insert(__x); }
 
       std::pair<iterator, bool>
       insert(value_type&& __x)
-      { TRACE("unordered_set: insert: (2)"); return _M_h.insert(std::move(__x)); }
+      { TRACE("unordered_set: insert: (2)", this, __x); return _M_h.insert(std::move(__x)); }
       //@}
 
       //@{
@@ -400,11 +400,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __hint, const value_type& __x)
-      { TRACE("unordered_set: insert: (3)"); return _M_h.insert(__hint, __x); }
+      { TRACE("unordered_set: insert: (3)", this, __x); return _M_h.insert(__hint, __x); }
 
       iterator
       insert(const_iterator __hint, value_type&& __x)
-      { TRACE("unordered_set: insert: (4)"); return _M_h.insert(__hint, std::move(__x)); }
+      { TRACE("unordered_set: insert: (4)", this, __x); return _M_h.insert(__hint, std::move(__x)); }
       //@}
 
       /**
@@ -419,7 +419,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename _InputIterator>
 	void
 	insert(_InputIterator __first, _InputIterator __last)
-	{ TRACE("unordered_set: insert: (5)"); _M_h.insert(__first, __last); }
+	{ TRACE("unordered_set: insert: (5)", this); _M_h.insert(__first, __last); }
 
       /**
        *  @brief Attempts to insert a list of elements into the %unordered_set.
@@ -430,7 +430,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       insert(initializer_list<value_type> __l)
-      { TRACE("unordered_set: insert: (6)"); _M_h.insert(__l); }
+      { TRACE("unordered_set: insert: (6)", this); _M_h.insert(__l); }
 
       //@{
       /**
@@ -448,12 +448,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __position)
-      { TRACE("unordered_set: erase: by position(1a)"); return _M_h.erase(__position); }
+      { TRACE("unordered_set: erase: by position(1a)", this); return _M_h.erase(__position); }
 
       // LWG 2059.
       iterator
       erase(iterator __position)
-      { TRACE("unordered_set: erase: by position(1b)"); return _M_h.erase(__position); }
+      { TRACE("unordered_set: erase: by position(1b)", this); return _M_h.erase(__position); }
       //@}
 
       /**
@@ -470,7 +470,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       erase(const key_type& __x)
-      { TRACE("unordered_set: erase: by key(2)"); return _M_h.erase(__x); }
+      { TRACE("unordered_set: erase: by key(2)", this, __x); return _M_h.erase(__x); }
 
       /**
        *  @brief Erases a [__first,__last) range of elements from an
@@ -488,7 +488,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __first, const_iterator __last)
-      { TRACE("unordered_set: erase: range(3)"); return _M_h.erase(__first, __last); }
+      { TRACE("unordered_set: erase: range(3)", this); return _M_h.erase(__first, __last); }
 
       /**
        *  Erases all elements in an %unordered_set. Note that this function only
@@ -498,7 +498,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() noexcept
-      { TRACE("unordered_set: clear: (1)"); _M_h.clear(); }
+      { TRACE("unordered_set: clear: (1)", this); _M_h.clear(); }
 
       /**
        *  @brief  Swaps data with another %unordered_set.
@@ -544,11 +544,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       find(const key_type& __x)
-      { TRACE("unordered_set: find: (1a)"); return _M_h.find(__x); }
+      { TRACE("unordered_set: find: (1a)", this, __x); return _M_h.find(__x); }
 
       const_iterator
       find(const key_type& __x) const
-      { TRACE("unordered_set: find: (1b)"); return _M_h.find(__x); }
+      { TRACE("unordered_set: find: (1b)", this, __x); return _M_h.find(__x); }
       //@}
 
       /**
@@ -562,7 +562,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       count(const key_type& __x) const
-      { TRACE("unordered_set: count: (1)"); return _M_h.count(__x); }
+      { TRACE("unordered_set: count: (1)", this, __x); return _M_h.count(__x); }
 
       //@{
       /**
@@ -884,12 +884,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       ///  Returns true if the %unordered_multiset is empty.
       bool
       empty() const noexcept
-      { TRACE("unordered_multiset: empty(1)"); return _M_h.empty(); }
+      { TRACE("unordered_multiset: empty(1)", this); return _M_h.empty(); }
 
       ///  Returns the size of the %unordered_multiset.
       size_type
       size() const noexcept
-      { TRACE("unordered_multiset: size(1)"); return _M_h.size(); }
+      { TRACE("unordered_multiset: size(1)", this); return _M_h.size(); }
 
       ///  Returns the maximum size of the %unordered_multiset.
       size_type
@@ -905,11 +905,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       begin() noexcept
-      { TRACE("unordered_multiset: begin(1a)"); return _M_h.begin(); }
+      { TRACE("unordered_multiset: begin(1a)", this); return _M_h.begin(); }
 
       const_iterator
       begin() const noexcept
-      { TRACE("unordered_multiset: begin(1b)"); return _M_h.begin(); }
+      { TRACE("unordered_multiset: begin(1b)", this); return _M_h.begin(); }
       //@}
 
       //@{
@@ -919,11 +919,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       end() noexcept
-      { TRACE("unordered_multiset: end(1a)"); return _M_h.end(); }
+      { TRACE("unordered_multiset: end(1a)", this); return _M_h.end(); }
 
       const_iterator
       end() const noexcept
-      { TRACE("unordered_multiset: end(1b)"); return _M_h.end(); }
+      { TRACE("unordered_multiset: end(1b)", this); return _M_h.end(); }
       //@}
 
       /**
@@ -932,7 +932,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cbegin() const noexcept
-      { TRACE("unordered_multiset: cbegin(1)"); return _M_h.begin(); }
+      { TRACE("unordered_multiset: cbegin(1)", this); return _M_h.begin(); }
 
       /**
        *  Returns a read-only (constant) iterator that points one past the last
@@ -940,7 +940,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       const_iterator
       cend() const noexcept
-      { TRACE("unordered_multiset: cend(1)"); return _M_h.end(); }
+      { TRACE("unordered_multiset: cend(1)", this); return _M_h.end(); }
 
       // modifiers.
 
@@ -954,7 +954,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	iterator
 	emplace(_Args&&... __args)
-	{ TRACE("unordered_multiset: emplace(1)"); return _M_h.emplace(std::forward<_Args>(__args)...); }
+	{ TRACE("unordered_multiset: emplace(1)", this); return _M_h.emplace(std::forward<_Args>(__args)...); }
 
       /**
        *  @brief Inserts an element into the %unordered_multiset.
@@ -976,7 +976,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename... _Args>
 	iterator
 	emplace_hint(const_iterator __pos, _Args&&... __args)
-	{ TRACE("unordered_multiset: emplace_hint(1)"); return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
+	{ TRACE("unordered_multiset: emplace_hint(1)", this); return _M_h.emplace_hint(__pos, std::forward<_Args>(__args)...); }
 
       //@{
       /**
@@ -988,11 +988,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const value_type& __x)
-      { TRACE("unordered_multiset: insert: copy(1)"); return _M_h.insert(__x); }
+      { TRACE("unordered_multiset: insert: copy(1)", this, __x); return _M_h.insert(__x); }
 
       iterator
       insert(value_type&& __x)
-      { TRACE("unordered_multiset: insert: move(2)"); return _M_h.insert(std::move(__x)); }
+      { TRACE("unordered_multiset: insert: move(2)", this, __x); return _M_h.insert(std::move(__x)); }
       //@}
 
       //@{
@@ -1014,11 +1014,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       insert(const_iterator __hint, const value_type& __x)
-      { TRACE("unordered_multiset: insert: copy/hint(3)"); return _M_h.insert(__hint, __x); }
+      { TRACE("unordered_multiset: insert: copy/hint(3)", this, __x); return _M_h.insert(__hint, __x); }
 
       iterator
       insert(const_iterator __hint, value_type&& __x)
-      { TRACE("unordered_multiset: insert: move/hint(4)"); return _M_h.insert(__hint, std::move(__x)); }
+      { TRACE("unordered_multiset: insert: move/hint(4)", this, __x); return _M_h.insert(__hint, std::move(__x)); }
       //@}
 
       /**
@@ -1032,7 +1032,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       template<typename _InputIterator>
 	void
 	insert(_InputIterator __first, _InputIterator __last)
-	{ TRACE("unordered_multiset: insert: range(5)"); _M_h.insert(__first, __last); }
+	{ TRACE("unordered_multiset: insert: range(5)", this); _M_h.insert(__first, __last); }
 
       /**
        *  @brief Inserts a list of elements into the %unordered_multiset.
@@ -1043,7 +1043,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       insert(initializer_list<value_type> __l)
-      { TRACE("unordered_multiset: insert: ilist(6)"); _M_h.insert(__l); }
+      { TRACE("unordered_multiset: insert: ilist(6)", this); _M_h.insert(__l); }
 
       //@{
       /**
@@ -1062,12 +1062,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __position)
-      { TRACE("unordered_multiset: erase: position(1a)"); return _M_h.erase(__position); }
+      { TRACE("unordered_multiset: erase: position(1a)", this); return _M_h.erase(__position); }
 
       // LWG 2059.
       iterator
       erase(iterator __position)
-      { TRACE("unordered_multiset: erase: position(1b)"); return _M_h.erase(__position); }
+      { TRACE("unordered_multiset: erase: position(1b)", this); return _M_h.erase(__position); }
       //@}
 
 
@@ -1085,7 +1085,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       erase(const key_type& __x)
-      { TRACE("unordered_multiset: erase: key(2)"); return _M_h.erase(__x); }
+      { TRACE("unordered_multiset: erase: key(2)", this, __x); return _M_h.erase(__x); }
 
       /**
        *  @brief Erases a [__first,__last) range of elements from an
@@ -1105,7 +1105,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       erase(const_iterator __first, const_iterator __last)
-      { TRACE("unordered_multiset: erase: range(3)"); return _M_h.erase(__first, __last); }
+      { TRACE("unordered_multiset: erase: range(3)", this); return _M_h.erase(__first, __last); }
 
       /**
        *  Erases all elements in an %unordered_multiset.
@@ -1116,7 +1116,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       void
       clear() noexcept
-      { TRACE("unordered_multiset: clear(1)"); _M_h.clear(); }
+      { TRACE("unordered_multiset: clear(1)", this); _M_h.clear(); }
 
       /**
        *  @brief  Swaps data with another %unordered_multiset.
@@ -1162,11 +1162,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       iterator
       find(const key_type& __x)
-      { TRACE("unordered_multiset: find(1a)"); return _M_h.find(__x); }
+      { TRACE("unordered_multiset: find(1a)", this, __x); return _M_h.find(__x); }
 
       const_iterator
       find(const key_type& __x) const
-      { TRACE("unordered_multiset: find(1b)"); return _M_h.find(__x); }
+      { TRACE("unordered_multiset: find(1b)", this, __x); return _M_h.find(__x); }
       //@}
 
       /**
@@ -1176,7 +1176,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       size_type
       count(const key_type& __x) const
-      { TRACE("unordered_multiset: count(1)"); return _M_h.count(__x); }
+      { TRACE("unordered_multiset: count(1)", this, __x); return _M_h.count(__x); }
 
       //@{
       /**
@@ -1233,15 +1233,15 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       local_iterator
       begin(size_type __n)
-      { TRACE("unordered_multiset: begin(2a)"); return _M_h.begin(__n); }
+      { TRACE("unordered_multiset: begin(2a)", this, __n); return _M_h.begin(__n); }
 
       const_local_iterator
       begin(size_type __n) const
-      { TRACE("unordered_multiset: begin(2b)"); return _M_h.begin(__n); }
+      { TRACE("unordered_multiset: begin(2b)", this, __n); return _M_h.begin(__n); }
 
       const_local_iterator
       cbegin(size_type __n) const
-      { TRACE("unordered_multiset: cbegin(2)"); return _M_h.cbegin(__n); }
+      { TRACE("unordered_multiset: cbegin(2)", this, __n); return _M_h.cbegin(__n); }
       //@}
 
       //@{
@@ -1253,15 +1253,15 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
        */
       local_iterator
       end(size_type __n)
-      { TRACE("unordered_multiset: end(2a)"); return _M_h.end(__n); }
+      { TRACE("unordered_multiset: end(2a)", this, __n); return _M_h.end(__n); }
 
       const_local_iterator
       end(size_type __n) const
-      { TRACE("unordered_multiset: end(2b)"); return _M_h.end(__n); }
+      { TRACE("unordered_multiset: end(2b)", this, __n); return _M_h.end(__n); }
 
       const_local_iterator
       cend(size_type __n) const
-      { TRACE("unordered_multiset: cend(2)"); return _M_h.cend(__n); }
+      { TRACE("unordered_multiset: cend(2)", this, __n); return _M_h.cend(__n); }
       //@}
 
       // hash policy.
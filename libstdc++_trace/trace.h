@@ -1,6 +1,851 @@
-#ifdef NO_TM
+// -*-c++-*-
+#pragma once
+
+/**
+ * TRACE(label) marks a method of libstdc++_trace, so that the validation
+ * programs can show that their tests reach every method they are meant to.
+ *
+ * Each TRACE names a local tag type, and the site descriptor is a static
+ * member of a class template instantiated on it, so that every traced site
+ * that the program contains registers itself at startup, before any of them
+ * runs (template methods only exist once they are instantiated, and a
+ * static in an inline function would only exist once reached).  Reaching a
+ * TRACE bumps a counter of the calling thread; there is no I/O and no
+ * shared write, so bench_trace can run at full size with many threads.  At
+ * exit, the counters of all threads are added up, and a coverage table is
+ * printed: one line per traced source line, with the number of hits and
+ * the number of threads that hit it, and the lines that were never hit are
+ * listed as such.  The lines are grouped by container, and then by the
+ * categories of the tables at the top of the validation drivers' bench.cc
+ * (Member Functions, Iterators, Capacity, ...), which trace_classify works
+ * out from the method that the label names.
+ *
+ * Compile with -DTRACE_PROFILE (bench_prof) to time each traced method
+ * instead: TRACE then starts a timer that stops at the end of the enclosing
+ * scope, and each thread keeps, per site, the number of calls, their total
+ * and largest latency, and a histogram of latencies in powers of two.  At
+ * exit, the traced lines are printed hottest first, by total time.  Times
+ * are inclusive: a traced method that calls another is charged for both.
+ *
+ * Compile with -DTRACE_RECORD (make TRACE_RECORD=1) to also log every
+ * TRACE that is reached, with its thread, its time, and how deeply it is
+ * nested in other traced calls, to the binary file named by
+ * $TRACE_RECORD_FILE (trace.log by default), in the format of tracelog.h.
+ * Each thread fills a buffer of its own, and writes it out when it is full;
+ * the rest, and the table of sites, are written at exit.  validation/replay
+ * runs such a log against every variant of the library.  A TRACE in a
+ * container method can name the container and an argument, as in
+ * TRACE("map: find(1a)", this, __x), and the log then has the container's
+ * address and a summary of the argument: its value if it is an integer, or
+ * the summary of its first member if it is a pair.  The other builds
+ * ignore them.
+ *
+ * Compile with -DTRACE_PRINTF to print each TRACE as it is reached instead,
+ * which is only useful for small, single-threaded runs.
+ */
+
+#if defined(NO_TM) && defined(TRACE_PRINTF)
 #  include <cstdio>
-#  define TRACE(x) printf("  [TRACE: %s] %s\n", x, __PRETTY_FUNCTION__)
+#  define TRACE(x, ...) printf("  [TRACE: %s] %s\n", x, __PRETTY_FUNCTION__)
+#elif defined(NO_TM)
+// Only C headers here: the C++ headers of libstdc++_trace use TRACE
+#  include <cstdio>
+#  include <cstdlib>
+#  include <cstring>
+#  include <time.h>
+
+#  if defined(TRACE_PROFILE) && defined(TRACE_RECORD)
+#    error "TRACE_PROFILE and TRACE_RECORD cannot be used together"
+#  endif
+
+/// A TRACE in the source
+struct trace_site
+{
+    const char* label;
+    const char* file;
+    int         line;
+    unsigned    index;      // into each thread's counts
+    trace_site* next;
+    const char* container;  // set by trace_classify
+    int         container_len;
+    int         category;   // a trace_category
+};
+
+#  ifdef TRACE_PROFILE
+/// Latencies are counted in buckets of powers of two ticks
+const int TRACE_BUCKETS = 40;
+
+/// The calls that one thread made to one site
+struct trace_slot
+{
+    unsigned long      calls;
+    unsigned long long ticks;
+    unsigned long long max;
+    unsigned long      hist[TRACE_BUCKETS]; // [b]: under 2^b ticks
+};
+
+inline unsigned long trace_calls(const trace_slot& s) { return s.calls; }
+#  else
+/// The hits of one thread at one site
+typedef unsigned long trace_slot;
+
+inline unsigned long trace_calls(const trace_slot& s) { return s; }
+#  endif
+
+/// The slots of one thread, indexed by site
+struct trace_counts
+{
+    trace_slot*   slots;
+    unsigned      size;
+    trace_counts* next;
+};
+
+/// Every site, newest first
+inline trace_site*& trace_all_sites()
+{
+    static trace_site* head = nullptr;
+    return head;
+}
+
+/// The number of sites
+inline unsigned& trace_site_count()
+{
+    static unsigned count = 0;
+    return count;
+}
+
+/// Every thread's counts
+inline trace_counts*& trace_all_counts()
+{
+    static trace_counts* head = nullptr;
+    return head;
+}
+
+/// The file name of a path
+inline const char* trace_basename(const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+/// The categories of the bench.cc tables, in the order that they have there
+enum trace_category
+{
+    trace_member_functions, trace_iterators, trace_iterator_methods,
+    trace_iterator_overloads, trace_iterator_functions, trace_capacity,
+    trace_element_access, trace_element_lookup, trace_modifiers,
+    trace_operations, trace_buckets, trace_hash_policy, trace_allocators,
+    trace_observers, trace_nmfos, trace_non_member_functions, trace_other
+};
+
+inline const char* trace_category_name(int c)
+{
+    static const char* const names[] = {
+        "Member Functions", "Iterators", "Iterator Methods",
+        "Iterator Overloads", "Iterator Functions", "Capacity",
+        "Element Access", "Element Lookup", "Modifiers", "Operations",
+        "Buckets", "Hash Policy", "Allocators", "Observers",
+        "Non-member Function Overloads", "Non-member Functions", "Other"
+    };
+    return names[c];
+}
+
+/// Which words of a label put it in which category, for which containers
+/// ("" for all of them).  The first row that has a word of the label wins,
+/// so that, for instance, begin() is in Iterators although its label may
+/// say "iterator", and a non-member swap is not a Modifier.  The words
+/// include the prefixes that some labels start with ("modifiers: ...").
+struct trace_category_row
+{
+    const char*    containers;
+    trace_category category;
+    const char*    words;
+};
+
+inline const trace_category_row* trace_category_rows()
+{
+    static const trace_category_row rows[] = {
+        { "", trace_iterators,
+          "begin end rbegin rend cbegin cend crbegin crend" },
+        { "", trace_iterator_overloads, "overload" },
+        { "", trace_iterator_functions, "function" },
+        { "", trace_iterator_methods, "iterator deque_iterator" },
+        { "", trace_nmfos, "nmfo relaoper non-mem-swap overloads external" },
+        { "tuple", trace_non_member_functions, "tie forward" },
+        { "tuple", trace_nmfos, "global" },
+        { "", trace_member_functions, "ctor dtor operator= oper=" },
+        { "pair tuple", trace_member_functions, "swap" },
+        { "vector", trace_capacity, "resize reserve" },
+        { "deque", trace_capacity, "resize" },
+        { "", trace_capacity, "capacity size max_size empty shrink_to_fit" },
+        { "", trace_element_access,
+          "access operator[] oper[] at front back data" },
+        { "unordered_map unordered_set unordered_multiset",
+          trace_element_lookup, "find count equal_range" },
+        { "", trace_operations,
+          "operations find count lower_bound upper_bound equal_range "
+          "splice remove remove_if unique merge sort reverse" },
+        { "", trace_modifiers,
+          "modifiers assign push_back push_front pop_back pop_front insert "
+          "erase swap clear emplace emplace_hint emplace_front emplace_back "
+          "resize" },
+        { "", trace_buckets,
+          "bucket_count max_bucket_count bucket_size bucket" },
+        { "", trace_hash_policy, "load_factor max_load_factor rehash reserve" },
+        { "vector deque", trace_allocators, "allocator get_allocator" },
+        { "", trace_observers,
+          "observers get_allocator key_comp value_comp hash_function key_eq" },
+        { nullptr, trace_other, nullptr }
+    };
+    return rows;
+}
+
+/// Is the n-character word w one of the space-separated words of list?
+inline bool trace_has_word(const char* list, const char* w, size_t n)
+{
+    for (const char* p = list; *p; ) {
+        size_t len = strcspn(p, " ");
+        if (len == n && !strncmp(p, w, n))
+            return true;
+        p += len;
+        p += strspn(p, " ");
+    }
+    return false;
+}
+
+/// Is any word of the label, which are what is between spaces, colons and
+/// brackets, one of the space-separated words of list?
+inline bool trace_label_has(const char* label, const char* list)
+{
+    for (const char* p = label; *p; ) {
+        p += strspn(p, " :()");
+        size_t len = strcspn(p, " :()");
+        if (len && trace_has_word(list, p, len))
+            return true;
+        p += len;
+    }
+    return false;
+}
+
+/// Work out the container and category of a site.  The container is the
+/// label's first word if that names one, as in "map: find(1a)", and is
+/// otherwise named by the file, as for "ctor: copy (4)" in stl_list.h.
+inline void trace_classify(trace_site* s)
+{
+    static const char* const containers = "vector deque list map "
+        "unordered_map unordered_set unordered_multiset pair tuple";
+    size_t first = strcspn(s->label, " :(");
+    if (trace_has_word(containers, s->label, first)) {
+        s->container = s->label;
+        s->container_len = first;
+    }
+    else {
+        const char* file = trace_basename(s->file);
+        if (!strncmp(file, "stl_", 4))
+            file += 4;
+        s->container = file;
+        s->container_len = strcspn(file, ".");
+    }
+
+    s->category = trace_other;
+    for (const trace_category_row* r = trace_category_rows(); r->words; ++r) {
+        if (*r->containers
+            && !trace_has_word(r->containers, s->container, s->container_len))
+            continue;
+        if (trace_label_has(s->label, r->words)) {
+            s->category = r->category;
+            return;
+        }
+    }
+}
+
+/// Order sites by container, then category, then file and line, so that
+/// the instantiations of one TRACE end up next to each other
+inline int trace_compare(const void* a, const void* b)
+{
+    const trace_site* x = *(const trace_site* const*)a;
+    const trace_site* y = *(const trace_site* const*)b;
+    int xl = x->container_len, yl = y->container_len;
+    int c = strncmp(x->container, y->container, xl < yl ? xl : yl);
+    if (c == 0 && xl != yl)
+        c = xl < yl ? -1 : 1;
+    if (c == 0)
+        c = x->category - y->category;
+    if (c == 0)
+        c = strcmp(x->file, y->file);
+    if (c == 0)
+        c = x->line - y->line;
+    return c;
+}
+
+/// The slot of one thread at one site, or null if the thread has none
+inline const trace_slot* trace_slot_at(const trace_counts* t, const trace_site* s)
+{
+    return s->index < t->size ? &t->slots[s->index] : nullptr;
+}
+
+/// The hits of one thread at one site
+inline unsigned long trace_hits(const trace_counts* t, const trace_site* s)
+{
+    const trace_slot* slot = trace_slot_at(t, s);
+    return slot ? trace_calls(*slot) : 0;
+}
+
+/// Every site, classified, and sorted by trace_compare; the caller frees it
+inline const trace_site** trace_sorted_sites(size_t& n)
+{
+    n = __atomic_load_n(&trace_site_count(), __ATOMIC_ACQUIRE);
+    const trace_site** order = (const trace_site**)malloc(n * sizeof(*order));
+    size_t k = 0;
+    for (trace_site* s = __atomic_load_n(&trace_all_sites(), __ATOMIC_ACQUIRE);
+         s && k < n; s = s->next) {
+        trace_classify(s);
+        order[k++] = s;
+    }
+    n = k;
+    qsort(order, n, sizeof(*order), trace_compare);
+    return order;
+}
+
+/// The end of the run of sites, starting at i, that are the same line
+inline size_t trace_same_line(const trace_site** order, size_t n, size_t i)
+{
+    size_t j = i;
+    while (j < n && !trace_compare(&order[i], &order[j]))
+        ++j;
+    return j;
+}
+
+/// The part of a site's label after its container, if it starts with it
+inline const char* trace_method(const trace_site* s)
+{
+    const char* label = s->label;
+    if (s->container == label) {
+        label += s->container_len;
+        label += strspn(label, " :");
+    }
+    return label;
+}
+
+inline unsigned long long trace_now_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+#  ifdef TRACE_PROFILE
+/// A tick of the clock that times methods: the time stamp counter where
+/// there is one, and nanoseconds otherwise
+inline unsigned long long trace_ticks()
+{
+#    if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#    else
+    return trace_now_ns();
+#    endif
+}
+
+/// The ticks and time when the first site was registered, to work out how
+/// long a tick is
+inline unsigned long long* trace_epoch()
+{
+    static unsigned long long epoch[2] = { trace_ticks(), trace_now_ns() };
+    return epoch;
+}
+
+/// Add b's calls to a
+inline void trace_add(trace_slot& a, const trace_slot& b)
+{
+    a.calls += b.calls;
+    a.ticks += b.ticks;
+    if (b.max > a.max)
+        a.max = b.max;
+    for (int i = 0; i < TRACE_BUCKETS; ++i)
+        a.hist[i] += b.hist[i];
+}
+
+/// The latency, in ticks, that a fraction of the calls are under, to within
+/// a power of two
+inline unsigned long long trace_percentile(const trace_slot& s, double frac)
+{
+    unsigned long seen = 0;
+    for (int i = 0; i < TRACE_BUCKETS; ++i) {
+        seen += s.hist[i];
+        if (seen >= frac * s.calls)
+            return (1ull << i) < s.max ? 1ull << i : s.max;
+    }
+    return s.max;
+}
+
+/// A traced line, with the calls of all its instantiations and threads
+struct trace_line
+{
+    const trace_site* site;
+    trace_slot        total;
+    unsigned          threads;
+};
+
+inline int trace_hotter(const void* a, const void* b)
+{
+    unsigned long long x = ((const trace_line*)a)->total.ticks;
+    unsigned long long y = ((const trace_line*)b)->total.ticks;
+    return x < y ? 1 : x > y ? -1 : 0;
+}
+
+/// Print the traced lines to stdout, hottest first, with the latency
+/// histograms of the hottest few
+inline void trace_report()
+{
+    unsigned long long* epoch = trace_epoch();
+    double dt = trace_now_ns() - epoch[1];
+    double ns_per_tick = dt > 0 ? dt / (trace_ticks() - epoch[0]) : 1;
+
+    size_t n;
+    const trace_site** order = trace_sorted_sites(n);
+    trace_line* lines = (trace_line*)calloc(n ? n : 1, sizeof(trace_line));
+    size_t count = 0, unreached = 0;
+    for (size_t i = 0, j; i < n; i = j) {
+        j = trace_same_line(order, n, i);
+        trace_line& l = lines[count];
+        l.site = order[i];
+        for (trace_counts* t = trace_all_counts(); t; t = t->next) {
+            trace_slot mine = trace_slot();
+            for (size_t k = i; k < j; ++k)
+                if (const trace_slot* s = trace_slot_at(t, order[k]))
+                    trace_add(mine, *s);
+            trace_add(l.total, mine);
+            l.threads += mine.calls != 0;
+        }
+        if (l.total.calls)
+            ++count;
+        else
+            ++unreached;
+    }
+    qsort(lines, count, sizeof(trace_line), trace_hotter);
+
+    printf("\nTRACE profile: %zu traced lines reached, %zu not reached, "
+           "%.2f ns per tick\n", count, unreached, ns_per_tick);
+    printf("%12s %12s %10s %10s %10s %12s %7s  %s\n", "total ms", "calls",
+           "mean ns", "p50 ns <", "p99 ns <", "max ns", "threads", "method");
+    for (size_t i = 0; i < count; ++i) {
+        const trace_slot& s = lines[i].total;
+        printf("%12.3f %12lu %10.1f %10.0f %10.0f %12.0f %7u  %s (%s:%d)\n",
+               s.ticks * ns_per_tick / 1e6, s.calls,
+               s.ticks * ns_per_tick / s.calls,
+               trace_percentile(s, 0.5) * ns_per_tick,
+               trace_percentile(s, 0.99) * ns_per_tick, s.max * ns_per_tick,
+               lines[i].threads, lines[i].site->label,
+               trace_basename(lines[i].site->file), lines[i].site->line);
+    }
+
+    // the shape of the hottest methods' latencies
+    const size_t HISTOGRAMS = 10;
+    if (count)
+        printf("\nTRACE latency histograms, hottest %zu methods (calls under "
+               "each bound)\n", count < HISTOGRAMS ? count : HISTOGRAMS);
+    for (size_t i = 0; i < count && i < HISTOGRAMS; ++i) {
+        const trace_slot& s = lines[i].total;
+        printf("  %s (%s:%d)\n   ", lines[i].site->label,
+               trace_basename(lines[i].site->file), lines[i].site->line);
+        for (int b = 0; b < TRACE_BUCKETS; ++b)
+            if (s.hist[b])
+                printf(" %.0fns:%lu", (1ull << b) * ns_per_tick, s.hist[b]);
+        printf("\n");
+    }
+    free(lines);
+    free((void*)order);
+}
+#  else
+/// Print the coverage table to stdout
+inline void trace_report()
+{
+    size_t n;
+    const trace_site** order = trace_sorted_sites(n);
+
+    // count the traced lines, and the ones that were hit
+    size_t lines = 0, hit = 0;
+    for (size_t i = 0, j; i < n; i = j) {
+        bool any = false;
+        j = trace_same_line(order, n, i);
+        for (size_t k = i; k < j; ++k)
+            for (trace_counts* t = trace_all_counts(); t && !any; t = t->next)
+                any = trace_hits(t, order[k]) != 0;
+        ++lines;
+        hit += any;
+    }
+    printf("\nTRACE coverage: %zu of %zu traced lines hit\n", hit, lines);
+
+    const trace_site* group = NULL;
+    for (size_t i = 0, j; i < n; i = j) {
+        const trace_site* s = order[i];
+        if (!group || group->container_len != s->container_len
+            || strncmp(group->container, s->container, s->container_len)
+            || group->category != s->category) {
+            group = s;
+            printf("  %.*s: %s\n", s->container_len, s->container,
+                   trace_category_name(s->category));
+        }
+        // all instantiations of this line
+        j = trace_same_line(order, n, i);
+        unsigned long hits = 0;
+        unsigned threads = 0;
+        for (trace_counts* t = trace_all_counts(); t; t = t->next) {
+            unsigned long mine = 0;
+            for (size_t k = i; k < j; ++k)
+                mine += trace_hits(t, order[k]);
+            hits += mine;
+            threads += mine != 0;
+        }
+        const char* label = trace_method(order[i]);
+        const char* file = trace_basename(order[i]->file);
+        if (hits)
+            printf("    %10lu hits, %3u threads  %-32s %s:%d\n", hits, threads,
+                   label, file, order[i]->line);
+        else
+            printf("    %10s                %-32s %s:%d\n", "NOT HIT", label,
+                   file, order[i]->line);
+    }
+    free((void*)order);
+}
+#  endif
+
+#  ifdef TRACE_RECORD
+#    include "tracelog.h"
+
+/// Events that a thread buffers before it writes them out
+const unsigned TRACE_RECORD_EVENTS = 4096;
+
+/// The events of one thread that have not been written yet
+struct trace_recorder
+{
+    tracelog_event  events[TRACE_RECORD_EVENTS];
+    unsigned        count;
+    unsigned        thread;
+    unsigned        depth;   // traced calls in progress
+    trace_recorder* next;
+};
+
+/// Summarize an argument of a traced call in out, and return true, or
+/// return false if it has no summary (iterators, ranges, and the like)
+template <typename T>
+inline auto trace_summary(const T& v, long long& out, int)
+    -> decltype(static_cast<long long>(v), true)
+{
+    out = static_cast<long long>(v);
+    return true;
+}
+
+template <typename T>
+inline auto trace_summary(const T& v, long long& out, long)
+    -> decltype(v.first, true)
+{
+    return trace_summary(v.first, out, 0);
+}
+
+template <typename T>
+inline bool trace_summary(const T&, long long&, ...)
+{
+    return false;
+}
+
+/// Every thread's recorder
+inline trace_recorder*& trace_all_recorders()
+{
+    static trace_recorder* head = nullptr;
+    return head;
+}
+
+/// The log, and the lock that writers hold
+inline FILE*& trace_log()
+{
+    static FILE* log = nullptr;
+    return log;
+}
+
+inline int& trace_log_lock()
+{
+    static int lock = 0;
+    return lock;
+}
+
+inline unsigned long long& trace_log_start()
+{
+    static unsigned long long start = 0;
+    return start;
+}
+
+/// Write out the buffered events of a thread
+inline void trace_log_flush(trace_recorder* r)
+{
+    while (__atomic_exchange_n(&trace_log_lock(), 1, __ATOMIC_ACQUIRE))
+        ;
+    if (trace_log() && r->count) {
+        tracelog_chunk c = { tracelog_events, r->thread, r->count };
+        fwrite(&c, sizeof(c), 1, trace_log());
+        fwrite(r->events, sizeof(tracelog_event), r->count, trace_log());
+    }
+    r->count = 0;
+    __atomic_store_n(&trace_log_lock(), 0, __ATOMIC_RELEASE);
+}
+
+/// At exit, write out every thread's events, and then the sites
+inline void trace_log_close()
+{
+    for (trace_recorder* r = __atomic_load_n(&trace_all_recorders(), __ATOMIC_ACQUIRE);
+         r; r = r->next)
+        trace_log_flush(r);
+    FILE* log = trace_log();
+    if (!log)
+        return;
+    tracelog_chunk c = { tracelog_sites, 0, trace_site_count() };
+    fwrite(&c, sizeof(c), 1, log);
+    for (trace_site* s = trace_all_sites(); s; s = s->next) {
+        tracelog_site_record rec = { s->index, s->line,
+                                     (uint32_t)strlen(s->label),
+                                     (uint32_t)strlen(s->file) };
+        fwrite(&rec, sizeof(rec), 1, log);
+        fwrite(s->label, 1, rec.label_len, log);
+        fwrite(s->file, 1, rec.file_len, log);
+    }
+    fclose(log);
+    trace_log() = nullptr;
+}
+
+/// Start the log, when the first site is registered
+inline void trace_log_open()
+{
+    const char* name = getenv("TRACE_RECORD_FILE");
+    if (!name || !*name)
+        name = "trace.log";
+    FILE* log = fopen(name, "wb");
+    if (!log) {
+        fprintf(stderr, "TRACE: cannot record to %s\n", name);
+        return;
+    }
+    tracelog_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRACELOG_MAGIC, sizeof(TRACELOG_MAGIC));
+    h.start_ns = trace_log_start() = trace_now_ns();
+    fwrite(&h, sizeof(h), 1, log);
+    trace_log() = log;
+    atexit(trace_log_close);
+}
+
+/// The calling thread's recorder
+inline trace_recorder* trace_my_recorder()
+{
+    static unsigned threads = 0;
+    static thread_local trace_recorder* mine = nullptr;
+    if (__builtin_expect(!mine, 0)) {
+        mine = (trace_recorder*)calloc(1, sizeof(trace_recorder));
+        mine->thread = __atomic_fetch_add(&threads, 1, __ATOMIC_RELAXED);
+        mine->next = __atomic_load_n(&trace_all_recorders(), __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&trace_all_recorders(), &mine->next,
+                                            mine, true, __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED))
+            ;
+    }
+    return mine;
+}
+#  endif
+
+/// The index of a site that has not been registered yet
+const unsigned TRACE_UNREGISTERED = ~0u;
+
+/// Add a site to the list, unless it is there already.  This is done at
+/// startup, or when the site is first reached if that comes first (from a
+/// static constructor in another file).
+inline void trace_register(trace_site* s)
+{
+    static int lock = 0;
+    while (__atomic_exchange_n(&lock, 1, __ATOMIC_ACQUIRE))
+        ;
+    if (s->index == TRACE_UNREGISTERED) {
+        if (!trace_all_sites()) {
+#  ifdef TRACE_PROFILE
+            trace_epoch();
+#  endif
+            atexit(trace_report);
+#  ifdef TRACE_RECORD
+            trace_log_open();
+#  endif
+        }
+        s->next = trace_all_sites();
+        __atomic_store_n(&trace_all_sites(), s, __ATOMIC_RELEASE);
+        __atomic_store_n(&s->index, trace_site_count()++, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&lock, 0, __ATOMIC_RELEASE);
+}
+
+/// Register a site if it needs it, and make or grow the calling thread's
+/// counts so that they have room for it
+inline trace_counts* trace_grow_counts(trace_counts* t, trace_site* s)
+{
+    if (__atomic_load_n(&s->index, __ATOMIC_ACQUIRE) == TRACE_UNREGISTERED)
+        trace_register(s);
+    unsigned size = __atomic_load_n(&trace_site_count(), __ATOMIC_ACQUIRE);
+    if (t) {
+        t->slots = (trace_slot*)realloc(t->slots, size * sizeof(trace_slot));
+        memset(t->slots + t->size, 0, (size - t->size) * sizeof(trace_slot));
+        t->size = size;
+        return t;
+    }
+    t = (trace_counts*)malloc(sizeof(trace_counts));
+    t->slots = (trace_slot*)calloc(size, sizeof(trace_slot));
+    t->size = size;
+    t->next = __atomic_load_n(&trace_all_counts(), __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&trace_all_counts(), &t->next, t, true,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+    return t;
+}
+
+/// The calling thread's counts
+inline trace_counts*& trace_my_counts()
+{
+    static thread_local trace_counts* mine = nullptr;
+    return mine;
+}
+
+/// The calling thread's slot for a site.  The reference is good until the
+/// next call, which may move the slots.
+inline trace_slot& trace_slot_of(trace_site* s)
+{
+    trace_counts*& mine = trace_my_counts();
+    if (__builtin_expect(!mine || s->index >= mine->size, 0))
+        mine = trace_grow_counts(mine, s);
+    return mine->slots[s->index];
+}
+
+/// The TRACE whose tag type is Tag.  Its site is constant-initialized, and
+/// registered by a dynamic initializer, which runs at startup for every
+/// TRACE that the program contains.
+template <typename Tag>
+struct trace_point
+{
+    static trace_site site;
+    static bool       registered;
+
+    static trace_site* get()
+    {
+        (void)registered;
+        return &site;
+    }
+};
+
+template <typename Tag>
+trace_site trace_point<Tag>::site = {
+    Tag::label(), Tag::file(), Tag::line(), TRACE_UNREGISTERED, nullptr,
+    nullptr, 0, 0
+};
+
+template <typename Tag>
+bool trace_point<Tag>::registered = (trace_register(&trace_point<Tag>::site), true);
+
+#  define TRACE_TAG(x, tag)                                                 \
+    struct tag                                                              \
+    {                                                                       \
+        static constexpr const char* label() { return x; }                  \
+        static constexpr const char* file() { return __FILE__; }            \
+        static constexpr int line() { return __LINE__; }                    \
+    }
+
+#  ifdef TRACE_PROFILE
+/// Times the rest of the scope that it is declared in.  The slot is looked
+/// up again at the end, because a TRACE reached in between may have moved
+/// it (only while sites are still being registered).
+struct trace_timer
+{
+    trace_site*        site;
+    unsigned long long start;
+
+    /// Whatever else the TRACE names is not timed
+    template <typename... Ignored>
+    explicit trace_timer(trace_site* s, const Ignored&...) : site(s)
+    {
+        trace_slot_of(s);
+        start = trace_ticks();
+    }
+
+    ~trace_timer()
+    {
+        unsigned long long t = trace_ticks() - start;
+        trace_slot& slot = trace_my_counts()->slots[site->index];
+        ++slot.calls;
+        slot.ticks += t;
+        if (t > slot.max)
+            slot.max = t;
+        int b = t ? 64 - __builtin_clzll(t) : 0;
+        ++slot.hist[b < TRACE_BUCKETS ? b : TRACE_BUCKETS - 1];
+    }
+};
+
+typedef trace_timer trace_scope;
+#  elif defined(TRACE_RECORD)
+/// Counts and logs a call, and keeps track of how deeply calls are nested
+/// until the end of the scope that it is declared in
+struct trace_call
+{
+    trace_recorder* rec;
+
+    explicit trace_call(trace_site* s, const void* obj = nullptr)
+        : rec(trace_my_recorder())
+    {
+        record(s, obj);
+    }
+
+    template <typename T>
+    trace_call(trace_site* s, const void* obj, const T& arg)
+        : rec(trace_my_recorder())
+    {
+        tracelog_event& e = record(s, obj);
+        long long summary = 0;
+        if (trace_summary(arg, summary, 0)) {
+            e.arg = summary;
+            e.flags |= tracelog_has_arg;
+        }
+    }
+
+    tracelog_event& record(trace_site* s, const void* obj)
+    {
+        ++trace_slot_of(s);
+        if (rec->count == TRACE_RECORD_EVENTS)
+            trace_log_flush(rec);
+        tracelog_event& e = rec->events[rec->count++];
+        e.ns = trace_now_ns() - trace_log_start();
+        e.object = (uintptr_t)obj;
+        e.arg = 0;
+        e.site = s->index;
+        e.depth = rec->depth++;
+        e.flags = 0;
+        return e;
+    }
+
+    ~trace_call()
+    {
+        --rec->depth;
+    }
+};
+
+typedef trace_call trace_scope;
+#  endif
+
+#  if defined(TRACE_PROFILE) || defined(TRACE_RECORD)
+#    define TRACE_CAT2(a, b) a##b
+#    define TRACE_CAT(a, b) TRACE_CAT2(a, b)
+#    define TRACE(...) TRACE_SCOPED(__COUNTER__, __VA_ARGS__)
+#    define TRACE_SCOPED(n, x, ...)                                         \
+    TRACE_TAG(x, TRACE_CAT(_trace_tag, n));                                 \
+    trace_scope TRACE_CAT(_trace_scope, n)(                                 \
+        trace_point<TRACE_CAT(_trace_tag, n)>::get(), ##__VA_ARGS__)
+#  else
+#    define TRACE(x, ...)                                                   \
+    do {                                                                    \
+        TRACE_TAG(x, _trace_tag);                                           \
+        ++trace_slot_of(trace_point<_trace_tag>::get());                    \
+    } while (0)
+#  endif
 #else
-#  define TRACE(x)
+#  define TRACE(...)
 #endif
@@ -0,0 +1,64 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * The format of the binary logs that a trace build compiled with
+ * -DTRACE_RECORD writes (see trace.h), and that validation/replay reads.
+ *
+ * A log is a tracelog_header, followed by chunks.  Each chunk starts with a
+ * tracelog_chunk.  An events chunk holds count tracelog_events of one
+ * thread, in the order in which that thread reached them; a thread's events
+ * may be spread over many chunks, which come in order.  The sites chunk
+ * comes last, and holds count tracelog_site_records, each followed by the
+ * site's label and file name (not NUL-terminated).
+ *
+ * Everything is in the byte order of the machine that wrote the log.
+ */
+
+#include <stdint.h>
+
+#define TRACELOG_MAGIC "STLTRC2"
+
+struct tracelog_header
+{
+    char     magic[8];   // TRACELOG_MAGIC
+    uint64_t start_ns;   // CLOCK_MONOTONIC when recording started
+};
+
+enum tracelog_kind
+{
+    tracelog_events = 1,
+    tracelog_sites  = 2
+};
+
+struct tracelog_chunk
+{
+    uint32_t kind;       // a tracelog_kind
+    uint32_t thread;     // events: the thread, numbered from 0
+    uint64_t count;
+};
+
+/// tracelog_event flags
+enum tracelog_flag
+{
+    tracelog_has_arg = 1  // arg holds a summary of the call's argument
+};
+
+/// A TRACE that was reached
+struct tracelog_event
+{
+    uint64_t ns;         // since start_ns
+    uint64_t object;     // the address of the container, or 0 if not known
+    int64_t  arg;        // the key, value, size or position passed, if any
+    uint32_t site;       // the index of a site in the sites chunk
+    uint16_t depth;      // traced calls that this one is nested in
+    uint16_t flags;      // tracelog_flag bits
+};
+
+struct tracelog_site_record
+{
+    uint32_t index;
+    int32_t  line;
+    uint32_t label_len;
+    uint32_t file_len;
+};
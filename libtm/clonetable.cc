@@ -0,0 +1,102 @@
+/**
+ * Registration and lookup of transactional clone tables.
+ *
+ * Every object compiled with -fgnu-tm gets a .tm_clone_table section that
+ * maps each transaction_callable/safe function to its transactional clone,
+ * and crtbegin.o registers that table when the module is loaded.  A
+ * transaction that calls through a function pointer looks the pointer up
+ * here.
+ *
+ * Registration happens from module initializers, possibly before any of our
+ * own constructors have run, so everything here uses statically
+ * zero-initialized storage and plain malloc.
+ */
+
+#include <cstdlib>
+#include <pthread.h>
+#include "itm.h"
+
+namespace
+{
+    /// One entry of a clone table, as laid out by the compiler
+    struct clone_entry
+    {
+        void* orig;
+        void* clone;
+    };
+
+    /// One registered table, sorted by orig for binary search
+    struct clone_table
+    {
+        void*        key;     // the address the module registered with
+        clone_entry* entries; // our sorted copy
+        size_t       size;
+        clone_table* next;
+    };
+
+    /// All registered tables.  Tables only come and go when modules are
+    /// loaded or unloaded, so lookups take a reader lock.
+    clone_table*     tables = NULL;
+    pthread_rwlock_t tables_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+    int compare_entries(const void* a, const void* b)
+    {
+        uintptr_t x = (uintptr_t)((const clone_entry*)a)->orig;
+        uintptr_t y = (uintptr_t)((const clone_entry*)b)->orig;
+        return x < y ? -1 : x > y ? 1 : 0;
+    }
+}
+
+void _ITM_registerTMCloneTable(void* xent, size_t size)
+{
+    clone_table* t = (clone_table*)malloc(sizeof(clone_table));
+    t->key = xent;
+    t->size = size;
+    t->entries = (clone_entry*)malloc(size * sizeof(clone_entry));
+    clone_entry* in = (clone_entry*)xent;
+    for (size_t i = 0; i < size; ++i)
+        t->entries[i] = in[i];
+    qsort(t->entries, size, sizeof(clone_entry), compare_entries);
+
+    pthread_rwlock_wrlock(&tables_lock);
+    t->next = tables;
+    tables = t;
+    pthread_rwlock_unlock(&tables_lock);
+}
+
+void _ITM_deregisterTMCloneTable(void* xent)
+{
+    pthread_rwlock_wrlock(&tables_lock);
+    for (clone_table** p = &tables; *p; p = &(*p)->next) {
+        if ((*p)->key == xent) {
+            clone_table* t = *p;
+            *p = t->next;
+            free(t->entries);
+            free(t);
+            break;
+        }
+    }
+    pthread_rwlock_unlock(&tables_lock);
+}
+
+void* itm_find_clone(void* fn)
+{
+    void* result = NULL;
+    pthread_rwlock_rdlock(&tables_lock);
+    for (clone_table* t = tables; t && !result; t = t->next) {
+        size_t lo = 0, hi = t->size;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (t->entries[mid].orig == fn) {
+                result = t->entries[mid].clone;
+                break;
+            }
+            if ((uintptr_t)t->entries[mid].orig < (uintptr_t)fn)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+    pthread_rwlock_unlock(&tables_lock);
+    return result;
+}
@@ -0,0 +1,362 @@
+/**
+ * A counting implementation of the GCC TM ABI.
+ *
+ * This is not a real STM: transactions run in place, under one global lock,
+ * and are never rolled back.  What it gives us is an exact count of the
+ * barriers, allocations and irrevocability switches that the instrumented
+ * code executes, so that the instrumentation cost of each STL operation
+ * shows up as numbers.  Link it into a program (see bench_tmcount in
+ * validation/common/common.mk) and read the counters with
+ * tmcount_get_stats().
+ *
+ * Since nothing is ever undone, a transaction that cancels itself or asks
+ * to retry is a fatal error.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+#include "irrprof.h"
+#include "itm.h"
+#include "tmcount.h"
+
+namespace
+{
+    /// A deferred user action
+    struct user_action
+    {
+        void (*fn)(void*);
+        void* arg;
+    };
+
+    /// Per-thread transaction state.  It is plain old data, so that it is
+    /// usable before any constructor runs.
+    struct tx_descriptor
+    {
+        unsigned             nesting;
+        bool                 irrevocable;
+        _ITM_transactionId_t id;
+        user_action*         commit_actions;
+        unsigned             commit_count;
+        unsigned             commit_capacity;
+        tmcount_stats        stats;
+    };
+
+    __thread tx_descriptor self;
+
+    /// All transactions are serialized by this lock
+    pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
+
+    /// Source of transaction ids.  Protected by global_lock.
+    _ITM_transactionId_t next_id = _ITM_noTransactionId + 1;
+
+    /// Run and discard the commit actions of the current transaction
+    void run_commit_actions()
+    {
+        // actions may start new transactions, so detach the list first
+        user_action* actions = self.commit_actions;
+        unsigned count = self.commit_count;
+        self.commit_actions = NULL;
+        self.commit_count = self.commit_capacity = 0;
+        for (unsigned i = 0; i < count; ++i)
+            actions[i].fn(actions[i].arg);
+        free(actions);
+    }
+
+    /// Count a switch to irrevocable mode, if we have not switched already
+    void go_irrevocable(irr_reason why, void* site)
+    {
+        if (!self.irrevocable) {
+            self.irrevocable = true;
+            ++self.stats.irrevocable;
+            irr_record(why, site);
+        }
+    }
+}
+
+extern "C"
+{
+    void tmcount_get_stats(tmcount_stats* out)
+    {
+        *out = self.stats;
+    }
+
+    uint32_t ITM_REGPARM _ITM_beginTransaction(uint32_t prop, ...)
+    {
+        if (self.nesting++ == 0) {
+            pthread_mutex_lock(&global_lock);
+            self.id = next_id++;
+            self.irrevocable = false;
+            ++self.stats.transactions;
+        }
+        // Prefer the instrumented path whenever there is one, since the
+        // barriers are what we are here to count
+        if (prop & pr_instrumentedCode)
+            return a_runInstrumentedCode;
+        go_irrevocable(irr_at_begin, __builtin_return_address(0));
+        return a_runUninstrumentedCode;
+    }
+
+    void ITM_REGPARM _ITM_commitTransaction()
+    {
+        if (--self.nesting == 0) {
+            pthread_mutex_unlock(&global_lock);
+            run_commit_actions();
+        }
+    }
+
+    void ITM_REGPARM _ITM_commitTransactionEH(void*)
+    {
+        _ITM_commitTransaction();
+    }
+
+    void ITM_REGPARM _ITM_abortTransaction(_ITM_abortReason)
+    {
+        _ITM_error("the counting TM runtime cannot roll back a transaction", 0);
+    }
+
+    void ITM_REGPARM _ITM_changeTransactionMode(_ITM_transactionState)
+    {
+        go_irrevocable(irr_unsafe_call, __builtin_return_address(0));
+    }
+
+    _ITM_howExecuting ITM_REGPARM _ITM_inTransaction()
+    {
+        if (self.nesting == 0)
+            return outsideTransaction;
+        return self.irrevocable ? inIrrevocableTransaction
+                                : inRetryableTransaction;
+    }
+
+    _ITM_transactionId_t ITM_REGPARM _ITM_getTransactionId()
+    {
+        return self.nesting ? self.id : _ITM_noTransactionId;
+    }
+
+    void ITM_REGPARM _ITM_addUserCommitAction(_ITM_userCommitFunction fn,
+                                              _ITM_transactionId_t, void* arg)
+    {
+        if (self.commit_count == self.commit_capacity) {
+            self.commit_capacity = self.commit_capacity ? 2 * self.commit_capacity : 8;
+            self.commit_actions = (user_action*)
+                realloc(self.commit_actions,
+                        self.commit_capacity * sizeof(user_action));
+        }
+        self.commit_actions[self.commit_count].fn = fn;
+        self.commit_actions[self.commit_count].arg = arg;
+        ++self.commit_count;
+    }
+
+    /// Undo actions only run on abort, which never happens here
+    void ITM_REGPARM _ITM_addUserUndoAction(_ITM_userUndoFunction, void*) { }
+
+    void ITM_REGPARM _ITM_dropReferences(void*, size_t) { }
+
+    void* ITM_REGPARM _ITM_malloc(size_t size)
+    {
+        ++self.stats.allocs;
+        return malloc(size);
+    }
+
+    void* ITM_REGPARM _ITM_calloc(size_t n, size_t size)
+    {
+        ++self.stats.allocs;
+        return calloc(n, size);
+    }
+
+    void ITM_REGPARM _ITM_free(void* p)
+    {
+        ++self.stats.frees;
+        free(p);
+    }
+
+    void* ITM_REGPARM _ITM_getTMCloneOrIrrevocable(void* fn)
+    {
+        ++self.stats.indirect;
+        void* clone = itm_find_clone(fn);
+        if (clone)
+            return clone;
+        go_irrevocable(irr_indirect_call, __builtin_return_address(0));
+        return fn;
+    }
+
+    void* ITM_REGPARM _ITM_getTMCloneSafe(void* fn)
+    {
+        ++self.stats.indirect;
+        void* clone = itm_find_clone(fn);
+        if (!clone)
+            _ITM_error("transaction_safe function pointer has no clone", 0);
+        return clone;
+    }
+
+    int ITM_REGPARM _ITM_versionCompatible(int) { return 1; }
+
+    const char* ITM_REGPARM _ITM_libraryVersion()
+    {
+        return "tm_stl counting runtime";
+    }
+
+    void ITM_REGPARM _ITM_error(const char* msg, int code)
+    {
+        fprintf(stderr, "TM runtime error: %s (%d)\n", msg, code);
+        abort();
+    }
+}
+
+/*** Barriers: every one does the access in place and bumps a counter */
+
+#define COUNT_BARRIERS(SUFFIX, T, ATTR)                                       \
+    ATTR T ITM_REGPARM _ITM_R##SUFFIX(const T* p)                             \
+    { ++self.stats.reads; return *p; }                                        \
+    ATTR T ITM_REGPARM _ITM_RaR##SUFFIX(const T* p)                           \
+    { ++self.stats.reads; return *p; }                                        \
+    ATTR T ITM_REGPARM _ITM_RaW##SUFFIX(const T* p)                           \
+    { ++self.stats.reads; return *p; }                                        \
+    ATTR T ITM_REGPARM _ITM_RfW##SUFFIX(const T* p)                           \
+    { ++self.stats.reads; return *p; }                                        \
+    ATTR void ITM_REGPARM _ITM_W##SUFFIX(T* p, T v)                           \
+    { ++self.stats.writes; *p = v; }                                          \
+    ATTR void ITM_REGPARM _ITM_WaR##SUFFIX(T* p, T v)                         \
+    { ++self.stats.writes; *p = v; }                                          \
+    ATTR void ITM_REGPARM _ITM_WaW##SUFFIX(T* p, T v)                         \
+    { ++self.stats.writes; *p = v; }                                          \
+    ATTR void ITM_REGPARM _ITM_L##SUFFIX(const T*)                            \
+    { ++self.stats.logs; }
+
+#define COUNT_PLAIN_BARRIERS(SUFFIX, T) COUNT_BARRIERS(SUFFIX, T, )
+
+/// Like the functions they replace, memory transfers and memsets return
+/// dst, and GCC relies on it
+#define COUNT_MEMTRANSFER(NAME, FN)                                           \
+    void* ITM_REGPARM _ITM_##NAME(void* dst, const void* src, size_t n)       \
+    { ++self.stats.memtransfers; return __builtin_##FN(dst, src, n); }
+
+#define COUNT_MEMTRANSFERS(FN)                                                \
+    COUNT_MEMTRANSFER(FN##RnWt, FN)     COUNT_MEMTRANSFER(FN##RnWtaR, FN)     \
+    COUNT_MEMTRANSFER(FN##RnWtaW, FN)   COUNT_MEMTRANSFER(FN##RtWn, FN)       \
+    COUNT_MEMTRANSFER(FN##RtWt, FN)     COUNT_MEMTRANSFER(FN##RtWtaR, FN)     \
+    COUNT_MEMTRANSFER(FN##RtWtaW, FN)   COUNT_MEMTRANSFER(FN##RtaRWn, FN)     \
+    COUNT_MEMTRANSFER(FN##RtaRWt, FN)   COUNT_MEMTRANSFER(FN##RtaRWtaR, FN)   \
+    COUNT_MEMTRANSFER(FN##RtaRWtaW, FN) COUNT_MEMTRANSFER(FN##RtaWWn, FN)     \
+    COUNT_MEMTRANSFER(FN##RtaWWt, FN)   COUNT_MEMTRANSFER(FN##RtaWWtaR, FN)   \
+    COUNT_MEMTRANSFER(FN##RtaWWtaW, FN)
+
+#define COUNT_MEMSET(NAME)                                                    \
+    void* ITM_REGPARM _ITM_##NAME(void* dst, int c, size_t n)                 \
+    { ++self.stats.memsets; return __builtin_memset(dst, c, n); }
+
+extern "C"
+{
+    ITM_FOR_EACH_TYPE(COUNT_PLAIN_BARRIERS)
+    COUNT_BARRIERS(M256, _ITM_TYPE_M256, __attribute__((target("avx"))))
+
+    void ITM_REGPARM _ITM_LB(const void*, size_t) { ++self.stats.logs; }
+
+    COUNT_MEMTRANSFERS(memcpy)
+    COUNT_MEMTRANSFERS(memmove)
+    COUNT_MEMSET(memsetW)
+    COUNT_MEMSET(memsetWaR)
+    COUNT_MEMSET(memsetWaW)
+}
+
+/*** Exceptions: nothing is rolled back, so just forward to the C++ ABI */
+
+extern "C"
+{
+    void* __cxa_allocate_exception(size_t);
+    void __cxa_free_exception(void*);
+    void __cxa_throw(void*, void*, void (*)(void*)) ITM_NORETURN;
+    void* __cxa_begin_catch(void*);
+    void __cxa_end_catch();
+
+    void* _ITM_cxa_allocate_exception(size_t size)
+    {
+        return __cxa_allocate_exception(size);
+    }
+
+    void _ITM_cxa_free_exception(void* exc)
+    {
+        __cxa_free_exception(exc);
+    }
+
+    void _ITM_cxa_throw(void* obj, void* tinfo, void (*dest)(void*))
+    {
+        __cxa_throw(obj, tinfo, dest);
+    }
+
+    void* _ITM_cxa_begin_catch(void* exc)
+    {
+        return __cxa_begin_catch(exc);
+    }
+
+    void _ITM_cxa_end_catch()
+    {
+        __cxa_end_catch();
+    }
+}
+
+/*** Transactional operator new and delete */
+
+extern "C"
+{
+    void* _ZGTtnwX(size_t size)
+    {
+        ++self.stats.allocs;
+        return ::operator new(size);
+    }
+
+    void* _ZGTtnaX(size_t size)
+    {
+        ++self.stats.allocs;
+        return ::operator new[](size);
+    }
+
+    void* _ZGTtnwX_nt(size_t size, const void*)
+    {
+        ++self.stats.allocs;
+        return ::operator new(size, std::nothrow);
+    }
+
+    void* _ZGTtnaX_nt(size_t size, const void*)
+    {
+        ++self.stats.allocs;
+        return ::operator new[](size, std::nothrow);
+    }
+
+    void _ZGTtdlPv(void* p)
+    {
+        ++self.stats.frees;
+        ::operator delete(p);
+    }
+
+    void _ZGTtdaPv(void* p)
+    {
+        ++self.stats.frees;
+        ::operator delete[](p);
+    }
+
+    void _ZGTtdlPvRKSt9nothrow_t(void* p, const void*)
+    {
+        ++self.stats.frees;
+        ::operator delete(p);
+    }
+
+    void _ZGTtdaPvRKSt9nothrow_t(void* p, const void*)
+    {
+        ++self.stats.frees;
+        ::operator delete[](p);
+    }
+
+    void _ZGTtdlPvX(void* p, size_t)
+    {
+        ++self.stats.frees;
+        ::operator delete(p);
+    }
+
+    void _ZGTtdlPvX_nt(void* p, size_t, const void*)
+    {
+        ++self.stats.frees;
+        ::operator delete(p);
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ * The serial-irrevocable profiler (see irrprof.h).
+ *
+ * Switches are rare, and each one stalls every other transaction, so it
+ * costs comparatively little to take a backtrace and a lock for each.
+ * Backtraces are counted in a fixed-size table, so that recording does not
+ * allocate, and symbols are only looked up when the report is printed.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <link.h>
+#include <pthread.h>
+#include "irrprof.h"
+
+namespace
+{
+    /// Frames kept per backtrace, starting at the call site
+    const int DEPTH = 8;
+
+    /// Frames we take to find the call site, which may be below a few
+    /// runtime frames
+    const int RAW_DEPTH = 64;
+
+    /// Distinct backtraces we can tell apart; a power of two
+    const unsigned SITES = 1024;
+
+    /// Switches with the same reason and backtrace
+    struct site
+    {
+        unsigned long count;
+        irr_reason    why;
+        void*         frames[DEPTH]; // unused frames are null
+    };
+
+    site          sites[SITES];
+    unsigned      site_count = 0;
+    unsigned long total = 0;
+    unsigned long dropped = 0;       // switches whose backtrace didn't fit
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    bool           enabled = false;
+    pthread_once_t enabled_once = PTHREAD_ONCE_INIT;
+
+    const char* const reason_names[] = {
+        "at begin", "unsafe call", "indirect call", "contention"
+    };
+
+    /// Ask addr2line for the function and line at addr in module.  Symbols
+    /// that the dynamic linker can't see (everything in an executable that
+    /// wasn't linked with -rdynamic) can only be found this way.  Without
+    /// debug information, addr2line's guess is the nearest exported symbol,
+    /// which is usually wrong, so we only trust it if it knows the line.
+    bool addr2line(const char* module, unsigned long addr)
+    {
+        char cmd[4096];
+        snprintf(cmd, sizeof(cmd), "addr2line -C -f -e '%s' 0x%lx 2>/dev/null",
+                 module, addr);
+        FILE* p = popen(cmd, "r");
+        if (!p)
+            return false;
+        char fn[2048], line[2048];
+        bool ok = fgets(fn, sizeof(fn), p) && fgets(line, sizeof(line), p)
+               && strncmp(line, "??", 2) != 0;
+        pclose(p);
+        if (ok) {
+            fn[strcspn(fn, "\n")] = 0;
+            line[strcspn(line, "\n")] = 0;
+            fprintf(stderr, "%s at %s ", fn, line);
+        }
+        return ok;
+    }
+
+    /// Print "function+offset (module:address)" for the instruction that
+    /// made the call that returns to pc.  The address is what addr2line -e
+    /// module expects.
+    void print_frame(void* pc)
+    {
+        const char* at = (const char*)pc - 1;
+        Dl_info info;
+        if (!dladdr(at, &info) || !info.dli_fbase) {
+            fprintf(stderr, "%p", (void*)at);
+            return;
+        }
+        // shared objects and position-independent executables are loaded
+        // at an offset; other executables are not
+        const ElfW(Ehdr)* ehdr = (const ElfW(Ehdr)*)info.dli_fbase;
+        unsigned long addr = (unsigned long)at;
+        if (ehdr->e_type == ET_DYN)
+            addr -= (unsigned long)info.dli_fbase;
+        const char* module = info.dli_fname;
+        if (!module || !*module)
+            module = program_invocation_name;
+        if (info.dli_sname) {
+            int status;
+            char* name = abi::__cxa_demangle(info.dli_sname, NULL, NULL, &status);
+            fprintf(stderr, "%s+0x%lx ", name ? name : info.dli_sname,
+                    (unsigned long)(at - (const char*)info.dli_saddr));
+            free(name);
+        }
+        else {
+            addr2line(module, addr);
+        }
+        fprintf(stderr, "(%s:0x%lx)", module, addr);
+    }
+
+    int by_count(const void* a, const void* b)
+    {
+        unsigned long ca = (*(const site* const*)a)->count;
+        unsigned long cb = (*(const site* const*)b)->count;
+        return ca < cb ? 1 : ca > cb ? -1 : 0;
+    }
+
+    /// Print every call site, most frequent first
+    void report()
+    {
+        pthread_mutex_lock(&lock);
+        if (total == 0) {
+            pthread_mutex_unlock(&lock);
+            return;
+        }
+        const site* order[SITES];
+        unsigned n = 0;
+        for (unsigned i = 0; i < SITES; ++i)
+            if (sites[i].count)
+                order[n++] = &sites[i];
+        qsort(order, n, sizeof(order[0]), by_count);
+
+        fprintf(stderr, "\nTM: %lu switches to serial-irrevocable mode, from %u "
+                "call sites\n", total, site_count);
+        for (unsigned i = 0; i < n; ++i) {
+            fprintf(stderr, "%10lu  %s\n", order[i]->count,
+                    reason_names[order[i]->why]);
+            for (int f = 0; f < DEPTH && order[i]->frames[f]; ++f) {
+                fprintf(stderr, "              %s ", f ? "from" : "at  ");
+                print_frame(order[i]->frames[f]);
+                fprintf(stderr, "\n");
+            }
+        }
+        if (dropped)
+            fprintf(stderr, "%10lu  at call sites that did not fit in the "
+                    "table\n", dropped);
+        pthread_mutex_unlock(&lock);
+    }
+
+    void init()
+    {
+        const char* env = getenv("TM_IRREVOCABLE_REPORT");
+        enabled = !env || strcmp(env, "0") != 0;
+        if (!enabled)
+            return;
+        // the first backtrace loads the unwinder, so get that out of the way
+        void* frame;
+        backtrace(&frame, 1);
+        atexit(report);
+    }
+}
+
+extern "C" void irr_record(irr_reason why, void* site_pc)
+{
+    pthread_once(&enabled_once, init);
+    if (!enabled)
+        return;
+
+    // keep the frames from the call site up, or just the call site if it
+    // is not on the stack (a restart unwinds to the start of the
+    // transaction before the switch)
+    void* raw[RAW_DEPTH];
+    int n = backtrace(raw, RAW_DEPTH);
+    int first = 0;
+    while (first < n && raw[first] != site_pc)
+        ++first;
+    site s;
+    memset(&s, 0, sizeof(s));
+    s.why = why;
+    if (first == n)
+        s.frames[0] = site_pc;
+    else
+        for (int f = 0; f < DEPTH && first + f < n; ++f)
+            s.frames[f] = raw[first + f];
+
+    uintptr_t hash = why;
+    for (int f = 0; f < DEPTH; ++f)
+        hash = (hash ^ (uintptr_t)s.frames[f]) * 0x9e3779b1u;
+
+    pthread_mutex_lock(&lock);
+    ++total;
+    unsigned i = hash & (SITES - 1);
+    for (unsigned probes = 0; probes < SITES; ++probes, i = (i + 1) & (SITES - 1)) {
+        if (sites[i].count == 0) {
+            sites[i] = s;
+            ++site_count;
+        }
+        else if (sites[i].why != why
+                 || memcmp(sites[i].frames, s.frames, sizeof(s.frames)) != 0) {
+            continue;
+        }
+        ++sites[i].count;
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    ++dropped;
+    pthread_mutex_unlock(&lock);
+}
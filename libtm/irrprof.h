@@ -0,0 +1,36 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Profiling of switches to serial-irrevocable mode (irrprof.cc).
+ *
+ * A transaction that calls code with no transactional clone, or that keeps
+ * aborting, finishes by running alone, and every other transaction in the
+ * program waits for it.  Nothing in the output says that this happened.
+ * The runtimes in this folder report each such switch here, along with the
+ * address in the program that caused it, and at exit we print how many
+ * switches each call site caused, with a symbolized backtrace for each, so
+ * that the worst offenders can be fixed first.
+ *
+ * Set TM_IRREVOCABLE_REPORT=0 in the environment to turn this off.
+ */
+
+/// Why a transaction became serial-irrevocable
+enum irr_reason
+{
+    irr_at_begin,      // it had no instrumented code path, or the compiler
+                       // knew that it would go irrevocable
+    irr_unsafe_call,   // _ITM_changeTransactionMode, before a call to code
+                       // that is not transaction-safe
+    irr_indirect_call, // a call through a pointer to a function with no
+                       // clone
+    irr_contention     // it aborted too many times in a row
+};
+
+/**
+ * Count one switch to serial-irrevocable mode.  site is a return address
+ * in the code that asked for it: the return address of the ABI call that
+ * made the switch, or of _ITM_beginTransaction.  The backtrace starts at
+ * that frame, if it is on the current stack.
+ */
+extern "C" void irr_record(irr_reason why, void* site);
@@ -0,0 +1,184 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Declarations for the GCC transactional memory ABI (the interface that
+ * -fgnu-tm code calls, and that libitm implements).  The runtimes in this
+ * folder implement this interface so that the validation programs can link
+ * against them instead of the libitm that ships with $(GCC5INSTALL).
+ *
+ * The barrier entry points come in families that differ only in the type
+ * they move, so they are generated with the ITM_FOR_EACH_TYPE X-macro.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __i386__
+#  define ITM_REGPARM __attribute__((regparm(2)))
+#else
+#  define ITM_REGPARM
+#endif
+
+#define ITM_NORETURN __attribute__((noreturn))
+
+/// 64 bits, as in libitm, so that the argument lists of the user action
+/// entry points match on i386 too
+typedef uint64_t _ITM_transactionId_t;
+
+/// The id _ITM_getTransactionId returns outside of a transaction
+#define _ITM_noTransactionId 1
+
+/// Properties that the compiler passes to _ITM_beginTransaction
+enum _ITM_codeProperties
+{
+    pr_instrumentedCode     = 0x0001,
+    pr_uninstrumentedCode   = 0x0002,
+    pr_multiwayCode         = pr_instrumentedCode | pr_uninstrumentedCode,
+    pr_hasNoXMMUpdate       = 0x0004,
+    pr_hasNoAbort           = 0x0008,
+    pr_hasNoRetry           = 0x0010,
+    pr_hasNoIrrevocable     = 0x0020,
+    pr_doesGoIrrevocable    = 0x0040,
+    pr_hasNoSimpleReads     = 0x0080,
+    pr_aWBarriersOmitted    = 0x0100,
+    pr_RaRBarriersOmitted   = 0x0200,
+    pr_undoLogCode          = 0x0400,
+    pr_preferUninstrumented = 0x0800,
+    pr_exceptionBlock       = 0x1000,
+    pr_hasElse              = 0x2000,
+    pr_readOnly             = 0x4000,
+    pr_hasNoSimpleWrites    = 0x8000
+};
+
+/// What _ITM_beginTransaction tells the compiled code to do next
+enum _ITM_actions
+{
+    a_runInstrumentedCode   = 0x01,
+    a_runUninstrumentedCode = 0x02,
+    a_saveLiveVariables     = 0x04,
+    a_restoreLiveVariables  = 0x08,
+    a_abortTransaction      = 0x10
+};
+
+enum _ITM_abortReason
+{
+    userAbort           = 1,
+    userRetry           = 2,
+    TMConflict          = 4,
+    exceptionBlockAbort = 8,
+    outerAbort          = 16
+};
+
+enum _ITM_howExecuting
+{
+    outsideTransaction,
+    inRetryableTransaction,
+    inIrrevocableTransaction
+};
+
+enum _ITM_transactionState
+{
+    modeSerialIrrevocable
+};
+
+typedef void (*_ITM_userUndoFunction)(void*);
+typedef void (*_ITM_userCommitFunction)(void*);
+
+/// The vector types used by the M64/M128/M256 barriers
+typedef int   _ITM_TYPE_M64  __attribute__((vector_size(8), may_alias));
+typedef float _ITM_TYPE_M128 __attribute__((vector_size(16), may_alias));
+typedef float _ITM_TYPE_M256 __attribute__((vector_size(32), may_alias));
+
+/// X-macro over (suffix, type) for every barrier type.  M256 is left out of
+/// the list, since it needs AVX; runtimes define those by hand.
+#define ITM_FOR_EACH_TYPE(X)                    \
+    X(U1, uint8_t)                              \
+    X(U2, uint16_t)                             \
+    X(U4, uint32_t)                             \
+    X(U8, uint64_t)                             \
+    X(F, float)                                 \
+    X(D, double)                                \
+    X(E, long double)                           \
+    X(CF, float _Complex)                       \
+    X(CD, double _Complex)                      \
+    X(CE, long double _Complex)                 \
+    X(M64, _ITM_TYPE_M64)                       \
+    X(M128, _ITM_TYPE_M128)
+
+/// The transactional clones of operator new/delete have size_t in their
+/// mangled names
+#ifdef __LP64__
+#  define _ZGTtnwX      _ZGTtnwm
+#  define _ZGTtnaX      _ZGTtnam
+#  define _ZGTtnwX_nt   _ZGTtnwmRKSt9nothrow_t
+#  define _ZGTtnaX_nt   _ZGTtnamRKSt9nothrow_t
+#  define _ZGTtdlPvX    _ZGTtdlPvm
+#  define _ZGTtdlPvX_nt _ZGTtdlPvmRKSt9nothrow_t
+#else
+#  define _ZGTtnwX      _ZGTtnwj
+#  define _ZGTtnaX      _ZGTtnaj
+#  define _ZGTtnwX_nt   _ZGTtnwjRKSt9nothrow_t
+#  define _ZGTtnaX_nt   _ZGTtnajRKSt9nothrow_t
+#  define _ZGTtdlPvX    _ZGTtdlPvj
+#  define _ZGTtdlPvX_nt _ZGTtdlPvjRKSt9nothrow_t
+#endif
+
+extern "C"
+{
+    // transaction boundaries
+    uint32_t _ITM_beginTransaction(uint32_t, ...) ITM_REGPARM;
+    void _ITM_commitTransaction() ITM_REGPARM;
+    void _ITM_commitTransactionEH(void*) ITM_REGPARM;
+    void _ITM_abortTransaction(_ITM_abortReason) ITM_REGPARM ITM_NORETURN;
+    void _ITM_changeTransactionMode(_ITM_transactionState) ITM_REGPARM;
+    _ITM_howExecuting _ITM_inTransaction() ITM_REGPARM;
+    _ITM_transactionId_t _ITM_getTransactionId() ITM_REGPARM;
+
+    // user actions
+    void _ITM_addUserCommitAction(_ITM_userCommitFunction,
+                                  _ITM_transactionId_t, void*) ITM_REGPARM;
+    void _ITM_addUserUndoAction(_ITM_userUndoFunction, void*) ITM_REGPARM;
+    void _ITM_dropReferences(void*, size_t) ITM_REGPARM;
+
+    // memory management
+    void* _ITM_malloc(size_t) ITM_REGPARM;
+    void* _ITM_calloc(size_t, size_t) ITM_REGPARM;
+    void _ITM_free(void*) ITM_REGPARM;
+
+    // clone tables
+    void _ITM_registerTMCloneTable(void*, size_t);
+    void _ITM_deregisterTMCloneTable(void*);
+    void* _ITM_getTMCloneOrIrrevocable(void*) ITM_REGPARM;
+    void* _ITM_getTMCloneSafe(void*) ITM_REGPARM;
+
+    // exceptions
+    void* _ITM_cxa_allocate_exception(size_t);
+    void _ITM_cxa_free_exception(void*);
+    void _ITM_cxa_throw(void*, void*, void (*)(void*)) ITM_NORETURN;
+    void* _ITM_cxa_begin_catch(void*);
+    void _ITM_cxa_end_catch();
+
+    // miscellany
+    int _ITM_versionCompatible(int) ITM_REGPARM;
+    const char* _ITM_libraryVersion() ITM_REGPARM;
+    void _ITM_error(const char*, int) ITM_REGPARM ITM_NORETURN;
+
+    // transactional operator new/delete
+    void* _ZGTtnwX(size_t);
+    void* _ZGTtnaX(size_t);
+    void* _ZGTtnwX_nt(size_t, const void*);
+    void* _ZGTtnaX_nt(size_t, const void*);
+    void _ZGTtdlPv(void*);
+    void _ZGTtdaPv(void*);
+    void _ZGTtdlPvRKSt9nothrow_t(void*, const void*);
+    void _ZGTtdaPvRKSt9nothrow_t(void*, const void*);
+    void _ZGTtdlPvX(void*, size_t);
+    void _ZGTtdlPvX_nt(void*, size_t, const void*);
+}
+
+/**
+ * Clone table lookup, from clonetable.cc.  Returns the transactional clone
+ * of fn, or null if fn has none.
+ */
+void* itm_find_clone(void* fn);
@@ -0,0 +1,60 @@
+/**
+ * The serial-irrevocable profiler (irrprof.h), for programs that use libitm.
+ *
+ * libitm cannot be changed, so this overrides the two ABI calls through
+ * which compiled code asks to become irrevocable part of the way through a
+ * transaction, records the request, and passes it on to libitm's version.
+ * Linked into an executable, these definitions take precedence over
+ * libitm's for the executable and for every shared library it loads.
+ *
+ * Two kinds of switch are invisible from here: transactions that libitm
+ * runs irrevocably from the start (because they have no instrumented code
+ * path), and those that libitm makes irrevocable because they keep
+ * aborting.  The in-tree runtimes (libstm.a and libtmcount.a) record all
+ * four kinds.
+ */
+
+#include <dlfcn.h>
+#include "irrprof.h"
+#include "itm.h"
+
+namespace
+{
+    /// Find the definition of an ABI function that we are hiding
+    void* next_definition(const char* name)
+    {
+        void* fn = dlsym(RTLD_NEXT, name);
+        if (!fn)
+            _ITM_error("the libitm shim could not find libitm", 0);
+        return fn;
+    }
+
+    typedef void (*change_mode_fn)(_ITM_transactionState) ITM_REGPARM;
+    typedef void* (*get_clone_fn)(void*) ITM_REGPARM;
+}
+
+extern "C"
+{
+    void ITM_REGPARM _ITM_changeTransactionMode(_ITM_transactionState state)
+    {
+        static change_mode_fn next =
+            (change_mode_fn)next_definition("_ITM_changeTransactionMode");
+        if (_ITM_inTransaction() == inRetryableTransaction)
+            irr_record(irr_unsafe_call, __builtin_return_address(0));
+        next(state);
+    }
+
+    /// libitm switches modes internally when fn has no clone, so we can
+    /// only tell that it happened afterwards.  If libitm has to restart the
+    /// transaction to switch, which is rare, we never find out.
+    void* ITM_REGPARM _ITM_getTMCloneOrIrrevocable(void* fn)
+    {
+        static get_clone_fn next =
+            (get_clone_fn)next_definition("_ITM_getTMCloneOrIrrevocable");
+        bool retryable = _ITM_inTransaction() == inRetryableTransaction;
+        void* target = next(fn);
+        if (retryable && _ITM_inTransaction() == inIrrevocableTransaction)
+            irr_record(irr_indirect_call, __builtin_return_address(0));
+        return target;
+    }
+}
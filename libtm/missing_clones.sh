@@ -0,0 +1,58 @@
+#!/bin/sh
+#
+# List the functions that a library exports without a transactional clone.
+#
+# A transaction that calls one of these (through a declaration that is not
+# transaction_safe, or through a function pointer) has to become
+# serial-irrevocable, and stops every other transaction while it runs.  The
+# irrevocability report that the TM runtimes print at exit says which calls
+# actually did this; this says which ones could.
+#
+# Usage: missing_clones.sh [library [regex]]
+#
+# The library defaults to the 64-bit build of libstdc++_tm.  Only demangled
+# names that match the (extended) regex are printed, so that, for example,
+#
+#   ./missing_clones.sh ../libstdc++_tm/libstdc++-v3/src/obj64/libstdc++.so.6.0.21 _Rb_tree
+#
+# lists the tree helpers that have no clone.
+#
+
+lib=${1:-"$(dirname "$0")/../libstdc++_tm/libstdc++-v3/src/obj64/libstdc++.so.6.0.21"}
+regex=${2:-.}
+
+if [ ! -f "$lib" ]; then
+    echo "$0: $lib not found (build libstdc++_tm first)" >&2
+    exit 1
+fi
+
+# shared objects export through the dynamic symbol table; archives and
+# object files through the ordinary one
+case "$lib" in
+    *.so|*.so.*) nmflags="-D" ;;
+    *)           nmflags="" ;;
+esac
+
+# A clone is named _ZGTt followed by the mangled name of the original
+# without its _Z, or by the length and name of an extern "C" function.
+nm $nmflags --defined-only "$lib" |
+awk '$2 ~ /^[TWi]$/ {
+         name = $3
+         sub(/@.*/, "", name)
+         if (name ~ /^_ZGTt/)
+             clone[substr(name, 6)] = 1
+         else
+             fn[name] = 1
+     }
+     END {
+         for (name in fn) {
+             key = (name ~ /^_Z/) ? substr(name, 3) : length(name) name
+             if (!(key in clone))
+                 print name
+         }
+     }' |
+c++filt | grep -E -e "$regex" | sort > "${TMPDIR:-/tmp}/missing_clones.$$"
+
+cat "${TMPDIR:-/tmp}/missing_clones.$$"
+echo "$(wc -l < "${TMPDIR:-/tmp}/missing_clones.$$") exported functions without a transactional clone" >&2
+rm -f "${TMPDIR:-/tmp}/missing_clones.$$"
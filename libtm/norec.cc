@@ -0,0 +1,87 @@
+/**
+ * NOrec (Dalessandro, Spear and Scott, PPoPP 2010).
+ *
+ * There is no per-location metadata at all: one global sequence lock is odd
+ * while a writer commits, and readers validate by checking that every value
+ * they have read is still in memory.  Writes are buffered in the redo log,
+ * and at most one transaction writes back at a time.  Since readers never
+ * write shared metadata, read-mostly workloads scale well; since writers
+ * commit one at a time, write-heavy ones do not.
+ */
+
+#include "stm.h"
+
+namespace
+{
+    /// The global sequence lock
+    stm_word seqlock = 0;
+
+    /// Wait for the sequence lock to be even, then check every logged read.
+    /// Returns the time at which the read log was known to be consistent.
+    stm_word validate(stm_tx* tx)
+    {
+        unsigned spins = 0;
+        for (;;) {
+            stm_word t = __atomic_load_n(&seqlock, __ATOMIC_ACQUIRE);
+            if (t & 1) {
+                stm_spin(spins);
+                continue;
+            }
+            for (stm_read* r = tx->reads.begin(); r != tx->reads.end(); ++r)
+                if (stm_load((const stm_word*)r->addr) != r->val)
+                    stm_conflict(tx);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&seqlock, __ATOMIC_RELAXED) == t)
+                return t;
+        }
+    }
+
+    void begin(stm_tx* tx)
+    {
+        unsigned spins = 0;
+        while ((tx->start = __atomic_load_n(&seqlock, __ATOMIC_ACQUIRE)) & 1)
+            stm_spin(spins);
+    }
+
+    stm_word read(stm_tx* tx, const stm_word* addr)
+    {
+        stm_write* w = tx->writes.find(addr);
+        if (w && w->mask == ~(stm_word)0)
+            return w->val;
+        stm_word v = stm_load(addr);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        // if anyone committed since our snapshot, revalidate and read again
+        while (__atomic_load_n(&seqlock, __ATOMIC_RELAXED) != tx->start) {
+            tx->start = validate(tx);
+            v = stm_load(addr);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        }
+        stm_read r = { addr, v };
+        tx->reads.push(r);
+        return w ? (v & ~w->mask) | (w->val & w->mask) : v;
+    }
+
+    void write(stm_tx* tx, stm_word* addr, stm_word val, stm_word mask)
+    {
+        tx->writes.insert(addr, val, mask);
+    }
+
+    void commit(stm_tx* tx)
+    {
+        // read-only transactions were consistent as of their last read
+        if (tx->writes.empty())
+            return;
+        stm_word expected = tx->start;
+        while (!__atomic_compare_exchange_n(&seqlock, &expected, expected + 1,
+                                            false, __ATOMIC_ACQ_REL,
+                                            __ATOMIC_RELAXED))
+            expected = tx->start = validate(tx);
+        stm_writeback(tx);
+        __atomic_store_n(&seqlock, tx->start + 2, __ATOMIC_RELEASE);
+    }
+
+    /// Nothing reached memory, so there is nothing to undo
+    void rollback(stm_tx*) { }
+}
+
+const stm_algorithm stm_norec = { "norec", begin, read, write, commit, rollback };
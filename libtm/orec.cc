@@ -0,0 +1,41 @@
+/**
+ * The global clock and lock table that TL2 and undolog share.
+ *
+ * Sharing them means the two algorithms could even run side by side, but
+ * the runtime never does that: one algorithm is picked at startup.
+ */
+
+#include "stm.h"
+
+stm_word stm_clock = 0;
+stm_word stm_orecs[STM_OREC_COUNT];
+
+void stm_orec_validate(stm_tx* tx)
+{
+    stm_word mine = stm_lock_word(tx);
+    for (stm_read* r = tx->reads.begin(); r != tx->reads.end(); ++r) {
+        stm_word* orec = (stm_word*)r->addr;
+        stm_word o = __atomic_load_n(orec, __ATOMIC_ACQUIRE);
+        if (o == mine) {
+            // we locked it after reading it; what matters is whether it
+            // had changed before we did
+            if (!tx->stale_locks)
+                continue;
+            for (stm_lock* l = tx->locks.begin(); l != tx->locks.end(); ++l)
+                if (l->orec == orec) {
+                    o = l->old;
+                    break;
+                }
+        }
+        if ((o & 1) || (o >> 1) > tx->start)
+            stm_conflict(tx);
+    }
+}
+
+void stm_orec_release(stm_tx* tx, stm_word val)
+{
+    for (stm_lock* l = tx->locks.begin(); l != tx->locks.end(); ++l)
+        __atomic_store_n(l->orec, val ? val : l->old, __ATOMIC_RELEASE);
+    tx->locks.clear();
+    tx->stale_locks = 0;
+}
@@ -0,0 +1,816 @@
+/**
+ * The in-tree STM: the GCC TM ABI, on top of a pluggable algorithm.
+ *
+ * Everything that does not depend on how conflicts are detected lives
+ * here; see stm.h for the division of labor, and norec.cc, tl2.cc and
+ * undolog.cc for the algorithms.  The policies are simple ones:
+ *
+ *  - Nesting is flat.  A conflict anywhere restarts the outermost
+ *    transaction, and cancelling an inner transaction (other than with
+ *    __transaction_cancel [[outer]]) is a fatal error.
+ *
+ *  - Serial-irrevocable mode is a reader/writer lock: every transaction
+ *    holds it for reading, and a transaction that must become irrevocable
+ *    rolls back and restarts holding it for writing.  A transaction that
+ *    aborts SERIAL_AFTER_ABORTS times in a row does the same, so that it is
+ *    sure to finish.
+ *
+ *  - Memory freed by a transaction, and user commit actions, wait until
+ *    every transaction that was running when it committed has finished
+ *    (quiesce), so that those transactions never touch freed memory.
+ */
+
+#include <cstdio>
+#include <new>
+#include <pthread.h>
+#include <time.h>
+#include <unwind.h>
+#include "irrprof.h"
+#include "stm.h"
+
+extern "C"
+{
+    /// Called by _ITM_beginTransaction (sjlj.S) with its saved registers
+    uint32_t stm_begin(uint32_t prop, const stm_jmpbuf* jb)
+        ITM_REGPARM __attribute__((visibility("hidden")));
+
+    /// Resume at a checkpoint, making _ITM_beginTransaction return actions
+    void stm_longjmp(const stm_jmpbuf* jb, uint32_t actions)
+        ITM_REGPARM ITM_NORETURN __attribute__((visibility("hidden")));
+
+    /// From the C++ ABI
+    struct __cxa_eh_globals
+    {
+        void*    caughtExceptions;
+        unsigned uncaughtExceptions;
+    };
+    __cxa_eh_globals* __cxa_get_globals() throw();
+    void* __cxa_allocate_exception(size_t) throw();
+    void __cxa_free_exception(void*) throw();
+    void __cxa_throw(void*, void*, void (*)(void*)) ITM_NORETURN;
+    void* __cxa_begin_catch(void*) throw();
+    void __cxa_end_catch();
+}
+
+namespace
+{
+    /// Restart serially after this many consecutive aborts, unless the
+    /// transaction can cancel itself, which it could not do once serial
+    const unsigned SERIAL_AFTER_ABORTS = 64;
+
+    /// The algorithm, chosen when the first transaction starts
+    const stm_algorithm* algo = NULL;
+    pthread_once_t       algo_once = PTHREAD_ONCE_INIT;
+    char                 version[64];
+
+    void choose_algorithm()
+    {
+        const stm_algorithm* all[] = { &stm_norec, &stm_tl2, &stm_undolog };
+        const char* name = getenv("STM_ALGORITHM");
+        algo = all[0];
+        if (name && *name) {
+            algo = NULL;
+            for (unsigned i = 0; i < sizeof(all) / sizeof(all[0]); ++i)
+                if (!strcmp(name, all[i]->name))
+                    algo = all[i];
+            if (!algo) {
+                fprintf(stderr, "STM_ALGORITHM=%s: expected norec, tl2 or undolog\n",
+                        name);
+                exit(1);
+            }
+        }
+        snprintf(version, sizeof(version), "tm_stl STM (%s)", algo->name);
+    }
+
+    __thread stm_tx* self __attribute__((tls_model("initial-exec")));
+
+    /// Every descriptor ever made, for quiesce.  Descriptors are never
+    /// freed, so the list only ever grows at its head.
+    stm_tx* all_txs = NULL;
+
+    /// Source of stm_tx::active_since values.  Starts at 1, since 0 means
+    /// "not in a transaction".
+    uint64_t epoch = 1;
+
+    /// Source of transaction ids
+    _ITM_transactionId_t next_id = _ITM_noTransactionId + 1;
+
+    /// The serial lock: writer is set while a transaction runs serially,
+    /// and readers counts the transactions running concurrently
+    int      serial_writer = 0;
+    unsigned serial_readers = 0;
+
+    void serial_read_lock()
+    {
+        unsigned spins = 0;
+        for (;;) {
+            while (__atomic_load_n(&serial_writer, __ATOMIC_ACQUIRE))
+                stm_spin(spins);
+            __atomic_add_fetch(&serial_readers, 1, __ATOMIC_SEQ_CST);
+            if (!__atomic_load_n(&serial_writer, __ATOMIC_SEQ_CST))
+                return;
+            __atomic_sub_fetch(&serial_readers, 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    void serial_write_lock()
+    {
+        unsigned spins = 0;
+        while (__atomic_exchange_n(&serial_writer, 1, __ATOMIC_SEQ_CST))
+            stm_spin(spins);
+        while (__atomic_load_n(&serial_readers, __ATOMIC_SEQ_CST))
+            stm_spin(spins);
+    }
+
+    /// Get the calling thread's descriptor, making it on first use
+    stm_tx* get_tx()
+    {
+        if (self)
+            return self;
+        stm_tx* tx = (stm_tx*)calloc(1, sizeof(stm_tx));
+        pthread_attr_t attr;
+        void*  lo;
+        size_t size;
+        if (!tx || pthread_getattr_np(pthread_self(), &attr))
+            _ITM_error("cannot set up an STM descriptor", 0);
+        pthread_attr_getstack(&attr, &lo, &size);
+        pthread_attr_destroy(&attr);
+        tx->stack_lo = (const char*)lo;
+        tx->stack_hi = (const char*)lo + size;
+        tx->next = __atomic_load_n(&all_txs, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&all_txs, &tx->next, tx, false,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            ;
+        return self = tx;
+    }
+
+    uint64_t now_ns()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    }
+
+    /// Start an attempt at the outermost transaction, in the mode that
+    /// tx->serial says
+    void start_attempt(stm_tx* tx)
+    {
+        if (tx->serial) {
+            serial_write_lock();
+            tx->serial_since = now_ns();
+        }
+        else {
+            serial_read_lock();
+        }
+        __atomic_store_n(&tx->active_since,
+                         __atomic_load_n(&epoch, __ATOMIC_SEQ_CST),
+                         __ATOMIC_SEQ_CST);
+        if (!tx->serial)
+            algo->begin(tx);
+    }
+
+    /// End an attempt, whether it committed or not
+    void finish_attempt(stm_tx* tx)
+    {
+        __atomic_store_n(&tx->active_since, 0, __ATOMIC_RELEASE);
+        if (tx->serial) {
+            tx->stats.serial_ns += now_ns() - tx->serial_since;
+            __atomic_store_n(&serial_writer, 0, __ATOMIC_RELEASE);
+        }
+        else {
+            __atomic_sub_fetch(&serial_readers, 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    /// Wait until every transaction that started before now has finished
+    void quiesce(stm_tx* tx)
+    {
+        uint64_t now = __atomic_add_fetch(&epoch, 1, __ATOMIC_SEQ_CST);
+        for (stm_tx* t = __atomic_load_n(&all_txs, __ATOMIC_ACQUIRE); t; t = t->next) {
+            if (t == tx)
+                continue;
+            for (unsigned spins = 0; ; ) {
+                uint64_t since = __atomic_load_n(&t->active_since, __ATOMIC_SEQ_CST);
+                if (!since || since >= now)
+                    break;
+                stm_spin(spins);
+            }
+        }
+    }
+
+    /// Randomized exponential backoff after the n-th consecutive abort
+    void backoff(unsigned n)
+    {
+        uint64_t spins = __builtin_ia32_rdtsc() & ((1u << (n < 12 ? n : 12)) - 1);
+        while (spins--)
+            __builtin_ia32_pause();
+    }
+
+    /// Empty the logs of an attempt that has committed or rolled back
+    void clear_logs(stm_tx* tx)
+    {
+        tx->reads.clear();
+        tx->writes.clear();
+        tx->undo.clear();
+        tx->locals.clear();
+        tx->local_bytes.clear();
+        tx->undo_actions.clear();
+        tx->allocs.clear();
+        tx->blocks.clear();
+        tx->unthrown.clear();
+        tx->eh_in_flight = NULL;
+        tx->catch_depth = 0;
+    }
+
+    /// Undo everything the current attempt did, and end it
+    void rollback(stm_tx* tx)
+    {
+        if (!tx->serial)
+            algo->rollback(tx);
+        for (stm_local* l = tx->locals.end(); l != tx->locals.begin(); ) {
+            --l;
+            if (!stm_dead_stack(tx, l->addr))
+                memcpy(l->addr, tx->local_bytes.data + l->offset, l->len);
+        }
+        for (stm_action* a = tx->undo_actions.end(); a != tx->undo_actions.begin(); ) {
+            --a;
+            a->fn(a->arg);
+        }
+        for (stm_action* a = tx->allocs.begin(); a != tx->allocs.end(); ++a)
+            a->fn(a->arg);
+        for (void** e = tx->unthrown.begin(); e != tx->unthrown.end(); ++e)
+            __cxa_free_exception(*e);
+        if (tx->eh_in_flight)
+            _Unwind_DeleteException((_Unwind_Exception*)tx->eh_in_flight);
+        while (tx->catch_depth--)
+            __cxa_end_catch();
+        __cxa_get_globals()->uncaughtExceptions = tx->uncaught;
+        tx->frees.clear();
+        tx->commit_actions.clear();
+        clear_logs(tx);
+        finish_attempt(tx);
+    }
+
+    /// Roll back, and run the outermost transaction again; serially if
+    /// serial is set or if it keeps aborting
+    ITM_NORETURN void restart(stm_tx* tx, bool serial)
+    {
+        ++tx->stats.aborts[serial ? stm_abort_serialize : stm_abort_conflict];
+        rollback(tx);
+        if (!serial && ++tx->aborts >= SERIAL_AFTER_ABORTS
+            && (tx->prop & pr_hasNoAbort)) {
+            serial = true;
+            irr_record(irr_contention, tx->checkpoint.pc);
+        }
+        if (!serial)
+            backoff(tx->aborts);
+        tx->serial = serial;
+        tx->nesting = 1;
+        start_attempt(tx);
+        uint32_t actions = (serial && (tx->prop & pr_uninstrumentedCode))
+                         ? a_runUninstrumentedCode : a_runInstrumentedCode;
+        stm_longjmp(&tx->checkpoint, actions | a_restoreLiveVariables);
+    }
+
+    /// Become serial-irrevocable, for the reason given, at the request of
+    /// the code that returns to site
+    void go_serial(irr_reason why, void* site)
+    {
+        stm_tx* tx = self;
+        if (!tx->serial) {
+            irr_record(why, site);
+            restart(tx, true);
+        }
+    }
+
+    /// Run a log of actions that the thread may add to while they run
+    void run_actions(stm_log<stm_action>& log)
+    {
+        stm_log<stm_action> actions = log;
+        memset(&log, 0, sizeof(log));
+        for (stm_action* a = actions.begin(); a != actions.end(); ++a)
+            a->fn(a->arg);
+        if (!log.data) {
+            actions.clear();
+            log = actions;
+        }
+        else {
+            free(actions.data);
+        }
+    }
+
+    /*** Barriers, in terms of the algorithm's word accesses */
+
+    /// Save a local so that it can be put back if we abort
+    void log_local(const void* addr, size_t len)
+    {
+        stm_tx* tx = self;
+        if (tx->serial)
+            return;
+        stm_local l = { (void*)addr, len, tx->local_bytes.size };
+        tx->locals.push(l);
+        while (tx->local_bytes.capacity < tx->local_bytes.size + len)
+            tx->local_bytes.grow();
+        memcpy(tx->local_bytes.data + tx->local_bytes.size, addr, len);
+        tx->local_bytes.size += len;
+    }
+
+    /**
+     * Is addr memory that no other thread can see: this thread's stack, or
+     * a block that this transaction allocated?  GCC accesses such
+     * ("captured") memory without barriers in the function that allocates
+     * it, but with barriers in the functions it calls, so barriers must
+     * access it in place, or the buffered algorithms would hand out stale
+     * values.  This means that objects on a thread's stack must not be
+     * shared with other threads' transactions.
+     */
+    bool captured(const stm_tx* tx, const void* addr)
+    {
+        const char* a = (const char*)addr;
+        if (a >= tx->stack_lo && a < tx->stack_hi)
+            return true;
+        size_t lo = 0, hi = tx->blocks.size;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (a < tx->blocks.data[mid].begin)
+                hi = mid;
+            else if (a >= tx->blocks.data[mid].end)
+                lo = mid + 1;
+            else
+                return true;
+        }
+        return false;
+    }
+
+    void read_range(stm_tx* tx, const void* addr, void* out, size_t len)
+    {
+        if (captured(tx, addr)) {
+            memcpy(out, addr, len);
+            return;
+        }
+        size_t off = (uintptr_t)addr % sizeof(stm_word);
+        const stm_word* w = (const stm_word*)((uintptr_t)addr - off);
+        char* o = (char*)out;
+        while (len) {
+            size_t n = sizeof(stm_word) - off < len ? sizeof(stm_word) - off : len;
+            stm_word v = algo->read(tx, w);
+            memcpy(o, (char*)&v + off, n);
+            o += n;
+            len -= n;
+            off = 0;
+            ++w;
+        }
+    }
+
+    void write_range(stm_tx* tx, void* addr, const void* in, size_t len)
+    {
+        if (captured(tx, addr)) {
+            // new blocks are released on abort, and dead frames don't
+            // matter, but the frames above the transaction must be restored
+            if (addr >= tx->checkpoint.cfa && addr < tx->stack_hi)
+                log_local(addr, len);
+            memcpy(addr, in, len);
+            return;
+        }
+        size_t off = (uintptr_t)addr % sizeof(stm_word);
+        stm_word* w = (stm_word*)((uintptr_t)addr - off);
+        const char* i = (const char*)in;
+        while (len) {
+            size_t n = sizeof(stm_word) - off < len ? sizeof(stm_word) - off : len;
+            stm_word v = 0, mask = 0;
+            memcpy((char*)&v + off, i, n);
+            memset((char*)&mask + off, 0xff, n);
+            algo->write(tx, w, v, mask);
+            i += n;
+            len -= n;
+            off = 0;
+            ++w;
+        }
+    }
+
+    void read_bytes(const void* addr, void* out, size_t len)
+    {
+        stm_tx* tx = self;
+        if (tx->serial)
+            memcpy(out, addr, len);
+        else
+            read_range(tx, addr, out, len);
+    }
+
+    void write_bytes(void* addr, const void* in, size_t len)
+    {
+        stm_tx* tx = self;
+        if (tx->serial)
+            memcpy(addr, in, len);
+        else
+            write_range(tx, addr, in, len);
+    }
+
+    /// memcpy/memmove where either side may be transactional.  Copies go
+    /// through a bounce buffer, in whichever direction is safe for overlap.
+    void transfer(void* dst, const void* src, size_t n, bool rtx, bool wtx)
+    {
+        stm_tx* tx = self;
+        if (tx->serial) {
+            memmove(dst, src, n);
+            return;
+        }
+        if (!wtx) {
+            read_range(tx, src, dst, n);
+            return;
+        }
+        char buf[256];
+        bool backward = (char*)dst > (char*)src && (char*)dst < (char*)src + n;
+        for (size_t done = 0; done < n; ) {
+            size_t k = n - done < sizeof(buf) ? n - done : sizeof(buf);
+            size_t off = backward ? n - done - k : done;
+            if (rtx)
+                read_range(tx, (const char*)src + off, buf, k);
+            else
+                memcpy(buf, (const char*)src + off, k);
+            write_range(tx, (char*)dst + off, buf, k);
+            done += k;
+        }
+    }
+
+    void set(void* dst, int c, size_t n)
+    {
+        stm_tx* tx = self;
+        if (tx->serial) {
+            memset(dst, c, n);
+            return;
+        }
+        char buf[256];
+        memset(buf, c, n < sizeof(buf) ? n : sizeof(buf));
+        for (size_t done = 0; done < n; ) {
+            size_t k = n - done < sizeof(buf) ? n - done : sizeof(buf);
+            write_range(tx, (char*)dst + done, buf, k);
+            done += k;
+        }
+    }
+
+    /*** Allocation: new memory is released on abort, freed memory on commit */
+
+    void* log_alloc(void* p, size_t size, void (*release)(void*))
+    {
+        stm_tx* tx = self;
+        if (!p || tx->serial)
+            return p;
+        stm_action a = { release, p };
+        tx->allocs.push(a);
+        // keep blocks sorted, for captured()
+        stm_block b = { (const char*)p, (const char*)p + size };
+        tx->blocks.push(b);
+        stm_block* i = tx->blocks.end() - 1;
+        for (; i != tx->blocks.begin() && (i - 1)->begin > b.begin; --i)
+            *i = *(i - 1);
+        *i = b;
+        return p;
+    }
+
+    void defer_free(void* p, void (*release)(void*))
+    {
+        stm_tx* tx = self;
+        if (!p)
+            return;
+        if (tx->serial) {
+            release(p);
+            return;
+        }
+        stm_action a = { release, p };
+        tx->frees.push(a);
+    }
+
+    /// Forget an exception that is no longer ours to free
+    void forget_unthrown(void* exc)
+    {
+        stm_log<void*>& log = self->unthrown;
+        for (void** e = log.begin(); e != log.end(); ++e)
+            if (*e == exc) {
+                *e = log.data[--log.size];
+                return;
+            }
+    }
+
+    void delete_scalar(void* p) { ::operator delete(p); }
+    void delete_array(void* p)  { ::operator delete[](p); }
+}
+
+void stm_conflict(stm_tx* tx)
+{
+    restart(tx, false);
+}
+
+void stm_writeback(stm_tx* tx)
+{
+    for (stm_write* w = tx->writes.entries.begin(); w != tx->writes.entries.end(); ++w)
+        if (!stm_dead_stack(tx, w->addr))
+            stm_store(w->addr, w->val, w->mask);
+}
+
+extern "C"
+{
+    uint32_t stm_begin(uint32_t prop, const stm_jmpbuf* jb)
+    {
+        pthread_once(&algo_once, choose_algorithm);
+        stm_tx* tx = get_tx();
+
+        // flat nesting: an inner transaction runs as part of the outer one
+        if (tx->nesting++ > 0) {
+            if (tx->serial)
+                return (prop & pr_uninstrumentedCode) ? a_runUninstrumentedCode
+                                                      : a_runInstrumentedCode;
+            if (!(prop & pr_instrumentedCode)) {
+                irr_record(irr_at_begin, jb->pc);
+                restart(tx, true);
+            }
+            return a_runInstrumentedCode;
+        }
+
+        tx->checkpoint = *jb;
+        tx->prop = prop;
+        tx->id = __atomic_fetch_add(&next_id, 1, __ATOMIC_RELAXED);
+        tx->aborts = 0;
+        tx->uncaught = __cxa_get_globals()->uncaughtExceptions;
+        tx->serial = (prop & pr_doesGoIrrevocable) || !(prop & pr_instrumentedCode);
+        start_attempt(tx);
+        if (tx->serial) {
+            irr_record(irr_at_begin, jb->pc);
+            return (prop & pr_uninstrumentedCode) ? a_runUninstrumentedCode
+                                                  : a_runInstrumentedCode;
+        }
+        return a_runInstrumentedCode | a_saveLiveVariables;
+    }
+
+    void ITM_REGPARM _ITM_commitTransaction()
+    {
+        stm_tx* tx = self;
+        if (tx->nesting > 1) {
+            --tx->nesting;
+            return;
+        }
+        if (!tx->serial)
+            algo->commit(tx);
+        bool was_serial = tx->serial;
+        ++tx->stats.commits;
+        if (was_serial)
+            ++tx->stats.serial_commits;
+        tx->stats.reads += tx->reads.size;
+        tx->stats.writes += tx->writes.entries.size + tx->undo.size;
+        clear_logs(tx);
+        finish_attempt(tx);
+        tx->nesting = 0;
+        tx->serial = false;
+        if (!was_serial && (!tx->frees.empty() || !tx->commit_actions.empty()))
+            quiesce(tx);
+        for (stm_action* a = tx->frees.begin(); a != tx->frees.end(); ++a)
+            a->fn(a->arg);
+        tx->frees.clear();
+        run_actions(tx->commit_actions);
+    }
+
+    void ITM_REGPARM _ITM_commitTransactionEH(void* exc)
+    {
+        self->eh_in_flight = exc;
+        _ITM_commitTransaction();
+    }
+
+    void ITM_REGPARM _ITM_abortTransaction(_ITM_abortReason reason)
+    {
+        stm_tx* tx = self;
+        if (tx->serial)
+            _ITM_error("an irrevocable transaction cannot abort", reason);
+        if (!(reason & userAbort))
+            restart(tx, false);
+        if (tx->nesting > 1 && !(reason & outerAbort))
+            _ITM_error("nesting is flat: only the outermost transaction can be "
+                       "cancelled", reason);
+        ++tx->stats.aborts[stm_abort_cancel];
+        rollback(tx);
+        tx->nesting = 0;
+        stm_longjmp(&tx->checkpoint, a_abortTransaction | a_restoreLiveVariables);
+    }
+
+    void ITM_REGPARM _ITM_changeTransactionMode(_ITM_transactionState)
+    {
+        go_serial(irr_unsafe_call, __builtin_return_address(0));
+    }
+
+    void stm_get_stats(stm_stats* out)
+    {
+        stm_tx* tx = self;
+        if (tx)
+            *out = tx->stats;
+        else
+            memset(out, 0, sizeof(*out));
+    }
+
+    _ITM_howExecuting ITM_REGPARM _ITM_inTransaction()
+    {
+        stm_tx* tx = self;
+        if (!tx || tx->nesting == 0)
+            return outsideTransaction;
+        return tx->serial ? inIrrevocableTransaction : inRetryableTransaction;
+    }
+
+    _ITM_transactionId_t ITM_REGPARM _ITM_getTransactionId()
+    {
+        stm_tx* tx = self;
+        return (tx && tx->nesting) ? tx->id : _ITM_noTransactionId;
+    }
+
+    void ITM_REGPARM _ITM_addUserCommitAction(_ITM_userCommitFunction fn,
+                                              _ITM_transactionId_t, void* arg)
+    {
+        stm_action a = { fn, arg };
+        self->commit_actions.push(a);
+    }
+
+    void ITM_REGPARM _ITM_addUserUndoAction(_ITM_userUndoFunction fn, void* arg)
+    {
+        stm_action a = { fn, arg };
+        self->undo_actions.push(a);
+    }
+
+    void ITM_REGPARM _ITM_dropReferences(void*, size_t) { }
+
+    void* ITM_REGPARM _ITM_malloc(size_t size)
+    {
+        return log_alloc(malloc(size), size, free);
+    }
+
+    void* ITM_REGPARM _ITM_calloc(size_t n, size_t size)
+    {
+        return log_alloc(calloc(n, size), n * size, free);
+    }
+
+    void ITM_REGPARM _ITM_free(void* p)
+    {
+        defer_free(p, free);
+    }
+
+    void* ITM_REGPARM _ITM_getTMCloneOrIrrevocable(void* fn)
+    {
+        void* clone = itm_find_clone(fn);
+        if (clone)
+            return clone;
+        go_serial(irr_indirect_call, __builtin_return_address(0));
+        return fn;
+    }
+
+    void* ITM_REGPARM _ITM_getTMCloneSafe(void* fn)
+    {
+        void* clone = itm_find_clone(fn);
+        if (!clone)
+            _ITM_error("transaction_safe function pointer has no clone", 0);
+        return clone;
+    }
+
+    int ITM_REGPARM _ITM_versionCompatible(int) { return 1; }
+
+    const char* ITM_REGPARM _ITM_libraryVersion()
+    {
+        pthread_once(&algo_once, choose_algorithm);
+        return version;
+    }
+
+    void ITM_REGPARM _ITM_error(const char* msg, int code)
+    {
+        fprintf(stderr, "TM runtime error: %s (%d)\n", msg, code);
+        abort();
+    }
+}
+
+/*** Barriers */
+
+#define STM_BARRIERS(SUFFIX, T, ATTR)                                         \
+    ATTR T ITM_REGPARM _ITM_R##SUFFIX(const T* p)                             \
+    { T v; read_bytes(p, &v, sizeof(T)); return v; }                          \
+    ATTR T ITM_REGPARM _ITM_RaR##SUFFIX(const T* p)                           \
+    { T v; read_bytes(p, &v, sizeof(T)); return v; }                          \
+    ATTR T ITM_REGPARM _ITM_RaW##SUFFIX(const T* p)                           \
+    { T v; read_bytes(p, &v, sizeof(T)); return v; }                          \
+    ATTR T ITM_REGPARM _ITM_RfW##SUFFIX(const T* p)                           \
+    { T v; read_bytes(p, &v, sizeof(T)); return v; }                          \
+    ATTR void ITM_REGPARM _ITM_W##SUFFIX(T* p, T v)                           \
+    { write_bytes(p, &v, sizeof(T)); }                                        \
+    ATTR void ITM_REGPARM _ITM_WaR##SUFFIX(T* p, T v)                         \
+    { write_bytes(p, &v, sizeof(T)); }                                        \
+    ATTR void ITM_REGPARM _ITM_WaW##SUFFIX(T* p, T v)                         \
+    { write_bytes(p, &v, sizeof(T)); }                                        \
+    ATTR void ITM_REGPARM _ITM_L##SUFFIX(const T* p)                          \
+    { log_local(p, sizeof(T)); }
+
+#define STM_PLAIN_BARRIERS(SUFFIX, T) STM_BARRIERS(SUFFIX, T, )
+
+/// Memory transfers are named for whether each side is transactional: Rn
+/// reads non-transactional memory, Rt/RtaR/RtaW transactional memory.
+/// Like the functions they replace, they return dst, and GCC relies on it.
+#define STM_MEMTRANSFER(FN, NAME, RTX, WTX)                                   \
+    void* ITM_REGPARM _ITM_##FN##NAME(void* dst, const void* src, size_t n)   \
+    { transfer(dst, src, n, RTX, WTX); return dst; }
+
+#define STM_MEMTRANSFERS(FN)                                                  \
+    STM_MEMTRANSFER(FN, RnWt, false, true)                                    \
+    STM_MEMTRANSFER(FN, RnWtaR, false, true)                                  \
+    STM_MEMTRANSFER(FN, RnWtaW, false, true)                                  \
+    STM_MEMTRANSFER(FN, RtWn, true, false)                                    \
+    STM_MEMTRANSFER(FN, RtWt, true, true)                                     \
+    STM_MEMTRANSFER(FN, RtWtaR, true, true)                                   \
+    STM_MEMTRANSFER(FN, RtWtaW, true, true)                                   \
+    STM_MEMTRANSFER(FN, RtaRWn, true, false)                                  \
+    STM_MEMTRANSFER(FN, RtaRWt, true, true)                                   \
+    STM_MEMTRANSFER(FN, RtaRWtaR, true, true)                                 \
+    STM_MEMTRANSFER(FN, RtaRWtaW, true, true)                                 \
+    STM_MEMTRANSFER(FN, RtaWWn, true, false)                                  \
+    STM_MEMTRANSFER(FN, RtaWWt, true, true)                                   \
+    STM_MEMTRANSFER(FN, RtaWWtaR, true, true)                                 \
+    STM_MEMTRANSFER(FN, RtaWWtaW, true, true)
+
+#define STM_MEMSET(NAME)                                                      \
+    void* ITM_REGPARM _ITM_##NAME(void* dst, int c, size_t n)                 \
+    { set(dst, c, n); return dst; }
+
+extern "C"
+{
+    ITM_FOR_EACH_TYPE(STM_PLAIN_BARRIERS)
+    STM_BARRIERS(M256, _ITM_TYPE_M256, __attribute__((target("avx"))))
+
+    void ITM_REGPARM _ITM_LB(const void* p, size_t n) { log_local(p, n); }
+
+    STM_MEMTRANSFERS(memcpy)
+    STM_MEMTRANSFERS(memmove)
+    STM_MEMSET(memsetW)
+    STM_MEMSET(memsetWaR)
+    STM_MEMSET(memsetWaW)
+}
+
+/*** Exceptions: remember what to undo if the transaction aborts */
+
+extern "C"
+{
+    void* _ITM_cxa_allocate_exception(size_t size)
+    {
+        void* exc = __cxa_allocate_exception(size);
+        self->unthrown.push(exc);
+        return exc;
+    }
+
+    void _ITM_cxa_free_exception(void* exc)
+    {
+        forget_unthrown(exc);
+        __cxa_free_exception(exc);
+    }
+
+    void _ITM_cxa_throw(void* obj, void* tinfo, void (*dest)(void*))
+    {
+        forget_unthrown(obj);
+        __cxa_throw(obj, tinfo, dest);
+    }
+
+    void* _ITM_cxa_begin_catch(void* exc)
+    {
+        ++self->catch_depth;
+        return __cxa_begin_catch(exc);
+    }
+
+    void _ITM_cxa_end_catch()
+    {
+        if (self->catch_depth)
+            --self->catch_depth;
+        __cxa_end_catch();
+    }
+}
+
+/*** Transactional operator new and delete */
+
+extern "C"
+{
+    void* _ZGTtnwX(size_t size)
+    {
+        return log_alloc(::operator new(size), size, delete_scalar);
+    }
+
+    void* _ZGTtnaX(size_t size)
+    {
+        return log_alloc(::operator new[](size), size, delete_array);
+    }
+
+    void* _ZGTtnwX_nt(size_t size, const void*)
+    {
+        return log_alloc(::operator new(size, std::nothrow), size, delete_scalar);
+    }
+
+    void* _ZGTtnaX_nt(size_t size, const void*)
+    {
+        return log_alloc(::operator new[](size, std::nothrow), size,
+                         delete_array);
+    }
+
+    void _ZGTtdlPv(void* p)                                { defer_free(p, delete_scalar); }
+    void _ZGTtdaPv(void* p)                                { defer_free(p, delete_array); }
+    void _ZGTtdlPvRKSt9nothrow_t(void* p, const void*)     { defer_free(p, delete_scalar); }
+    void _ZGTtdaPvRKSt9nothrow_t(void* p, const void*)     { defer_free(p, delete_array); }
+    void _ZGTtdlPvX(void* p, size_t)                       { defer_free(p, delete_scalar); }
+    void _ZGTtdlPvX_nt(void* p, size_t, const void*)       { defer_free(p, delete_scalar); }
+}
@@ -0,0 +1,340 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Internal interface of the in-tree STM (libstm.a).
+ *
+ * stm.cc implements the GCC TM ABI once, for every algorithm: checkpoints
+ * and flat nesting, rollback of logged locals, allocations, exceptions and
+ * user actions, serial-irrevocable mode, and privatization safety.  Every
+ * barrier is split into accesses to aligned machine words, and what happens
+ * to those words is up to the algorithm.  The algorithm is picked when the
+ * first transaction starts, from the STM_ALGORITHM environment variable:
+ *
+ *   norec   - (default) a global sequence lock and value-based validation;
+ *             writes are buffered until commit
+ *   tl2     - a global version clock and a table of versioned locks;
+ *             writes are buffered, and their locks are taken at commit
+ *   undolog - the same clock and locks, but locks are taken as writes
+ *             happen, memory is updated in place, and old values are kept
+ *             in an undo log
+ *
+ * Descriptors and logs are plain old data, zero-initialized by calloc, so
+ * nothing here depends on constructor order.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <sched.h>
+#include "itm.h"
+#include "stmstats.h"
+
+/// The unit that algorithms track: an aligned machine word
+typedef uintptr_t stm_word;
+
+/// The registers that a checkpoint restores (see sjlj.S for the layout)
+struct stm_jmpbuf
+{
+    void*    cfa;  // the caller's stack pointer, once the call returns
+#ifdef __x86_64__
+    stm_word rbx, rbp, r12, r13, r14, r15;
+#else
+    stm_word ebx, esi, edi, ebp;
+#endif
+    void*    pc;   // the return address of _ITM_beginTransaction
+};
+
+/// A growable array of plain old data.  It never shrinks, so a thread's
+/// logs stop allocating once they have seen its largest transaction.
+template <typename T>
+struct stm_log
+{
+    T*     data;
+    size_t size;
+    size_t capacity;
+
+    void push(const T& t)
+    {
+        if (size == capacity)
+            grow();
+        data[size++] = t;
+    }
+
+    void grow()
+    {
+        capacity = capacity ? 2 * capacity : 64;
+        data = (T*)realloc(data, capacity * sizeof(T));
+        if (!data)
+            _ITM_error("out of memory for an STM log", 0);
+    }
+
+    T*   begin() const { return data; }
+    T*   end()   const { return data + size; }
+    bool empty() const { return size == 0; }
+    void clear()       { size = 0; }
+};
+
+/// A read log entry.  NOrec logs a word and the value it held; the
+/// lock-based algorithms log the lock that covers the word.
+struct stm_read
+{
+    const void* addr;
+    stm_word    val;
+};
+
+/// A buffered write: the bytes of val under mask are to be stored to addr
+struct stm_write
+{
+    stm_word* addr;
+    stm_word  val;
+    stm_word  mask;
+    size_t    slot; // where the index points at this entry
+};
+
+/**
+ * The redo log of the buffered algorithms: an array of writes, in program
+ * order, with an open-addressing index on the word address so that reads
+ * can find earlier writes.
+ */
+struct stm_writeset
+{
+    stm_log<stm_write> entries;
+    uint32_t*          index;      // entry number + 1, or 0 for empty
+    size_t             index_size; // a power of two
+
+    size_t slot_of(const stm_word* addr) const
+    {
+        return ((uintptr_t)addr / sizeof(stm_word)) & (index_size - 1);
+    }
+
+    stm_write* find(const stm_word* addr) const
+    {
+        if (entries.empty())
+            return NULL;
+        for (size_t s = slot_of(addr); index[s]; s = (s + 1) & (index_size - 1))
+            if (entries.data[index[s] - 1].addr == addr)
+                return &entries.data[index[s] - 1];
+        return NULL;
+    }
+
+    void insert(stm_word* addr, stm_word val, stm_word mask)
+    {
+        if (stm_write* w = find(addr)) {
+            w->val = (w->val & ~mask) | (val & mask);
+            w->mask |= mask;
+            return;
+        }
+        if (2 * (entries.size + 1) > index_size)
+            rehash();
+        size_t s = slot_of(addr);
+        while (index[s])
+            s = (s + 1) & (index_size - 1);
+        stm_write w = { addr, val, mask, s };
+        entries.push(w);
+        index[s] = entries.size;
+    }
+
+    void rehash()
+    {
+        free(index);
+        index_size = index_size ? 2 * index_size : 256;
+        index = (uint32_t*)calloc(index_size, sizeof(uint32_t));
+        if (!index)
+            _ITM_error("out of memory for an STM write set", 0);
+        for (size_t i = 0; i < entries.size; ++i) {
+            size_t s = slot_of(entries.data[i].addr);
+            while (index[s])
+                s = (s + 1) & (index_size - 1);
+            entries.data[i].slot = s;
+            index[s] = i + 1;
+        }
+    }
+
+    bool empty() const { return entries.empty(); }
+
+    void clear()
+    {
+        for (stm_write* w = entries.begin(); w != entries.end(); ++w)
+            index[w->slot] = 0;
+        entries.clear();
+    }
+};
+
+/// A lock taken by the current transaction, and its value before we took it
+struct stm_lock
+{
+    stm_word* orec;
+    stm_word  old;
+};
+
+/// The old value of a word that undolog updated in place
+struct stm_undo
+{
+    stm_word* addr;
+    stm_word  val;
+};
+
+/// A stack or local variable logged by _ITM_L*; its bytes are in
+/// stm_tx::local_bytes starting at offset
+struct stm_local
+{
+    void*  addr;
+    size_t len;
+    size_t offset;
+};
+
+/// A block of memory allocated by the current transaction
+struct stm_block
+{
+    const char* begin;
+    const char* end;
+};
+
+/// A user action, or the release of an allocation
+struct stm_action
+{
+    void (*fn)(void*);
+    void* arg;
+};
+
+/// Per-thread transaction descriptor
+struct stm_tx
+{
+    unsigned             nesting;     // 0 when not in a transaction
+    bool                 serial;      // running serial-irrevocably
+    uint32_t             prop;        // properties of the outermost begin
+    _ITM_transactionId_t id;
+    stm_jmpbuf           checkpoint;  // where a restart resumes
+    const char*          stack_lo;    // this thread's stack
+    const char*          stack_hi;
+    stm_word             start;       // algorithm's start time / snapshot
+    unsigned             aborts;      // consecutive aborts of this transaction
+
+    // algorithm logs
+    stm_log<stm_read>    reads;
+    stm_writeset         writes;
+    stm_log<stm_lock>    locks;
+    stm_log<stm_undo>    undo;
+    unsigned             stale_locks; // locks whose old version is > start
+
+    // logs that every algorithm needs
+    stm_log<stm_local>   locals;
+    stm_log<char>        local_bytes;
+    stm_log<stm_action>  commit_actions;
+    stm_log<stm_action>  undo_actions;
+    stm_log<stm_action>  allocs;      // released if we abort
+    stm_log<stm_block>   blocks;      // the same allocations, sorted
+    stm_log<stm_action>  frees;       // released if we commit
+
+    // C++ exception state to put back if we abort
+    stm_log<void*>       unthrown;    // allocated, not yet thrown
+    void*                eh_in_flight;
+    unsigned             catch_depth;
+    unsigned             uncaught;
+
+    // statistics (see stmstats.h)
+    stm_stats            stats;
+    uint64_t             serial_since; // when the serial attempt started
+
+    /// The epoch in which the current attempt started, or 0 outside of a
+    /// transaction; see quiesce in stm.cc
+    uint64_t             active_since;
+    stm_tx*              next;        // all descriptors ever made
+};
+
+/**
+ * An STM algorithm.  read returns the current value of a word as the
+ * transaction sees it, and write buffers or performs a write of the bytes
+ * of val selected by mask.  Any of the functions may call stm_conflict to
+ * abort and restart the transaction; rollback then undoes whatever the
+ * algorithm did.
+ */
+struct stm_algorithm
+{
+    const char* name;
+    void     (*begin)(stm_tx*);
+    stm_word (*read)(stm_tx*, const stm_word*);
+    void     (*write)(stm_tx*, stm_word*, stm_word val, stm_word mask);
+    void     (*commit)(stm_tx*);
+    void     (*rollback)(stm_tx*);
+};
+
+extern const stm_algorithm stm_norec;
+extern const stm_algorithm stm_tl2;
+extern const stm_algorithm stm_undolog;
+
+/// Roll back the current transaction and restart it
+void stm_conflict(stm_tx* tx) ITM_NORETURN;
+
+/// Wait for another thread: spin for a while, then start giving up the CPU,
+/// in case the thread we are waiting for is not running
+inline void stm_spin(unsigned& spins)
+{
+    if (++spins < 128)
+        __builtin_ia32_pause();
+    else
+        sched_yield();
+}
+
+/// Plain loads and stores of shared words, which other threads may be
+/// accessing concurrently
+inline stm_word stm_load(const stm_word* addr)
+{
+    return __atomic_load_n(addr, __ATOMIC_RELAXED);
+}
+
+/**
+ * True if addr is in the part of this thread's stack below the frame that
+ * began the transaction.  Anything there belongs to a frame that has
+ * already returned (or to the runtime itself), so writes to it must not be
+ * replayed at commit or undone at abort.
+ */
+inline bool stm_dead_stack(const stm_tx* tx, const void* addr)
+{
+    return (const char*)addr >= tx->stack_lo
+        && (const char*)addr < (const char*)tx->checkpoint.cfa;
+}
+
+/// Store the bytes of val selected by mask to addr
+inline void stm_store(stm_word* addr, stm_word val, stm_word mask)
+{
+    if (mask == ~(stm_word)0) {
+        __atomic_store_n(addr, val, __ATOMIC_RELAXED);
+        return;
+    }
+    for (unsigned i = 0; i < sizeof(stm_word); ++i)
+        if ((mask >> (8 * i)) & 0xff)
+            __atomic_store_n((uint8_t*)addr + i, (uint8_t)(val >> (8 * i)),
+                             __ATOMIC_RELAXED);
+}
+
+/// Replay the redo log to memory
+void stm_writeback(stm_tx* tx);
+
+/*** Shared by the lock-based algorithms (orec.cc) */
+
+/// The global version clock
+extern stm_word stm_clock;
+
+/// The table of versioned locks ("ownership records").  An unlocked orec
+/// holds version << 1; a locked one holds the owner's descriptor | 1.
+#define STM_OREC_COUNT (1 << 20)
+extern stm_word stm_orecs[STM_OREC_COUNT];
+
+inline stm_word* stm_orec_for(const void* addr)
+{
+    return &stm_orecs[((uintptr_t)addr / sizeof(stm_word)) % STM_OREC_COUNT];
+}
+
+inline stm_word stm_lock_word(const stm_tx* tx)
+{
+    return (stm_word)tx | 1;
+}
+
+/// Check that no orec in the read log has changed since tx->start, and
+/// call stm_conflict if one has
+void stm_orec_validate(stm_tx* tx);
+
+/// Release every lock in tx->locks, setting each orec to val, or to the
+/// value it had before we locked it if val is 0
+void stm_orec_release(stm_tx* tx, stm_word val);
@@ -0,0 +1,39 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Statistics kept by the in-tree STM (stm.cc).
+ *
+ * Counters are per thread and cumulative; take a snapshot before and after
+ * a transaction and subtract.  Read and write sets are measured in log
+ * entries when a transaction commits: words (NOrec) or locks (TL2,
+ * undolog) read, and words buffered (NOrec, TL2) or saved for undo
+ * (undolog).  Transactions that run serially keep no logs, so they add
+ * nothing to either.
+ *
+ * Only libstm.a defines stm_get_stats, so it is declared weak: programs
+ * that may be linked against another runtime must check that it is not
+ * null before calling it.
+ */
+
+/// Why an attempt at a transaction was rolled back
+enum stm_abort_reason
+{
+    stm_abort_conflict,  // it conflicted with another transaction
+    stm_abort_serialize, // it restarted to run serial-irrevocably
+    stm_abort_cancel,    // __transaction_cancel
+    STM_ABORT_REASONS
+};
+
+struct stm_stats
+{
+    unsigned long      commits;                    // outermost transactions
+    unsigned long      serial_commits;             // ... that ran serially
+    unsigned long      aborts[STM_ABORT_REASONS];
+    unsigned long      reads;                      // read set entries
+    unsigned long      writes;                     // write set entries
+    unsigned long long serial_ns;                  // time spent serial
+};
+
+/// Copy the calling thread's counters into *out
+extern "C" void stm_get_stats(stm_stats* out) __attribute__((weak));
@@ -0,0 +1,80 @@
+/**
+ * TL2 (Dice, Shalev and Shavit, DISC 2006).
+ *
+ * Every word is covered by a versioned lock in the orec table.  A
+ * transaction reads the global clock when it starts, and a read is only
+ * valid if the word's orec is unlocked and no newer than that.  Writes are
+ * buffered; at commit the writer locks the orecs of its write set, takes a
+ * new time from the clock, revalidates its reads, writes back, and releases
+ * the orecs with the new time.  Unlike NOrec, disjoint writers commit in
+ * parallel, but every read also reads an orec.
+ */
+
+#include "stm.h"
+
+namespace
+{
+    void begin(stm_tx* tx)
+    {
+        tx->start = __atomic_load_n(&stm_clock, __ATOMIC_ACQUIRE);
+    }
+
+    stm_word read(stm_tx* tx, const stm_word* addr)
+    {
+        stm_write* w = tx->writes.find(addr);
+        if (w && w->mask == ~(stm_word)0)
+            return w->val;
+        stm_word* orec = stm_orec_for(addr);
+        stm_word o1 = __atomic_load_n(orec, __ATOMIC_ACQUIRE);
+        stm_word v = stm_load(addr);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        stm_word o2 = __atomic_load_n(orec, __ATOMIC_RELAXED);
+        if ((o1 & 1) || o1 != o2 || (o1 >> 1) > tx->start)
+            stm_conflict(tx);
+        stm_read r = { orec, 0 };
+        tx->reads.push(r);
+        return w ? (v & ~w->mask) | (w->val & w->mask) : v;
+    }
+
+    void write(stm_tx* tx, stm_word* addr, stm_word val, stm_word mask)
+    {
+        tx->writes.insert(addr, val, mask);
+    }
+
+    void commit(stm_tx* tx)
+    {
+        if (tx->writes.empty())
+            return;
+        stm_word mine = stm_lock_word(tx);
+        for (stm_write* w = tx->writes.entries.begin();
+             w != tx->writes.entries.end(); ++w)
+        {
+            stm_word* orec = stm_orec_for(w->addr);
+            stm_word o = __atomic_load_n(orec, __ATOMIC_RELAXED);
+            if (o == mine)
+                continue;
+            if ((o & 1) || !__atomic_compare_exchange_n(orec, &o, mine, false,
+                                                        __ATOMIC_ACQUIRE,
+                                                        __ATOMIC_RELAXED))
+                stm_conflict(tx);
+            stm_lock l = { orec, o };
+            tx->locks.push(l);
+            if ((o >> 1) > tx->start)
+                ++tx->stale_locks;
+        }
+        stm_word end = __atomic_add_fetch(&stm_clock, 1, __ATOMIC_ACQ_REL);
+        // if nobody else committed since we started, our reads are valid
+        if (end != tx->start + 1)
+            stm_orec_validate(tx);
+        stm_writeback(tx);
+        stm_orec_release(tx, end << 1);
+    }
+
+    /// Memory is untouched; just drop any locks commit took
+    void rollback(stm_tx* tx)
+    {
+        stm_orec_release(tx, 0);
+    }
+}
+
+const stm_algorithm stm_tl2 = { "tl2", begin, read, write, commit, rollback };
@@ -0,0 +1,30 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Interface to the counting TM runtime (count.cc).
+ *
+ * The counting runtime implements the GCC TM ABI by executing every
+ * transaction in place, under a single global lock, and counting what the
+ * instrumented code asks of it.  It never aborts, so the counts are exactly
+ * the instrumentation cost of one execution of each transaction.  Counters
+ * are per thread and cumulative; take a snapshot before and after a
+ * transaction and subtract.
+ */
+
+struct tmcount_stats
+{
+    unsigned long transactions; // outermost transactions begun
+    unsigned long reads;        // _ITM_R* read barriers
+    unsigned long writes;       // _ITM_W* write barriers
+    unsigned long logs;         // _ITM_L* undo-log requests
+    unsigned long memtransfers; // _ITM_memcpy* / _ITM_memmove*
+    unsigned long memsets;      // _ITM_memset*
+    unsigned long allocs;       // _ITM_malloc, _ITM_calloc, operator new
+    unsigned long frees;        // _ITM_free, operator delete
+    unsigned long indirect;     // calls through function pointers
+    unsigned long irrevocable;  // switches to serial-irrevocable mode
+};
+
+/// Copy the calling thread's counters into *out
+extern "C" void tmcount_get_stats(tmcount_stats* out);
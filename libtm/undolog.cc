@@ -0,0 +1,103 @@
+/**
+ * An eager, write-through STM with an undo log (in the style of TinySTM's
+ * write-through mode and libitm's ml_wt).
+ *
+ * It uses TL2's clock and orecs, but a writer locks each orec when it first
+ * writes a word covered by it, saves the word's old value, and updates
+ * memory in place.  Commit just takes a new time and releases the locks, so
+ * it is cheap; abort has to put the old values back, and takes a new time
+ * too, to release the locks with.  Reads of words we have written need no
+ * lookup, and a read that finds a newer version tries to extend the start
+ * time instead of aborting.
+ */
+
+#include "stm.h"
+
+namespace
+{
+    /// Move our start time forward to now, if every read is still valid
+    void extend(stm_tx* tx)
+    {
+        stm_word now = __atomic_load_n(&stm_clock, __ATOMIC_ACQUIRE);
+        stm_orec_validate(tx);
+        tx->start = now;
+    }
+
+    void begin(stm_tx* tx)
+    {
+        tx->start = __atomic_load_n(&stm_clock, __ATOMIC_ACQUIRE);
+    }
+
+    stm_word read(stm_tx* tx, const stm_word* addr)
+    {
+        stm_word* orec = stm_orec_for(addr);
+        stm_word o1 = __atomic_load_n(orec, __ATOMIC_ACQUIRE);
+        if (o1 == stm_lock_word(tx))
+            return stm_load(addr);
+        if (o1 & 1)
+            stm_conflict(tx);
+        stm_word v = stm_load(addr);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(orec, __ATOMIC_RELAXED) != o1)
+            stm_conflict(tx);
+        // o1 was written no later than the clock value extend reads, so
+        // once the rest of the read log is valid at that time, so is v
+        if ((o1 >> 1) > tx->start)
+            extend(tx);
+        stm_read r = { orec, 0 };
+        tx->reads.push(r);
+        return v;
+    }
+
+    void write(stm_tx* tx, stm_word* addr, stm_word val, stm_word mask)
+    {
+        stm_word* orec = stm_orec_for(addr);
+        stm_word mine = stm_lock_word(tx);
+        stm_word o = __atomic_load_n(orec, __ATOMIC_ACQUIRE);
+        if (o != mine) {
+            if (o & 1)
+                stm_conflict(tx);
+            // never hold a lock whose old version we could not have read
+            if ((o >> 1) > tx->start)
+                extend(tx);
+            if (!__atomic_compare_exchange_n(orec, &o, mine, false,
+                                             __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                stm_conflict(tx);
+            stm_lock l = { orec, o };
+            tx->locks.push(l);
+        }
+        stm_undo u = { addr, stm_load(addr) };
+        tx->undo.push(u);
+        stm_store(addr, val, mask);
+    }
+
+    void commit(stm_tx* tx)
+    {
+        if (tx->locks.empty())
+            return;
+        stm_word end = __atomic_add_fetch(&stm_clock, 1, __ATOMIC_ACQ_REL);
+        if (end != tx->start + 1)
+            stm_orec_validate(tx);
+        stm_orec_release(tx, end << 1);
+    }
+
+    /// Put back old values, newest first, then release the locks with a new
+    /// version.  They cannot go back to the versions they had: a reader
+    /// that loaded an orec before we locked it, and then a word that we
+    /// had written, would find the orec unchanged when it checked again,
+    /// and keep a value that was never committed.
+    void rollback(stm_tx* tx)
+    {
+        for (stm_undo* u = tx->undo.end(); u != tx->undo.begin(); ) {
+            --u;
+            if (!stm_dead_stack(tx, u->addr))
+                __atomic_store_n(u->addr, u->val, __ATOMIC_RELAXED);
+        }
+        if (tx->locks.empty())
+            return;
+        stm_word end = __atomic_add_fetch(&stm_clock, 1, __ATOMIC_ACQ_REL);
+        stm_orec_release(tx, end << 1);
+    }
+}
+
+const stm_algorithm stm_undolog = { "undolog", begin, read, write, commit, rollback };
@@ -1,5 +0,0 @@
-#include <mutex>
-#include "../common/tm.h"
-
-// constructor/destructor tests, from ctor.cc
-void ctor_test(int id);
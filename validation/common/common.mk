@@ -17,11 +17,15 @@ output_folder := $(shell mkdir -p $(ODIR))
 #
 # Names of files that the compiler generates
 #
-EXEFILES       = $(ODIR)/bench_tm $(ODIR)/bench_notm $(ODIR)/bench_trace
+EXEFILES       = $(ODIR)/bench_tm $(ODIR)/bench_notm $(ODIR)/bench_trace \
+                 $(ODIR)/bench_tmcount $(ODIR)/bench_prof
 TM_OFILES      = $(patsubst %, $(ODIR)/%_tm.o, $(CXXFILES))
 NOTM_OFILES    = $(patsubst %, $(ODIR)/%_notm.o, $(CXXFILES))
 TRACE_OFILES   = $(patsubst %, $(ODIR)/%_trace.o, $(CXXFILES))
-DEPS           = $(patsubst %.o, %.d, $(TM_OFILES) $(NOTM_OFILES) $(TRACE_OFILES))
+TMCOUNT_OFILES = $(patsubst %, $(ODIR)/%_tmcount.o, $(CXXFILES))
+PROF_OFILES    = $(patsubst %, $(ODIR)/%_prof.o, $(CXXFILES))
+DEPS           = $(patsubst %.o, %.d, $(TM_OFILES) $(NOTM_OFILES) $(TRACE_OFILES) \
+                                      $(TMCOUNT_OFILES) $(PROF_OFILES))
 
 #
 # Use g++ in C++11 mode to build the "original" nontransactional version of
@@ -54,15 +58,90 @@ CXXFLAGS_TRACE = -MD -O2 -ggdb -m$(BITS) -std=c++1y -nostdinc
                  -I$(GCC5INSTALL)/lib/gcc/x86_64-unknown-linux-gnu/5.0.0/include \
                  -DNO_TM -pthread
 
+#
+# Set TRACE_RECORD=1 to make the trace build also log every traced call to
+# the file named by $TRACE_RECORD_FILE (trace.log by default), for the replay
+# driver in ../replay.  "make clean" when switching.
+#
+TRACE_RECORD  ?= 0
+ifeq ($(TRACE_RECORD),1)
+CXXFLAGS_TRACE += -DTRACE_RECORD
+endif
+
+#
+# The prof build is the trace build, with each TRACE timing the method it is
+# in instead of counting it, so that it reports the hottest STL methods of a
+# run (see trace.h)
+#
+CXXFLAGS_PROF  = $(filter-out -DTRACE_RECORD, $(CXXFLAGS_TRACE)) -DTRACE_PROFILE
+
+#
+# Set TM_CACHE_HASH=1 to make every unordered container in the TM build cache
+# hash codes in its nodes, regardless of how cheap the hasher is (see
+# __cache_default in libstdc++_tm's hashtable.h)
+#
+TM_CACHE_HASH ?= 0
+ifeq ($(TM_CACHE_HASH),1)
+CXXFLAGS_TM   += -D_GLIBCXX_TM_CACHE_HASH_CODE
+endif
+
+#
+# Inside a transaction, the TM containers leave the teardown of what they
+# clear or destroy to a commit action (see libstdc++_tm's bits/tm_defer.h).
+# Set TM_NO_DEFER=1 to tear down in place instead, as the baseline that
+# validation/tmbulk compares with.  "make clean" when switching.
+#
+TM_NO_DEFER   ?= 0
+ifeq ($(TM_NO_DEFER),1)
+CXXFLAGS_TM   += -D_GLIBCXX_TM_NO_DEFER
+endif
+
+#
+# The tmcount build is the TM build, linked against the counting runtime in
+# ../../libtm instead of libitm, so that it reports the barriers each
+# transaction executes.  It should be run single-threaded.
+#
+CXXFLAGS_TMCOUNT = $(CXXFLAGS_TM) -DTM_COUNT -I../../libtm
+
 LDFLAGS_NOTM   = -m$(BITS) -L../../libstdc++/libstdc++-v3/src/obj$(BITS) -lstdc++ -pthread
 LDFLAGS_TM     = -m$(BITS) -fgnu-tm -L../../libstdc++_tm/libstdc++-v3/src/obj$(BITS) -lstdc++ -pthread
 LDFLAGS_TRACE  = -m$(BITS) -L../../libstdc++_trace/libstdc++-v3/src/obj$(BITS) -lstdc++ -pthread
+LDFLAGS_TMCOUNT = -m$(BITS) -L../../libstdc++_tm/libstdc++-v3/src/obj$(BITS)        \
+                  -Wl,--whole-archive ../../libtm/obj$(BITS)/libtmcount.a          \
+                  -Wl,--no-whole-archive -lstdc++ -pthread
+
+#
+# Choose the runtime that bench_tm links against: the libitm that comes with
+# $(GCC5INSTALL) (TM_RUNTIME=libitm, the default), or the STM in ../../libtm
+# (TM_RUNTIME=stm), whose algorithm is picked at startup by setting
+# STM_ALGORITHM to norec, tl2 or undolog.  Only the link changes, so "make
+# clean" when switching.
+#
+TM_RUNTIME ?= libitm
+ifeq ($(TM_RUNTIME),stm)
+LDFLAGS_TM     = -m$(BITS) -L../../libstdc++_tm/libstdc++-v3/src/obj$(BITS)        \
+                 -Wl,--whole-archive ../../libtm/obj$(BITS)/libstm.a               \
+                 -Wl,--no-whole-archive -lstdc++ -pthread
+endif
+
+#
+# The in-tree runtimes print, at exit, which call sites made transactions
+# serial-irrevocable and how often (see irrprof.h in ../../libtm).  Set
+# TM_IRREVOCABLE_PROFILE=1 to get the same report from a bench_tm that uses
+# libitm; it then links a shim that watches libitm's mode changes.
+#
+TM_IRREVOCABLE_PROFILE ?= 0
+ifeq ($(TM_RUNTIME)$(TM_IRREVOCABLE_PROFILE),libitm1)
+LDFLAGS_TM    += -Wl,--whole-archive ../../libtm/obj$(BITS)/libitmshim.a         \
+                 -Wl,--no-whole-archive -ldl
+endif
 
 #
 # Best to be safe...
 #
 .DEFAULT_GOAL  = all
-.PRECIOUS: $(TM_OFILES) $(NOTM_OFILES) $(TRACE_OFILES)
+.PRECIOUS: $(TM_OFILES) $(NOTM_OFILES) $(TRACE_OFILES) $(TMCOUNT_OFILES) \
+           $(PROF_OFILES)
 .PHONY: all clean
 
 #
@@ -73,7 +152,7 @@ all: $(EXEFILES)
 #
 # For skipping TM builds
 #
-notm: $(ODIR)/bench_notm $(ODIR)/bench_trace
+notm: $(ODIR)/bench_notm $(ODIR)/bench_trace $(ODIR)/bench_prof
 
 #
 # Rules for building .o files from sources
@@ -90,6 +169,14 @@ $(ODIR)/%_trace.o: %.cc
 	@echo "[CXX] $< --> $@"
 	@$(CXX) -c $< -o $@ $(CXXFLAGS_TRACE)
 
+$(ODIR)/%_tmcount.o: %.cc
+	@echo "[CXX] $< --> $@"
+	@$(CXX) -c $< -o $@ $(CXXFLAGS_TMCOUNT)
+
+$(ODIR)/%_prof.o: %.cc
+	@echo "[CXX] $< --> $@"
+	@$(CXX) -c $< -o $@ $(CXXFLAGS_PROF)
+
 #
 # Rules for building executables
 #
@@ -108,6 +195,16 @@ $(ODIR)/%_trace:$(ODIR)/%_trace.o
 	@echo "[LD] $^ --> $@"
 	@$(CXX) $^ -o $@ $(LDFLAGS_TRACE)
 
+$(ODIR)/bench_tmcount: $(TMCOUNT_OFILES)
+$(ODIR)/%_tmcount:$(ODIR)/%_tmcount.o
+	@echo "[LD] $^ --> $@"
+	@$(CXX) $^ -o $@ $(LDFLAGS_TMCOUNT)
+
+$(ODIR)/bench_prof: $(PROF_OFILES)
+$(ODIR)/%_prof:$(ODIR)/%_prof.o
+	@echo "[LD] $^ --> $@"
+	@$(CXX) $^ -o $@ $(LDFLAGS_TRACE)
+
 #
 # We'll be lazy... to clean, we'll just clobber the build folder
 #
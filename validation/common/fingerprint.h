@@ -0,0 +1,99 @@
+// -*-c++-*-
+#pragma once
+
+#include <initializer_list>
+
+/**
+ * A running fingerprint of the values that a verifier (in each driver's
+ * verify.h) has been given, so that a container of any size can be checked
+ * in one pass over it, in constant space, without a copy of it.  It keeps
+ * a count, a commutative hash (the sum of the mixed values, which is the
+ * same for every order of the same multiset), and an ordered hash (a
+ * polynomial in the mixed values, which also depends on their order).
+ * Fingerprints of different contents can only match if 64-bit hashes
+ * collide.
+ */
+class fingerprint
+{
+    /// number of elements added
+    unsigned long      count;
+
+    /// sum of the mixed elements
+    unsigned long long unordered;
+
+    /// the mixed elements, as a polynomial in MULT
+    unsigned long long ordered;
+
+    /// odd, so that the ordered hash never loses bits
+    static const unsigned long long MULT = 0x9e3779b97f4a7c15ULL;
+
+    /// the splitmix64 finalizer: every bit of x affects every bit of the
+    /// result, so that sums of nearby values do not cancel out
+    static unsigned long long mix(unsigned long long x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+  public:
+    fingerprint() : count(0), unordered(0), ordered(0) { }
+
+    /// add one element
+    void add(long long x)
+    {
+        unsigned long long h = mix(x);
+        ++count;
+        unordered += h;
+        ordered = ordered * MULT + h;
+    }
+
+    /// add a key and a value as one element
+    void add_pair(int a, int b)
+    {
+        add((long long)(((unsigned long long)(unsigned)a << 32) | (unsigned)b));
+    }
+
+    /// number of elements added
+    unsigned long size() const { return count; }
+
+    /// true if both saw the same elements, in any order
+    bool same_multiset(const fingerprint& o) const
+    {
+        return count == o.count && unordered == o.unordered;
+    }
+
+    /// true if both saw the same elements, in the same order
+    bool same_sequence(const fingerprint& o) const
+    {
+        return same_multiset(o) && ordered == o.ordered;
+    }
+
+    /**
+     * Fingerprint the first n values of an expected list, taking them
+     * width at a time (2 for key/value pairs).  Verifiers used to copy
+     * contents into an array filled with -2, so tests end some lists with
+     * -2 entries for the slots past the last value.  Those are allowed
+     * past n; any other entry there, or a list shorter than n, cannot
+     * match, and makes this return false.
+     */
+    bool add_expected(std::initializer_list<int> expected, int n,
+                      int width = 1)
+    {
+        const int* p = expected.begin();
+        if (n < 0 || (int)expected.size() < n || n % width != 0)
+            return false;
+        for (int i = 0; i < n; i += width)
+            if (width == 2)
+                add_pair(p[i], p[i + 1]);
+            else
+                add(p[i]);
+        for (int i = n; i < (int)expected.size(); ++i)
+            if (p[i] != -2)
+                return false;
+        return true;
+    }
+};
@@ -10,7 +10,63 @@ extern std::mutex global_mutex;
 #ifdef NO_TM
 #  define BEGIN_TX {std::lock_guard<std::mutex> _g(global_mutex);
 #  define END_TX   }
+
+/// Retries of the calling thread's transactions so far: none, with a lock
+inline unsigned long tm_thread_retries() { return 0; }
+#elif defined(TM_COUNT)
+#  include <cstdio>
+#  include "tmcount.h"
+
+/**
+ * When linked against the counting runtime, every transaction reports what
+ * the instrumented code asked of the runtime.  The counters are snapshotted
+ * when the region is entered and reported when it is left, after commit.
+ */
+struct tmcount_region
+{
+    const char*   file;
+    int           line;
+    tmcount_stats start;
+
+    tmcount_region(const char* f, int l) : file(f), line(l)
+    {
+        tmcount_get_stats(&start);
+    }
+
+    ~tmcount_region()
+    {
+        tmcount_stats end;
+        tmcount_get_stats(&end);
+        printf("  [TMCOUNT] %s:%d reads=%lu writes=%lu logs=%lu memops=%lu "
+               "allocs=%lu frees=%lu indirect=%lu irrevocable=%lu\n",
+               file, line, end.reads - start.reads, end.writes - start.writes,
+               end.logs - start.logs,
+               end.memtransfers + end.memsets
+                   - start.memtransfers - start.memsets,
+               end.allocs - start.allocs, end.frees - start.frees,
+               end.indirect - start.indirect,
+               end.irrevocable - start.irrevocable);
+    }
+};
+
+#  define BEGIN_TX {tmcount_region _r(__FILE__, __LINE__); __transaction_atomic {
+#  define END_TX   }}
+
+/// The counting runtime does not count retries
+inline unsigned long tm_thread_retries() { return 0; }
 #else
-#  define BEGIN_TX __transaction_atomic {
-#  define END_TX   }
+#  include "tmstats.h"
+
+/**
+ * In the TM build, every region keeps statistics about its transactions,
+ * per thread, and they are printed at exit (see tmstats.h).
+ */
+#  define BEGIN_TX {static tmstats_site _site = {__func__, __FILE__, __LINE__}; \
+                    static thread_local tmstats_record* _rec = nullptr;         \
+                    tmstats_region _r(_site, _rec);                             \
+                    __transaction_atomic { tmstats_attempt(&_r);
+#  define END_TX   }}
+
+/// Retries of the calling thread's transactions so far, in every region
+inline unsigned long tm_thread_retries() { return tmstats_thread_retries(); }
 #endif
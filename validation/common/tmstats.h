@@ -0,0 +1,260 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Statistics for the transactions of the TM build (see BEGIN_TX in tm.h).
+ *
+ * Every BEGIN_TX/END_TX region has a static tmstats_site, and each thread
+ * that runs the region gets its own tmstats_record, in which every
+ * execution of the region is added up.  Retries are counted by the region
+ * itself, through a transaction_pure call at the top of the transaction
+ * body, so they are available with any runtime.  Commits, aborts by
+ * reason, read and write set sizes, and time spent serial-irrevocable come
+ * from the runtime, when it is the STM in ../../libtm (make TM_RUNTIME=stm),
+ * and are left out otherwise.
+ *
+ * At exit, the records are printed to stderr, grouped by test (the function
+ * that holds the region) and site, with a row per thread.  The
+ * instantiations of a region in a function template have a site each, but
+ * the same test, file and line, and are added up into one row.  Threads are
+ * numbered in the order in which they first ran a transaction.  Set
+ * TM_STATS=json in the environment to get JSON instead of a table, or
+ * TM_STATS=0 to get nothing.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../../libtm/stmstats.h"
+
+/// A BEGIN_TX/END_TX region in the source
+struct tmstats_site
+{
+    const char* test;
+    const char* file;
+    int         line;
+};
+
+/// What one thread did in one region
+struct tmstats_record
+{
+    const tmstats_site* site;
+    unsigned            thread;
+    unsigned long       txns;        // executions of the region
+    unsigned long       retries;     // attempts after the first
+    unsigned long       max_retries;
+    stm_stats           rt;          // from the runtime, summed
+    unsigned long       max_reads;
+    unsigned long       max_writes;
+    tmstats_record*     next;
+};
+
+/// Every record, newest first
+inline std::atomic<tmstats_record*>& tmstats_records()
+{
+    static std::atomic<tmstats_record*> head(nullptr);
+    return head;
+}
+
+/// The calling thread's number
+inline unsigned tmstats_thread()
+{
+    static std::atomic<unsigned> threads(0);
+    static thread_local unsigned id = threads++;
+    return id;
+}
+
+/// The retries of all of the calling thread's regions, so that a benchmark
+/// can report them with its own results
+inline unsigned long& tmstats_thread_retries()
+{
+    static thread_local unsigned long retries = 0;
+    return retries;
+}
+
+inline void tmstats_print_table(std::vector<tmstats_record>& recs, bool rt)
+{
+    fprintf(stderr, "\nTM statistics, per BEGIN_TX site and thread%s\n",
+            rt ? "" : " (for aborts, set sizes and serial time, use the STM: "
+                      "make TM_RUNTIME=stm)");
+    fprintf(stderr, "%-24s %6s %9s %9s %6s", "site", "thread", "txns",
+            "retries", "max");
+    if (rt)
+        fprintf(stderr, " %9s %9s %7s %8s %10s %8s %8s %9s %8s", "conflict",
+                "serialize", "cancel", "serial", "serial ms", "reads/tx",
+                "max", "writes/tx", "max");
+    fprintf(stderr, "\n");
+    const char* test = NULL;
+    for (size_t i = 0; i < recs.size(); ++i) {
+        tmstats_record* r = &recs[i];
+        if (!test || strcmp(test, r->site->test)) {
+            test = r->site->test;
+            fprintf(stderr, "%s:\n", test);
+        }
+        const char* file = strrchr(r->site->file, '/');
+        char where[256];
+        snprintf(where, sizeof(where), "  %s:%d", file ? file + 1 : r->site->file,
+                 r->site->line);
+        fprintf(stderr, "%-24s %6u %9lu %9lu %6lu", where, r->thread, r->txns,
+                r->retries, r->max_retries);
+        if (rt) {
+            unsigned long n = r->rt.commits - r->rt.serial_commits;
+            fprintf(stderr, " %9lu %9lu %7lu %8lu %10.3f %8.1f %8lu %9.1f %8lu",
+                    r->rt.aborts[stm_abort_conflict],
+                    r->rt.aborts[stm_abort_serialize],
+                    r->rt.aborts[stm_abort_cancel], r->rt.serial_commits,
+                    r->rt.serial_ns / 1e6, n ? (double)r->rt.reads / n : 0.0,
+                    r->max_reads, n ? (double)r->rt.writes / n : 0.0,
+                    r->max_writes);
+        }
+        fprintf(stderr, "\n");
+    }
+}
+
+inline void tmstats_print_json(std::vector<tmstats_record>& recs, bool rt)
+{
+    fprintf(stderr, "{\"runtime_stats\": %s, \"regions\": [", rt ? "true" : "false");
+    for (size_t i = 0; i < recs.size(); ++i) {
+        tmstats_record* r = &recs[i];
+        fprintf(stderr, "%s\n  {\"test\": \"%s\", \"file\": \"%s\", \"line\": %d, "
+                "\"thread\": %u, \"transactions\": %lu, \"retries\": %lu, "
+                "\"max_retries\": %lu", i ? "," : "", r->site->test,
+                r->site->file, r->site->line, r->thread, r->txns, r->retries,
+                r->max_retries);
+        if (rt)
+            fprintf(stderr, ", \"commits\": %lu, \"aborts\": {\"conflict\": %lu, "
+                    "\"serialize\": %lu, \"cancel\": %lu}, \"serial_commits\": %lu, "
+                    "\"serial_ns\": %llu, \"read_set\": {\"total\": %lu, \"max\": %lu}, "
+                    "\"write_set\": {\"total\": %lu, \"max\": %lu}",
+                    r->rt.commits, r->rt.aborts[stm_abort_conflict],
+                    r->rt.aborts[stm_abort_serialize],
+                    r->rt.aborts[stm_abort_cancel], r->rt.serial_commits,
+                    r->rt.serial_ns, r->rt.reads, r->max_reads, r->rt.writes,
+                    r->max_writes);
+        fprintf(stderr, "}");
+    }
+    fprintf(stderr, "\n]}\n");
+}
+
+/// Compare records by test, site and thread
+inline int tmstats_compare(const tmstats_record* a, const tmstats_record* b)
+{
+    int c = strcmp(a->site->test, b->site->test);
+    if (c == 0)
+        c = strcmp(a->site->file, b->site->file);
+    if (c == 0)
+        c = a->site->line - b->site->line;
+    if (c == 0)
+        c = (a->thread > b->thread) - (a->thread < b->thread);
+    return c;
+}
+
+/// Add what r counted to into
+inline void tmstats_merge(tmstats_record& into, const tmstats_record& r)
+{
+    into.txns += r.txns;
+    into.retries += r.retries;
+    into.max_retries = std::max(into.max_retries, r.max_retries);
+    into.rt.commits += r.rt.commits;
+    into.rt.serial_commits += r.rt.serial_commits;
+    for (int i = 0; i < STM_ABORT_REASONS; ++i)
+        into.rt.aborts[i] += r.rt.aborts[i];
+    into.rt.reads += r.rt.reads;
+    into.rt.writes += r.rt.writes;
+    into.rt.serial_ns += r.rt.serial_ns;
+    into.max_reads = std::max(into.max_reads, r.max_reads);
+    into.max_writes = std::max(into.max_writes, r.max_writes);
+}
+
+/// Print every record, sorted by test, site and thread, with the records
+/// of a region's instantiations added up
+inline void tmstats_report()
+{
+    const char* format = getenv("TM_STATS");
+    if (format && !strcmp(format, "0"))
+        return;
+    std::vector<tmstats_record*> recs;
+    for (tmstats_record* r = tmstats_records().load(); r; r = r->next)
+        recs.push_back(r);
+    std::sort(recs.begin(), recs.end(),
+              [](const tmstats_record* a, const tmstats_record* b) {
+                  return tmstats_compare(a, b) < 0;
+              });
+    std::vector<tmstats_record> rows;
+    for (tmstats_record* r : recs)
+        if (!rows.empty() && tmstats_compare(&rows.back(), r) == 0)
+            tmstats_merge(rows.back(), *r);
+        else
+            rows.push_back(*r);
+    bool rt = stm_get_stats != nullptr;
+    if (format && !strcmp(format, "json"))
+        tmstats_print_json(rows, rt);
+    else
+        tmstats_print_table(rows, rt);
+}
+
+/// Make the calling thread's record for a site
+inline tmstats_record* tmstats_new_record(const tmstats_site& site)
+{
+    static bool registered = (atexit(tmstats_report), true);
+    (void)registered;
+    tmstats_record* r = new tmstats_record();
+    r->site = &site;
+    r->thread = tmstats_thread();
+    r->next = tmstats_records().load();
+    while (!tmstats_records().compare_exchange_weak(r->next, r))
+        ;
+    return r;
+}
+
+/**
+ * One execution of a region.  The runtime's counters are snapshotted when
+ * the region is entered and added to the record when it is left, after the
+ * transaction has committed or been cancelled.
+ */
+struct tmstats_region
+{
+    tmstats_record* rec;
+    unsigned long   attempts;
+    stm_stats       start;
+
+    tmstats_region(const tmstats_site& site, tmstats_record*& mine)
+        : rec(mine ? mine : (mine = tmstats_new_record(site))), attempts(0)
+    {
+        if (stm_get_stats)
+            stm_get_stats(&start);
+    }
+
+    ~tmstats_region()
+    {
+        unsigned long retries = attempts ? attempts - 1 : 0;
+        ++rec->txns;
+        rec->retries += retries;
+        tmstats_thread_retries() += retries;
+        rec->max_retries = std::max(rec->max_retries, retries);
+        if (!stm_get_stats)
+            return;
+        stm_stats end;
+        stm_get_stats(&end);
+        rec->rt.commits += end.commits - start.commits;
+        rec->rt.serial_commits += end.serial_commits - start.serial_commits;
+        for (int i = 0; i < STM_ABORT_REASONS; ++i)
+            rec->rt.aborts[i] += end.aborts[i] - start.aborts[i];
+        rec->rt.reads += end.reads - start.reads;
+        rec->rt.writes += end.writes - start.writes;
+        rec->rt.serial_ns += end.serial_ns - start.serial_ns;
+        rec->max_reads = std::max(rec->max_reads, end.reads - start.reads);
+        rec->max_writes = std::max(rec->max_writes, end.writes - start.writes);
+    }
+};
+
+/// Count an attempt at the region's transaction.  It is transaction_pure,
+/// so the count is not rolled back when the attempt is.
+__attribute__((transaction_pure))
+inline void tmstats_attempt(tmstats_region* r)
+{
+    ++r->attempts;
+}
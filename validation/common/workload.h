@@ -0,0 +1,230 @@
+// -*-c++-*-
+#pragma once
+
+/**
+ * Key distributions for the benchmarks.
+ *
+ * A key_generator draws keys in [0, n) from one of these distributions:
+ *
+ *   uniform        every key equally often
+ *   zipf[:theta]   key k about 1/(k+1)^theta as often as key 0 (default
+ *                  theta 0.99, as in YCSB; 0 < theta < 1)
+ *   hotspot[:h:p]  a p share of draws from the first h share of the keys,
+ *                  uniformly, and the rest from the others (default 0.2:0.8)
+ *   sequential     0, 1, 2, ..., n-1, 0, 1, ... from a per-thread start
+ *   latest[:theta] zipf over recency: the last key added (see grow()) is
+ *                  the hottest
+ *
+ * Key 0 is the hottest key of zipf and hotspot.  Each generator has its own
+ * xorshift state, so threads that draw keys share nothing.  The zipf setup
+ * is O(n), so a benchmark should make one generator, and give each thread
+ * a copy with a seed of its own (see seed()).  Drawing a key calls pow(),
+ * which is not transaction-safe: draw keys before BEGIN_TX.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/// A fast pseudo-random generator (xorshift64*) with per-object state
+class fastrand
+{
+    unsigned long long state;
+
+  public:
+    explicit fastrand(unsigned long long seed = 1) { reseed(seed); }
+
+    /// start over from a seed; different seeds give unrelated sequences
+    void reseed(unsigned long long seed)
+    {
+        // splitmix64, so that consecutive seeds give unrelated states, and
+        // the state is never 0
+        unsigned long long z = seed + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state = (z ^ (z >> 31)) | 1;
+    }
+
+    /// the next 64 random bits
+    unsigned long long next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dULL;
+    }
+
+    /// a random number in [0, n)
+    unsigned long below(unsigned long n)
+    {
+        return next() % n;
+    }
+
+    /// a random number in [0, 1)
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+/// The distributions that a key_generator can draw from
+enum key_dist
+{
+    dist_uniform, dist_zipf, dist_hotspot, dist_sequential, dist_latest,
+    NUM_DISTS
+};
+
+/// The name of a key_dist, as parse() takes it
+inline const char* key_dist_name(int d)
+{
+    static const char* const names[NUM_DISTS] =
+        {"uniform", "zipf", "hotspot", "sequential", "latest"};
+    return names[d];
+}
+
+/// Draws keys in [0, n) from a key_dist
+class key_generator
+{
+    key_dist           dist;
+    unsigned long      n;
+    double             theta;
+    double             hot_keys;     // hotspot: share of keys that are hot
+    double             hot_draws;    // hotspot: share of draws that are hot
+    fastrand           rng;
+    unsigned long      cursor;       // sequential: the next key
+
+    // zipf and latest: the constants of Gray et al.'s method, as in YCSB
+    double             zetan, zeta2, alpha, eta;
+    unsigned long      zeta_n;       // n that zetan is summed up to
+
+    /// add the terms for n of the zeta sum, from the ones summed so far
+    void grow_zeta()
+    {
+        if (n < zeta_n)
+            zetan = zeta_n = 0;
+        for (unsigned long i = zeta_n + 1; i <= n; ++i)
+            zetan += 1.0 / std::pow((double)i, theta);
+        zeta_n = n;
+        eta = (1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+    }
+
+    /// a zipf rank in [0, n), 0 the most frequent
+    unsigned long zipf()
+    {
+        double u  = rng.unit();
+        double uz = u * zetan;
+        if (uz < 1.0)
+            return 0;
+        if (uz < 1.0 + std::pow(0.5, theta))
+            return n > 1 ? 1 : 0;
+        unsigned long r = (unsigned long)(n * std::pow(eta * u - eta + 1, alpha));
+        return r < n ? r : n - 1;
+    }
+
+  public:
+    /**
+     * Make a generator of keys in [0, n).  param1 is theta for zipf and
+     * latest, and the share of hot keys for hotspot; param2 is the share
+     * of hot draws for hotspot.  Other distributions ignore them.
+     */
+    key_generator(key_dist d = dist_uniform, unsigned long n = 1,
+                  double param1 = 0, double param2 = 0)
+        : dist(d), n(n ? n : 1), theta(0.99), hot_keys(0.2), hot_draws(0.8),
+          rng(1), cursor(0), zetan(0), zeta2(0), alpha(0), eta(0), zeta_n(0)
+    {
+        if (d == dist_zipf || d == dist_latest) {
+            if (param1 > 0 && param1 < 1)
+                theta = param1;
+            zeta2 = 1.0 + 1.0 / std::pow(2.0, theta);
+            alpha = 1.0 / (1.0 - theta);
+            grow_zeta();
+        }
+        else if (d == dist_hotspot) {
+            if (param1 > 0 && param1 < 1)
+                hot_keys = param1;
+            if (param2 > 0 && param2 <= 1)
+                hot_draws = param2;
+        }
+    }
+
+    /**
+     * Parse a distribution from the command line, in the form that the
+     * comment at the top of workload.h describes, for keys in [0, keys).
+     * Returns false, and leaves the generator alone, on a bad name.
+     */
+    bool parse(const char* arg, unsigned long keys)
+    {
+        for (int d = 0; d < NUM_DISTS; ++d) {
+            const char* name = key_dist_name(d);
+            size_t len = strlen(name);
+            if (strncmp(arg, name, len) || (arg[len] && arg[len] != ':'))
+                continue;
+            double p1 = 0, p2 = 0;
+            if (arg[len] == ':')
+                sscanf(arg + len + 1, "%lf:%lf", &p1, &p2);
+            *this = key_generator((key_dist)d, keys, p1, p2);
+            return true;
+        }
+        return false;
+    }
+
+    /// start a copy over with a seed (a thread id, say) of its own; a
+    /// sequential generator starts at a key that depends on the seed
+    void seed(unsigned long long s)
+    {
+        rng.reseed(s);
+        cursor = dist == dist_sequential ? rng.below(n) : 0;
+    }
+
+    /// change the keys to [0, new_n), or add one; for latest, the new last
+    /// key is now the hottest
+    void grow(unsigned long new_n = 0)
+    {
+        n = new_n ? new_n : n + 1;
+        if (dist == dist_zipf || dist == dist_latest)
+            grow_zeta();
+    }
+
+    /// the next key
+    unsigned long next()
+    {
+        switch (dist) {
+          case dist_zipf:
+            return zipf();
+          case dist_hotspot: {
+            unsigned long hot = (unsigned long)(n * hot_keys);
+            if (hot == 0 || hot >= n)
+                return rng.below(n);
+            if (rng.unit() < hot_draws)
+                return rng.below(hot);
+            return hot + rng.below(n - hot);
+          }
+          case dist_sequential: {
+            unsigned long k = cursor;
+            cursor = cursor + 1 < n ? cursor + 1 : 0;
+            return k;
+          }
+          case dist_latest:
+            return n - 1 - zipf();
+          default:
+            return rng.below(n);
+        }
+    }
+
+    /// a random number in [0, 100), for choosing operations, from the same
+    /// per-thread state
+    int percent() { return rng.below(100); }
+
+    /// the number of keys
+    unsigned long size() const { return n; }
+
+    /// describe the distribution, for benchmark output
+    void describe(char* buf, size_t len) const
+    {
+        if (dist == dist_zipf || dist == dist_latest)
+            snprintf(buf, len, "%s (theta %.2f)", key_dist_name(dist), theta);
+        else if (dist == dist_hotspot)
+            snprintf(buf, len, "%s (%.0f%% of draws on %.0f%% of keys)",
+                     key_dist_name(dist), hot_draws * 100, hot_keys * 100);
+        else
+            snprintf(buf, len, "%s", key_dist_name(dist));
+    }
+};
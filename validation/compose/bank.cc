@@ -0,0 +1,235 @@
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+#include "run.h"
+
+/// An item in the inventory: how many are left, and how many were sold
+struct stock_entry
+{
+    int left;
+    int sold;
+};
+
+/// A purchase, as the order log records it
+struct order
+{
+    int buyer;
+    int item;
+    int qty;
+};
+
+/// The most orders that the log keeps
+const size_t LOG_SIZE = 1024;
+
+/// What an item costs, and the account that is paid for it
+inline long price_of(int item) { return 1 + item % 10; }
+inline int  seller_of(int item) { return item % num_accounts; }
+
+/**
+ * A bank and a shop: account balances in a vector, the shop's inventory in
+ * a map, and a log of the latest orders in a deque.  A purchase touches all
+ * three: it moves money from the buyer to the item's seller, takes the item
+ * out of stock, and logs the order.  Money and items are never made or
+ * lost, which audit() checks.
+ */
+struct bank
+{
+    std::vector<long>          balances;
+    std::map<int, stock_entry> stock;
+    std::deque<order>          log;
+
+    static const long START_BALANCE = 1000;
+    static const int  START_STOCK = 1000;
+
+    bank() : balances(num_accounts, START_BALANCE)
+    {
+        for (int i = 0; i < num_items; ++i)
+            stock.insert(std::make_pair(i, stock_entry{START_STOCK, 0}));
+    }
+
+    /// move amount from one account to another, if there is enough
+    bool transfer(int from, int to, long amount)
+    {
+        if (balances[from] < amount)
+            return false;
+        balances[from] -= amount;
+        balances[to] += amount;
+        return true;
+    }
+
+    /// buy qty of an item, if the buyer can pay and it is in stock
+    bool purchase(int buyer, int item, int qty)
+    {
+        long cost = price_of(item) * qty;
+        auto s = stock.find(item);
+        if (balances[buyer] < cost || s == stock.end() || s->second.left < qty)
+            return false;
+        balances[buyer] -= cost;
+        balances[seller_of(item)] += cost;
+        s->second.left -= qty;
+        s->second.sold += qty;
+        log.push_back(order{buyer, item, qty});
+        if (log.size() > LOG_SIZE)
+            log.pop_front();
+        return true;
+    }
+
+    /// true if no money or items were made or lost
+    bool audit() const
+    {
+        long money = 0;
+        for (long b : balances)
+            money += b;
+        bool ok = money == START_BALANCE * (long)balances.size();
+        for (auto& s : stock)
+            ok &= s.second.left + s.second.sold == START_STOCK;
+        return ok;
+    }
+};
+
+/// The bank that every thread shares
+bank* the_bank = NULL;
+
+/// The locks of the fine-grained version, taken in this order: the locks
+/// of the accounts, in increasing order, then the inventory lock, then the
+/// log lock.  An audit takes every account lock and the inventory lock.
+std::unique_ptr<std::mutex[]> account_locks;
+std::mutex stock_mutex;
+std::mutex log_mutex;
+
+/// What each thread did: transfers, purchases and audits that went
+/// through, and audits that failed
+unsigned long (*bank_counts)[4] = NULL;
+
+namespace
+{
+    /// lock two accounts, in order, once if they are the same
+    struct account_guard
+    {
+        std::unique_lock<std::mutex> first, second;
+        account_guard(int a, int b)
+            : first(account_locks[std::min(a, b)]),
+              second(a == b ? std::unique_lock<std::mutex>()
+                            : std::unique_lock<std::mutex>(
+                                  account_locks[std::max(a, b)]))
+        { }
+    };
+
+    /**
+     * Every thread runs num_ops operations: an audit_pct share of audits,
+     * and then half purchases and half transfers, between accounts and of
+     * items from key_gen.  With USE_TX, each operation is one transaction.
+     * Without, each takes the locks of what it touches: a transfer, two
+     * account locks; a purchase, two account locks, the inventory lock and
+     * the log lock; and an audit, every account lock and the inventory
+     * lock.
+     */
+    template <bool USE_TX>
+    void run_bank_test(int id, const char* name)
+    {
+        if (id == 0) {
+            the_bank = new bank();
+            account_locks.reset(new std::mutex[num_accounts]);
+            bank_counts = new unsigned long[num_threads][4];
+        }
+        global_barrier->arrive(id);
+
+        key_generator gen = key_gen;
+        gen.grow(num_accounts);
+        gen.seed(id + 1);
+        unsigned long counts[4] = {0, 0, 0, 0};
+        run_timer timer;
+        for (int i = 0; i < num_ops; ++i) {
+            int p = gen.percent();
+            int a = gen.next(), b = gen.next();
+            int item = gen.next() % num_items;
+            int qty = 1 + gen.percent() % 3;
+            long amount = 1 + gen.percent();
+            bool ok;
+            if (p < audit_pct) {
+                if (USE_TX) {
+                    BEGIN_TX;
+                    ok = the_bank->audit();
+                    END_TX;
+                }
+                else {
+                    for (int k = 0; k < num_accounts; ++k)
+                        account_locks[k].lock();
+                    {
+                        std::lock_guard<std::mutex> s(stock_mutex);
+                        ok = the_bank->audit();
+                    }
+                    for (int k = num_accounts - 1; k >= 0; --k)
+                        account_locks[k].unlock();
+                }
+                ++counts[ok ? 2 : 3];
+            }
+            else if (p % 2) {
+                int seller = seller_of(item);
+                if (USE_TX) {
+                    BEGIN_TX;
+                    ok = the_bank->purchase(a, item, qty);
+                    END_TX;
+                }
+                else {
+                    account_guard g(a, seller);
+                    std::lock_guard<std::mutex> s(stock_mutex);
+                    std::lock_guard<std::mutex> l(log_mutex);
+                    ok = the_bank->purchase(a, item, qty);
+                }
+                counts[1] += ok;
+            }
+            else {
+                if (USE_TX) {
+                    BEGIN_TX;
+                    ok = the_bank->transfer(a, b, amount);
+                    END_TX;
+                }
+                else {
+                    account_guard g(a, b);
+                    ok = the_bank->transfer(a, b, amount);
+                }
+                counts[0] += ok;
+            }
+        }
+        timer.stop(id);
+        for (int c = 0; c < 4; ++c)
+            bank_counts[id][c] = counts[c];
+        global_barrier->arrive(id);
+
+        if (id == 0) {
+            unsigned long c[4] = {0, 0, 0, 0};
+            for (int t = 0; t < num_threads; ++t)
+                for (int k = 0; k < 4; ++k)
+                    c[k] += bank_counts[t][k];
+            if (c[3] || !the_bank->audit())
+                printf(" [%s] %lu audits found money or items made or lost\n",
+                       name, c[3]);
+            print_run(name);
+            printf("      %lu transfers, %lu purchases, %lu audits went "
+                   "through; %zu orders logged\n", c[0], c[1], c[2],
+                   the_bank->log.size());
+        }
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete the_bank;
+            the_bank = NULL;
+            account_locks.reset();
+            delete[] bank_counts;
+        }
+    }
+}
+
+/// Every operation is one transaction (or holds global_mutex, in notm)
+void bank_tx_tests(int id)
+{
+    run_bank_test<true>(id, "bank transactions");
+}
+
+/// Every operation takes the locks of the accounts, inventory and log that
+/// it touches
+void bank_lock_tests(int id)
+{
+    run_bank_test<false>(id, "bank locks");
+}
@@ -0,0 +1,197 @@
+/*
+  Composed multi-container transaction benchmark
+
+  Each operation of these workloads changes several containers at once, and
+  has to look atomic over all of them: the case that transactions make easy
+  and that fine-grained locks make hard.  Every workload runs twice, once
+  with a transaction per operation, and once with the locks that a careful
+  programmer would take instead, so that both are measured in the same
+  binary.  In the notm build, the transactions take global_mutex, which
+  makes them the coarse-grained baseline.
+
+  The LRU workload (lru.cc) is a cache of cache_size values over num_keys
+  keys: a std::list in order of use, a std::unordered_map index, and a
+  std::map archive of the evicted values.  A miss moves one key in from the
+  archive and another out to it.  Some operations only peek at the archive.
+
+  The bank workload (bank.cc) is num_accounts balances in a std::vector, an
+  inventory of num_items items in a std::map, and a std::deque log of
+  orders.  Transfers move money between two accounts, purchases also take
+  an item out of stock and log the order, and audits read every balance and
+  item, and check that nothing was made or lost.
+
+  Both report throughput, and, in the TM build, the retries per 100
+  operations.
+
+|------+-------------------+-------------------------------------------------|
+| Test | Name              | Critical sections                               |
+|------+-------------------+-------------------------------------------------|
+|    1 | lru transactions  | BEGIN_TX/END_TX (global_mutex in notm)          |
+|    2 | lru locks         | a cache lock, then an archive lock on a miss    |
+|    3 | bank transactions | BEGIN_TX/END_TX (global_mutex in notm)          |
+|    4 | bank locks        | account locks in order, then inventory and log  |
+|------+-------------------+-------------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: operations per thread
+int  num_ops = 100000;
+
+/// configured via command line args: keys of the LRU workload
+int  num_keys = 4096;
+
+/// configured via command line args: most values in the LRU cache
+int  cache_size = 1024;
+
+/// configured via command line args: percentage of LRU hits that write
+int  write_pct = 20;
+
+/// configured via command line args: percentage of LRU operations that only
+/// peek at the archive
+int  peek_pct = 10;
+
+/// configured via command line args: accounts of the bank workload
+int  num_accounts = 1024;
+
+/// configured via command line args: items in the bank's inventory
+int  num_items = 256;
+
+/// configured via command line args: percentage of bank operations that
+/// audit the whole bank
+int  audit_pct = 1;
+
+/// configured via command line args: the distribution of LRU keys, and of
+/// bank accounts
+key_generator key_gen;
+
+/// the time each thread took in the current run, and its retries
+unsigned long long* thread_ns;
+unsigned long*      thread_retries;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int>  : specify the number of threads" << endl
+         << "  -o <int>  : specify the number of operations per thread" << endl
+         << "  -k <int>  : specify the number of LRU keys" << endl
+         << "  -c <int>  : specify the LRU cache size" << endl
+         << "  -w <int>  : specify the percentage of LRU hits that write" << endl
+         << "  -p <int>  : specify the percentage of LRU archive peeks" << endl
+         << "  -a <int>  : specify the number of bank accounts" << endl
+         << "  -i <int>  : specify the number of inventory items" << endl
+         << "  -u <int>  : specify the percentage of bank audits" << endl
+         << "  -K <dist> : key distribution: uniform, zipf[:theta]," << endl
+         << "              hotspot[:keys:draws], sequential, latest[:theta]" << endl
+         << "              (default: zipf; see common/workload.h)" << endl
+         << "  -h        : display this message" << endl
+         << "  -T        : enable all tests" << endl
+         << "  -t <int>  : enable a specific test" << endl
+         << "               1 lru transactions" << endl
+         << "               2 lru locks" << endl
+         << "               3 bank transactions" << endl
+         << "               4 bank locks" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 5;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    lru_tx_tests,                                       // lru.cc
+    lru_lock_tests,                                     // lru.cc
+    bank_tx_tests,                                      // bank.cc
+    bank_lock_tests                                     // bank.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    const char* dist = "zipf";
+    while ((opt = getopt(argc, argv, "n:o:k:c:w:p:a:i:u:K:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg);  break;
+          case 'o': num_ops = atoi(optarg);      break;
+          case 'k': num_keys = atoi(optarg);     break;
+          case 'c': cache_size = atoi(optarg);   break;
+          case 'w': write_pct = atoi(optarg);    break;
+          case 'p': peek_pct = atoi(optarg);     break;
+          case 'a': num_accounts = atoi(optarg); break;
+          case 'i': num_items = atoi(optarg);    break;
+          case 'u': audit_pct = atoi(optarg);    break;
+          case 'K': dist = optarg;               break;
+          case 'h': usage();                     break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (num_keys < 1 || cache_size < 1 || num_accounts < 1 || num_items < 1)
+        usage();
+    if (!key_gen.parse(dist, num_keys))
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+    char dist[64];
+    key_gen.describe(dist, sizeof(dist));
+    printf("lru: %d keys, %d cached, %d%% writes, %d%% peeks; bank: %d "
+           "accounts, %d items, %d%% audits; %s keys\n", num_keys, cache_size,
+           write_pct, peek_pct, num_accounts, num_items, audit_pct, dist);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_ns = new unsigned long long[num_threads];
+    thread_retries = new unsigned long[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
@@ -0,0 +1,211 @@
+#include <atomic>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include "run.h"
+
+/// A cached value, and its place in the recency list
+struct lru_entry
+{
+    std::list<int>::iterator pos;
+    long                     value;
+};
+
+/**
+ * An LRU cache of at most cache_size values, in a list of keys in order of
+ * use and an unordered_map from keys to values and list positions, with a
+ * std::map that archives the values that the cache evicts.  A key is in
+ * the cache or the archive, never both, and each move between the two
+ * touches all three containers.
+ */
+struct lru_cache
+{
+    std::list<int>                    order;     // most recently used first
+    std::unordered_map<int, lru_entry> index;
+    std::map<int, long>               archive;
+
+    /// The lookup half of get(): on a hit, make key the most recent, and
+    /// add to its value if write.  Returns false on a miss.
+    bool hit(int key, bool write, long& value)
+    {
+        auto i = index.find(key);
+        if (i == index.end())
+            return false;
+        order.splice(order.begin(), order, i->second.pos);
+        if (write)
+            ++i->second.value;
+        value = i->second.value;
+        return true;
+    }
+
+    /// The miss half of get(): bring key in from the archive, or with a
+    /// new value, and move the least recent key out to the archive if the
+    /// cache is full.  Returns true if key was in the archive.
+    bool miss(int key, long& value)
+    {
+        bool archived = false;
+        value = key;
+        auto a = archive.find(key);
+        if (a != archive.end()) {
+            value = a->second;
+            archive.erase(a);
+            archived = true;
+        }
+        order.push_front(key);
+        lru_entry e = {order.begin(), value};
+        index.insert(std::make_pair(key, e));
+        if ((int)index.size() > cache_size) {
+            auto old = index.find(order.back());
+            archive.insert(std::make_pair(old->first, old->second.value));
+            index.erase(old);
+            order.pop_back();
+        }
+        return archived;
+    }
+
+    /// look a key up in the archive only, as a history query would
+    bool peek(int key, long& value) const
+    {
+        auto a = archive.find(key);
+        if (a == archive.end())
+            return false;
+        value = a->second;
+        return true;
+    }
+
+    /// true if the list, the index and the archive agree
+    bool valid() const
+    {
+        if (order.size() != index.size() || (int)index.size() > cache_size)
+            return false;
+        for (int k : order) {
+            auto i = index.find(k);
+            if (i == index.end() || *i->second.pos != k || archive.count(k))
+                return false;
+        }
+        return true;
+    }
+};
+
+/// The cache that every thread shares
+lru_cache* the_cache = NULL;
+
+/// The locks of the fine-grained version: one for the list and its index,
+/// which every get() changes, and one for the archive, which misses and
+/// peeks need.  A miss takes them in that order.
+std::mutex cache_mutex;
+std::mutex archive_mutex;
+
+/// What each thread saw: hits, misses found in the archive, and peeks
+unsigned long (*lru_counts)[3] = NULL;
+std::atomic<long> lru_sink;
+
+namespace
+{
+    /**
+     * Every thread runs num_ops operations on keys from key_gen: a
+     * peek_pct share of peeks, and get()s for the rest, write_pct of which
+     * also change the value on a hit.  With USE_TX, each operation is one
+     * transaction, including a whole move from the archive into the cache
+     * and of another key back out.  Without, a peek holds the archive lock,
+     * a hit holds the cache lock, and a miss holds the cache lock and then
+     * the archive lock, which is the least locking that keeps every key in
+     * exactly one place.
+     */
+    template <bool USE_TX>
+    void run_lru_test(int id, const char* name)
+    {
+        if (id == 0) {
+            the_cache = new lru_cache();
+            lru_counts = new unsigned long[num_threads][3];
+        }
+        global_barrier->arrive(id);
+
+        key_generator gen = key_gen;
+        gen.seed(id + 1);
+        unsigned long hits = 0, archived = 0, peeks = 0;
+        long sum = 0;
+        run_timer timer;
+        for (int i = 0; i < num_ops; ++i) {
+            int key = gen.next();
+            bool peek = gen.percent() < peek_pct;
+            bool write = gen.percent() < write_pct;
+            long value = 0;
+            bool was_hit, was_archived = false;
+            if (peek) {
+                if (USE_TX) {
+                    BEGIN_TX;
+                    the_cache->peek(key, value);
+                    END_TX;
+                }
+                else {
+                    std::lock_guard<std::mutex> a(archive_mutex);
+                    the_cache->peek(key, value);
+                }
+                ++peeks;
+                sum += value;
+                continue;
+            }
+            if (USE_TX) {
+                BEGIN_TX;
+                was_hit = the_cache->hit(key, write, value);
+                if (!was_hit)
+                    was_archived = the_cache->miss(key, value);
+                END_TX;
+            }
+            else {
+                std::lock_guard<std::mutex> c(cache_mutex);
+                was_hit = the_cache->hit(key, write, value);
+                if (!was_hit) {
+                    std::lock_guard<std::mutex> a(archive_mutex);
+                    was_archived = the_cache->miss(key, value);
+                }
+            }
+            hits += was_hit;
+            archived += was_archived;
+            sum += value;
+        }
+        timer.stop(id);
+        lru_counts[id][0] = hits;
+        lru_counts[id][1] = archived;
+        lru_counts[id][2] = peeks;
+        // keep the reads from being optimized away
+        lru_sink.fetch_add(sum, std::memory_order_relaxed);
+        global_barrier->arrive(id);
+
+        if (id == 0) {
+            unsigned long h = 0, a = 0, p = 0;
+            for (int t = 0; t < num_threads; ++t) {
+                h += lru_counts[t][0];
+                a += lru_counts[t][1];
+                p += lru_counts[t][2];
+            }
+            unsigned long gets = (unsigned long)num_ops * num_threads - p;
+            if (!the_cache->valid())
+                printf(" [%s] the cache and the archive do not agree\n", name);
+            print_run(name);
+            printf("      %lu gets, %.1f%% hits, %lu misses from the archive, "
+                   "%lu peeks, %zu keys archived\n", gets,
+                   gets ? h * 100.0 / gets : 0.0, a, p,
+                   the_cache->archive.size());
+        }
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete the_cache;
+            the_cache = NULL;
+            delete[] lru_counts;
+        }
+    }
+}
+
+/// Every get() is one transaction (or holds global_mutex, in notm)
+void lru_tx_tests(int id)
+{
+    run_lru_test<true>(id, "lru transactions");
+}
+
+/// Every get() takes a cache lock, and on a miss an archive lock too
+void lru_lock_tests(int id)
+{
+    run_lru_test<false>(id, "lru locks");
+}
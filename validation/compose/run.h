@@ -0,0 +1,44 @@
+// -*-c++-*-
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "tests.h"
+
+/// Times one thread's part of a run, and counts the retries of its
+/// transactions
+class run_timer
+{
+    std::chrono::steady_clock::time_point start;
+    unsigned long                         retries;
+
+  public:
+    run_timer()
+        : start(std::chrono::steady_clock::now()), retries(tm_thread_retries())
+    { }
+
+    /// record the thread's time and retries, for print_run()
+    void stop(int id)
+    {
+        thread_ns[id] = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (std::chrono::steady_clock::now() - start).count();
+        thread_retries[id] = tm_thread_retries() - retries;
+    }
+};
+
+/// Print the throughput of a run, which took as long as its slowest thread,
+/// and the retries per 100 operations.  Call after every thread has stopped
+/// its timer.
+inline void print_run(const char* name)
+{
+    unsigned long long ns = *std::max_element(thread_ns,
+                                              thread_ns + num_threads);
+    unsigned long retries = 0;
+    for (int i = 0; i < num_threads; ++i)
+        retries += thread_retries[i];
+    double total = (double)num_ops * num_threads;
+    printf("  %-18s %3d threads %10d ops/thread %10.3f ms %8.3f Mops/s"
+           " %8.2f retries/100 ops\n", name, num_threads, num_ops, ns / 1e6,
+           ns ? total * 1e3 / ns : 0.0, total ? retries * 100 / total : 0.0);
+}
@@ -0,0 +1,35 @@
+#include <mutex>
+#include "../common/tm.h"
+#include "../common/workload.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// configured via the command line
+extern int  num_threads;
+extern int  num_ops;
+extern int  num_keys;
+extern int  cache_size;
+extern int  write_pct;
+extern int  peek_pct;
+extern int  num_accounts;
+extern int  num_items;
+extern int  audit_pct;
+extern key_generator key_gen;
+
+/// the time each thread took in the current run, in nanoseconds, and the
+/// retries of its transactions
+extern unsigned long long* thread_ns;
+extern unsigned long*      thread_retries;
+
+// the LRU cache with an archive, from lru.cc
+void lru_tx_tests(int id);
+void lru_lock_tests(int id);
+
+// the bank and its inventory, from bank.cc
+void bank_tx_tests(int id);
+void bank_lock_tests(int id);
@@ -0,0 +1,137 @@
+/*
+  Benchmark for hash code caching in the unordered containers
+
+  _Hashtable only stores a hash code in each node when __cache_default says
+  so, and for "fast" hashers like std::hash<int> it doesn't.  Without a
+  cached code, rehashing and bucket-boundary checks rehash the key, and a
+  lookup compares keys without first filtering on the code.  Under TM every
+  one of those key reads joins the transaction's read set.
+
+  This benchmark runs a growing insert, an explicit rehash, a lookup pass
+  and an erase pass, each as one transaction, for int keys and 16-byte
+  string keys, with and without cached hash codes.  For each phase it
+  reports the time and the number of hash and key-compare calls (each of
+  which reads keys); the calls are counted in a second, untimed run of the
+  phases, outside of any transaction.  Build with TM_CACHE_HASH=1 to force
+  caching for every container in the TM build, in which case the "not
+  cached" rows will also cache.
+
+  The hashers are counting_hash<K>, which calls std::hash<int> for int
+  keys and FNV-1a for string keys; in the cached rows, it is wrapped in
+  __cache_hash_code.
+
+|------+-------------+--------------------+-------------------------------|
+| Test | Key         | Hasher             | Cached by default?            |
+|------+-------------+--------------------+-------------------------------|
+|    1 | int         | counting_hash<int> | no (user hashers count as     |
+|      |             |                    | fast)                         |
+|    2 | int         | __cache_hash_code  | yes (forced)                  |
+|      |             | <counting_hash>    |                               |
+|    3 | 16B string  | counting_hash      | no (user hashers count as     |
+|      |             | <key16> (FNV-1a)   | fast)                         |
+|    4 | 16B string  | __cache_hash_code  | yes (forced)                  |
+|      |             | <counting_hash>    |                               |
+|------+-------------+--------------------+-------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: number of keys per thread
+int  num_keys = 4096;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int> : specify the number of threads" << endl
+         << "  -k <int> : specify the number of keys per thread" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 int keys, default caching" << endl
+         << "               2 int keys, cached hash codes" << endl
+         << "               3 string keys, default caching" << endl
+         << "               4 string keys, cached hash codes" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 5;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    int_uncached_tests,                                 // int_keys.cc
+    int_cached_tests,                                   // int_keys.cc
+    string_uncached_tests,                              // string_keys.cc
+    string_cached_tests                                 // string_keys.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:k:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 'k': num_keys = atoi(optarg);    break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
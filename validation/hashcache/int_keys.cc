@@ -0,0 +1,24 @@
+#include "run.h"
+
+static int make_int_key(int i) { return i; }
+
+/// counting_hash<int> counts as fast, as the std::hash<int> that it calls
+/// does, so by default the hash code is not cached
+void int_uncached_tests(int id)
+{
+    global_barrier->arrive(id);
+    if (id == 0)
+        printf("Testing int keys with the default caching policy\n");
+    run_hashcache_test<int, counting_hash<int>>(id, "int, not cached",
+                                                make_int_key);
+}
+
+/// Force caching by wrapping the hasher
+void int_cached_tests(int id)
+{
+    global_barrier->arrive(id);
+    if (id == 0)
+        printf("Testing int keys with cached hash codes\n");
+    run_hashcache_test<int, __cache_hash_code<counting_hash<int>>>
+        (id, "int, cached", make_int_key);
+}
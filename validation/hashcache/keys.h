@@ -0,0 +1,117 @@
+// -*-c++-*-
+#pragma once
+
+#include <functional>
+#include <unordered_set>
+
+/**
+ * Key types and functors for the hash caching benchmark.  The hasher and
+ * the equality functor can count how often they are called: every call
+ * reads at least one key, so the counts are a direct measure of how many
+ * keys a transaction adds to its read set.  They only count when they are
+ * given counters, which run.h does outside of any transaction, so that the
+ * counting adds nothing to the transactions that are timed.
+ */
+
+/// Call counters, on the stack of the thread that counts
+struct call_counts
+{
+    long hashes;
+    long compares;
+};
+
+/// A 16-byte string key.  We don't use std::string here, since the
+/// reference-counted string in libstdc++_tm is not transaction-safe yet, but
+/// the hash still has to touch every byte of the key.
+struct key16
+{
+    char s[16];
+};
+
+/// Build a key16 from an integer, outside of any transaction
+inline key16 make_key16(int i)
+{
+    key16 k;
+    for (int j = 0; j < 16; ++j)
+        k.s[j] = 'a';
+    for (int j = 15; j >= 0 && i > 0; --j, i /= 26)
+        k.s[j] = 'a' + (i % 26);
+    return k;
+}
+
+/// Hasher that forwards to std::hash<int> (int keys) or FNV-1a (key16), and
+/// counts every call if it has counters
+template <class K>
+struct counting_hash;
+
+template <>
+struct counting_hash<int>
+{
+    call_counts* counts;
+    counting_hash(call_counts* c = nullptr) : counts(c) { }
+    std::size_t operator()(int k) const noexcept
+    {
+        if (counts)
+            ++counts->hashes;
+        return std::hash<int>()(k);
+    }
+};
+
+template <>
+struct counting_hash<key16>
+{
+    call_counts* counts;
+    counting_hash(call_counts* c = nullptr) : counts(c) { }
+    std::size_t operator()(const key16& k) const noexcept
+    {
+        if (counts)
+            ++counts->hashes;
+        std::size_t h = 14695981039346656037ULL;
+        for (int j = 0; j < 16; ++j)
+            h = (h ^ (unsigned char)k.s[j]) * 1099511628211ULL;
+        return h;
+    }
+};
+
+/// Equality functor that counts every comparison of two keys, if it has
+/// counters
+template <class K>
+struct counting_equal
+{
+    call_counts* counts;
+    counting_equal(call_counts* c = nullptr) : counts(c) { }
+    bool operator()(const int& a, const int& b) const
+    {
+        if (counts)
+            ++counts->compares;
+        return a == b;
+    }
+    bool operator()(const key16& a, const key16& b) const
+    {
+        if (counts)
+            ++counts->compares;
+        for (int j = 0; j < 16; ++j)
+            if (a.s[j] != b.s[j])
+                return false;
+        return true;
+    }
+};
+
+/// The TM library provides std::__cache_hash_code to force caching for one
+/// container.  The other libraries don't, but they do have the
+/// __is_fast_hash hook it is built on, so we can provide the same thing.
+#ifdef USE_TM
+using std::__cache_hash_code;
+#else
+template <class H>
+struct __cache_hash_code : public H
+{
+    using H::H;
+};
+namespace std
+{
+    template <class H>
+    struct __is_fast_hash<::__cache_hash_code<H>> : public std::false_type
+    { };
+}
+#endif
@@ -0,0 +1,104 @@
+// -*-c++-*-
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <unordered_set>
+#include "tests.h"
+#include "keys.h"
+
+/// What one phase of the benchmark leaves behind
+struct phase_result
+{
+    std::size_t found, buckets, final_size;
+};
+
+/// Run phase p (growing insert, explicit rehash, lookup, erase) on *set,
+/// which phase 0 makes and phase 3 deletes.  Its functors count calls in
+/// counts, if it is not null.
+template <class K, class Hash,
+          class set_t = std::unordered_set<K, Hash, counting_equal<K>>>
+void run_hashcache_phase(int p, set_t*& set, call_counts* counts,
+                         const K* keys, phase_result& r)
+{
+    if (p == 0) {
+        set = new set_t(1, Hash(counts), counting_equal<K>(counts));
+        for (int i = 0; i < num_keys; ++i)
+            set->insert(keys[i]);
+    }
+    else if (p == 1) {
+        set->rehash(set->bucket_count() * 2);
+        r.buckets = set->bucket_count();
+    }
+    else if (p == 2) {
+        for (int i = 0; i < num_keys; ++i)
+            r.found += set->count(keys[i]);
+    }
+    else {
+        for (int i = 0; i < num_keys; ++i)
+            set->erase(keys[i]);
+        r.final_size = set->size();
+        delete set;
+        set = NULL;
+    }
+}
+
+/**
+ * Run the four phases of the benchmark on one unordered_set, each phase as
+ * a single transaction, and report the time of each phase.  The hash and
+ * key-compare calls of each phase are then counted by running the phases
+ * again, on a second set, outside of any transaction and untimed, so that
+ * the counters add nothing to the read and write sets of the transactions
+ * that are timed.  Both runs make the same calls, since they insert the
+ * same keys into sets that start out the same.  Every thread uses its own
+ * sets, so the numbers describe the cost of one transaction rather than
+ * contention.
+ */
+template <class K, class Hash>
+void run_hashcache_test(int id, const char* name, K (*make_key)(int))
+{
+    typedef std::unordered_set<K, Hash, counting_equal<K>> set_t;
+    typedef std::chrono::steady_clock clock;
+
+    // build keys outside of any transaction
+    K* keys = new K[num_keys];
+    for (int i = 0; i < num_keys; ++i)
+        keys[i] = make_key(i + id * num_keys);
+
+    set_t* set = NULL;
+    const char* phases[4] = {"insert", "rehash", "find", "erase"};
+    long usecs[4], hashes[4], compares[4];
+    phase_result r = {0, 0, 0}, counted = {0, 0, 0};
+
+    global_barrier->arrive(id);
+    for (int p = 0; p < 4; ++p) {
+        auto start = clock::now();
+        BEGIN_TX;
+        run_hashcache_phase<K, Hash>(p, set, NULL, keys, r);
+        END_TX;
+        auto end = clock::now();
+        usecs[p] = std::chrono::duration_cast<std::chrono::microseconds>
+            (end - start).count();
+    }
+    global_barrier->arrive(id);
+
+    call_counts counts;
+    for (int p = 0; p < 4; ++p) {
+        counts.hashes = counts.compares = 0;
+        run_hashcache_phase<K, Hash>(p, set, &counts, keys, counted);
+        hashes[p] = counts.hashes;
+        compares[p] = counts.compares;
+    }
+
+    if (r.found != (std::size_t)num_keys || r.final_size != 0)
+        printf(" [%d] %s: found %zu of %d keys, %zu left after erase\n",
+               id, name, r.found, num_keys, r.final_size);
+    else if (id == 0) {
+        printf(" [OK] %s (%d keys, %zu buckets after rehash)\n",
+               name, num_keys, r.buckets);
+        for (int p = 0; p < 4; ++p)
+            printf("      %-7s %9ld us %10ld hash calls %10ld key compares\n",
+                   phases[p], usecs[p], hashes[p], compares[p]);
+    }
+    delete[] keys;
+}
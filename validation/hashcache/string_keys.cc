@@ -0,0 +1,22 @@
+#include "run.h"
+
+/// A user-provided hasher is considered fast, so by default the hash code
+/// is not cached even though hashing reads all 16 bytes of the key
+void string_uncached_tests(int id)
+{
+    global_barrier->arrive(id);
+    if (id == 0)
+        printf("Testing 16-byte string keys with the default caching policy\n");
+    run_hashcache_test<key16, counting_hash<key16>>(id, "string, not cached",
+                                                    make_key16);
+}
+
+/// Force caching by wrapping the hasher
+void string_cached_tests(int id)
+{
+    global_barrier->arrive(id);
+    if (id == 0)
+        printf("Testing 16-byte string keys with cached hash codes\n");
+    run_hashcache_test<key16, __cache_hash_code<counting_hash<key16>>>
+        (id, "string, cached", make_key16);
+}
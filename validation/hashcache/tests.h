@@ -0,0 +1,20 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// number of keys each thread inserts, configured via the command line
+extern int num_keys;
+
+// int keys, from int_keys.cc
+void int_uncached_tests(int id);
+void int_cached_tests(int id);
+
+// fixed-size string keys, from string_keys.cc
+void string_uncached_tests(int id);
+void string_cached_tests(int id);
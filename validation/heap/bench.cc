@@ -0,0 +1,142 @@
+/*
+  Priority scheduler benchmark for std::priority_queue and stl_heap.h
+
+  All threads share one job scheduler, a std::priority_queue over a
+  std::vector, and insert jobs, pop the earliest job, and move jobs' due
+  times earlier, each in a critical section of its own: push_heap, pop_heap
+  and make_heap (see sched.cc).  It reports throughput, and, in the TM
+  build, the retries per 100 transactions; the TM statistics at exit break
+  them down by operation, and with make TM_RUNTIME=stm, tell aborts apart
+  from commits in serial mode.
+
+|------+--------------+------------------------------------------------------|
+| Test | Name         | Critical sections                                    |
+|------+--------------+------------------------------------------------------|
+|    1 | transactions | BEGIN_TX/END_TX (global_mutex in the notm build)     |
+|    2 | mutex        | a std::mutex, in every build                         |
+|------+--------------+------------------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: operations per thread
+int  num_ops = 100000;
+
+/// configured via command line args: jobs in the scheduler at the start
+int  initial_jobs = 1024;
+
+/// configured via command line args: percentage of operations that insert
+int  insert_pct = 45;
+
+/// configured via command line args: percentage of operations that
+/// decrease a key
+int  decrease_pct = 10;
+
+/// configured via command line args: the latest that a job can be due, in
+/// ticks after the job that its thread last popped
+int  wheel_slots = 64;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int> : specify the number of threads" << endl
+         << "  -o <int> : specify the number of operations per thread" << endl
+         << "  -j <int> : specify the number of jobs at the start" << endl
+         << "  -i <int> : specify the percentage of inserts" << endl
+         << "  -d <int> : specify the percentage of decrease-keys" << endl
+         << "             (the rest are pops)" << endl
+         << "  -w <int> : specify how many ticks ahead a job can be due" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 transactions" << endl
+         << "               2 mutex" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 3;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    tx_sched_tests,                                     // sched.cc
+    mutex_sched_tests                                   // sched.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:o:j:i:d:w:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg);  break;
+          case 'o': num_ops = atoi(optarg);      break;
+          case 'j': initial_jobs = atoi(optarg); break;
+          case 'i': insert_pct = atoi(optarg);   break;
+          case 'd': decrease_pct = atoi(optarg); break;
+          case 'w': wheel_slots = atoi(optarg);  break;
+          case 'h': usage();                     break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (wheel_slots < 1 || insert_pct < 0 || decrease_pct < 0
+        || insert_pct + decrease_pct > 100)
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <queue>
+#include <vector>
+#include "tests.h"
+#include "../common/workload.h"
+
+/// A job, due at a tick
+struct job
+{
+    unsigned long due;
+    uint64_t      id;
+};
+
+/// Orders jobs so that the one that is due first is on top
+struct due_later
+{
+    bool operator()(const job& a, const job& b) const { return a.due > b.due; }
+};
+
+/**
+ * The scheduler: push and pop are push_heap and pop_heap on the vector,
+ * and decrease-key moves a job's deadline up and rebuilds the heap with
+ * make_heap, which is the only way to do it through priority_queue's
+ * interface
+ */
+class job_queue : public std::priority_queue<job, std::vector<job>, due_later>
+{
+  public:
+    /// move the job at position i (modulo the size) delta ticks earlier
+    bool decrease(unsigned long i, unsigned long delta)
+    {
+        if (c.empty())
+            return false;
+        job& j = c[i % c.size()];
+        j.due = j.due > delta ? j.due - delta : 0;
+        std::make_heap(c.begin(), c.end(), comp);
+        return true;
+    }
+
+    bool valid() const { return std::is_heap(c.begin(), c.end(), comp); }
+};
+
+/// The scheduler that every thread shares
+job_queue* the_sched = NULL;
+
+/// The lock of the mutex runs, which is not the one that BEGIN_TX takes
+std::mutex sched_mutex;
+
+/// What one thread did in the current run
+struct sched_stats
+{
+    unsigned long      ops[3];       // inserts, pops, decreases
+    unsigned long      empty_pops;
+    unsigned long      retries;
+    unsigned long long ns;
+};
+
+sched_stats* stats = NULL;
+
+/// Run stmt as a critical section: a transaction if USE_TX, and otherwise
+/// under sched_mutex.  Each use is a BEGIN_TX site of its own, so the TM
+/// statistics at exit break the retries down by operation.
+#define SCHED_OP(stmt)                                          \
+    if (USE_TX) {                                               \
+        BEGIN_TX;                                               \
+        stmt;                                                   \
+        END_TX;                                                 \
+    }                                                           \
+    else {                                                      \
+        std::lock_guard<std::mutex> g(sched_mutex);             \
+        stmt;                                                   \
+    }
+
+namespace
+{
+    /**
+     * One run of the scheduler.  Every thread runs num_ops operations on
+     * the shared scheduler: an insert_pct share of inserts, a decrease_pct
+     * share of decrease-keys, and pops of the earliest job for the rest.
+     * As in a timer wheel, an insert is due 1 to wheel_slots ticks after
+     * the job that its thread last popped, so deadlines bunch up near the
+     * top of the heap, where every pop and most inserts write.  Thread 0
+     * reports the throughput, and the retries per 100 transactions.
+     */
+    template <bool USE_TX>
+    void run_sched_test(int id, const char* name)
+    {
+        typedef std::chrono::steady_clock clock;
+        if (id == 0) {
+            fastrand rng(1);
+            the_sched = new job_queue();
+            for (int i = 0; i < initial_jobs; ++i)
+                the_sched->push(job{rng.below(wheel_slots), (uint64_t)i});
+            stats = new sched_stats[num_threads];
+        }
+        global_barrier->arrive(id);
+
+        sched_stats& st = stats[id];
+        st = sched_stats();
+        fastrand rng(id + 1);
+        unsigned long now = 0;
+        uint64_t next_id = ((uint64_t)id + 1) << 32;
+        unsigned long retries = tm_thread_retries();
+        auto start = clock::now();
+        for (int i = 0; i < num_ops; ++i) {
+            // draw everything outside of the critical section
+            int p = rng.below(100);
+            unsigned long r = rng.next();
+            unsigned long delta = 1 + rng.below(wheel_slots);
+            if (p < insert_pct) {
+                job j = {now + delta, next_id++};
+                SCHED_OP(the_sched->push(j));
+                ++st.ops[0];
+            }
+            else if (p < insert_pct + decrease_pct) {
+                SCHED_OP(the_sched->decrease(r, delta));
+                ++st.ops[2];
+            }
+            else {
+                bool found = false;
+                job j;
+                SCHED_OP(if (!the_sched->empty()) {
+                             j = the_sched->top();
+                             the_sched->pop();
+                             found = true;
+                         });
+                if (found)
+                    now = j.due;
+                else
+                    ++st.empty_pops;
+                ++st.ops[1];
+            }
+        }
+        st.ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (clock::now() - start).count();
+        st.retries = tm_thread_retries() - retries;
+        global_barrier->arrive(id);
+
+        // the run took as long as its slowest thread
+        if (id == 0) {
+            sched_stats all = sched_stats();
+            for (int t = 0; t < num_threads; ++t) {
+                for (int o = 0; o < 3; ++o)
+                    all.ops[o] += stats[t].ops[o];
+                all.empty_pops += stats[t].empty_pops;
+                all.retries += stats[t].retries;
+                all.ns = std::max(all.ns, stats[t].ns);
+            }
+            double total = (double)num_ops * num_threads;
+            if (!the_sched->valid())
+                printf(" [%s] the heap is broken\n", name);
+            printf("  %-12s %3d threads %10d ops/thread %10.3f ms %8.3f Mops/s"
+                   " %8.2f retries/100 tx\n", name, num_threads, num_ops,
+                   all.ns / 1e6, all.ns ? total * 1e3 / all.ns : 0.0,
+                   total ? all.retries * 100 / total : 0.0);
+            printf("      %lu inserts, %lu pops (%lu empty), %lu decrease-keys,"
+                   " %zu jobs left\n", all.ops[0], all.ops[1], all.empty_pops,
+                   all.ops[2], the_sched->size());
+        }
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete the_sched;
+            the_sched = NULL;
+            delete[] stats;
+        }
+    }
+}
+
+/// Every operation is a transaction (or holds global_mutex, in notm)
+void tx_sched_tests(int id)
+{
+    run_sched_test<true>(id, "transactions");
+}
+
+/// Every operation holds a mutex, in every build: the baseline that the
+/// transactions of the same binary are compared to
+void mutex_sched_tests(int id)
+{
+    run_sched_test<false>(id, "mutex");
+}
@@ -0,0 +1,21 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// configured via the command line
+extern int  num_threads;
+extern int  num_ops;
+extern int  initial_jobs;
+extern int  insert_pct;
+extern int  decrease_pct;
+extern int  wheel_slots;
+
+// scheduler runs, from sched.cc
+void tx_sched_tests(int id);
+void mutex_sched_tests(int id);
@@ -0,0 +1,185 @@
+/*
+  YCSB-style key-value benchmark
+
+  Runs the core YCSB workloads on a std::map and a std::unordered_map of
+  8-byte keys and 80-byte records, which all threads share, with every
+  operation in a transaction of its own.  See ycsb.h for how a run goes.
+
+|----------+------+--------+--------+------+-----+---------+-------------|
+| Workload | Read | Update | Insert | Scan | RMW | Keys    | Models      |
+|----------+------+--------+--------+------+-----+---------+-------------|
+| A        |  50% |    50% |        |      |     | zipf    | sessions    |
+| B        |  95% |     5% |        |      |     | zipf    | photo tags  |
+| C        | 100% |        |        |      |     | zipf    | user cache  |
+| D        |  95% |        |     5% |      |     | latest  | status feed |
+| E        |      |        |     5% |  95% |     | zipf    | threads     |
+| F        |  50% |        |        |      | 50% | zipf    | user db     |
+|----------+------+--------+--------+------+-----+---------+-------------|
+
+  An update writes one field of a record, a read reads all of them, and a
+  read-modify-write (RMW) does both.  A scan reads 1 to -s records: on the
+  map, in key order from a lower_bound; on the unordered_map, in bucket
+  order from the key's bucket.
+
+|------+---------------|
+| Test | Container     |
+|------+---------------|
+|    1 | map           |
+|    2 | unordered_map |
+|------+---------------|
+*/
+
+#include <cctype>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: records loaded before a run
+int  num_records = 100000;
+
+/// configured via command line args: operations per thread and workload
+int  num_ops = 100000;
+
+/// configured via command line args: the most records that a scan reads
+int  max_scan = 100;
+
+/// configured via command line args: which workloads to run
+bool workload_flags[NUM_WORKLOADS] = {false};
+
+/// configured via command line args: a key distribution for every
+/// workload, instead of their own (NULL: their own)
+const char* key_dist_arg = NULL;
+
+const char* const op_names[NUM_OPS] = {
+    "read", "update", "insert", "scan", "rmw"
+};
+
+const ycsb_workload workloads[NUM_WORKLOADS] = {
+    //                                 read upd  ins  scan rmw
+    {'A', "50% read, 50% update",     {50,  50,  0,   0,   0},  dist_zipf},
+    {'B', "95% read, 5% update",      {95,  5,   0,   0,   0},  dist_zipf},
+    {'C', "100% read",                {100, 0,   0,   0,   0},  dist_zipf},
+    {'D', "95% read, 5% insert",      {95,  0,   5,   0,   0},  dist_latest},
+    {'E', "95% scan, 5% insert",      {0,   0,   5,   95,  0},  dist_zipf},
+    {'F', "50% read, 50% rmw",        {50,  0,   0,   0,   50}, dist_zipf},
+};
+
+/// what each thread measured in the current run
+kv_thread_stats* thread_stats;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int>  : specify the number of threads" << endl
+         << "  -r <int>  : specify the number of records to load" << endl
+         << "  -o <int>  : specify the number of operations per thread" << endl
+         << "  -s <int>  : specify the most records that a scan reads" << endl
+         << "  -w <list> : run these workloads, e.g. ACF (default: all)" << endl
+         << "  -K <dist> : key distribution for every workload: uniform," << endl
+         << "              zipf[:theta], hotspot[:keys:draws], sequential," << endl
+         << "              latest[:theta] (default: each workload's own;" << endl
+         << "              see common/workload.h)" << endl
+         << "  -h        : display this message" << endl
+         << "  -T        : enable all tests" << endl
+         << "  -t <int>  : enable a specific test" << endl
+         << "               1 map" << endl
+         << "               2 unordered_map" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 3;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    map_tests,                                          // map.cc
+    unordered_map_tests                                 // unordered_map.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    bool any_workload = false;
+    while ((opt = getopt(argc, argv, "n:r:o:s:w:K:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 'r': num_records = atoi(optarg); break;
+          case 'o': num_ops = atoi(optarg);     break;
+          case 's': max_scan = atoi(optarg);    break;
+          case 'w':
+            for (const char* c = optarg; *c; ++c)
+                for (int w = 0; w < NUM_WORKLOADS; ++w)
+                    if (toupper(*c) == workloads[w].name)
+                        workload_flags[w] = any_workload = true;
+            break;
+          case 'K': key_dist_arg = optarg;      break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (!any_workload)
+        for (int w = 0; w < NUM_WORKLOADS; ++w)
+            workload_flags[w] = true;
+    key_generator check;
+    if (num_records < 1 || max_scan < 1
+        || (key_dist_arg && !check.parse(key_dist_arg, num_records)))
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+    printf("%d records, %d threads\n", num_records, num_threads);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_stats = new kv_thread_stats[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
@@ -0,0 +1,24 @@
+#include <map>
+#include "ycsb.h"
+
+/// A scan is a lower_bound, and then an in-order walk of the tree
+struct map_scan
+{
+    typedef std::map<unsigned long long, kv_value> map_t;
+
+    static unsigned long scan(map_t& c, unsigned long long key, int len)
+    {
+        unsigned long r = 0;
+        auto i = c.lower_bound(key);
+        for (; len > 0 && i != c.end(); --len, ++i)
+            r += i->second.field[0];
+        return r;
+    }
+};
+
+/// Every lookup walks the tree from the root, and every insert can
+/// rebalance along the path to it
+void map_tests(int id)
+{
+    run_ycsb<map_scan::map_t, map_scan>(id, "map");
+}
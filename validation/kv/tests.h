@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "../common/tm.h"
+#include "../common/workload.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// The operations of the YCSB workloads
+enum ycsb_op
+{
+    op_read, op_update, op_insert, op_scan, op_rmw, NUM_OPS
+};
+
+extern const char* const op_names[NUM_OPS];
+
+/// A YCSB workload: the share of each operation, in percent, and the
+/// distribution of the keys that are read, updated and scanned
+struct ycsb_workload
+{
+    char        name;
+    const char* about;
+    int         mix[NUM_OPS];
+    key_dist    dist;
+};
+
+const int NUM_WORKLOADS = 6;
+extern const ycsb_workload workloads[NUM_WORKLOADS];
+
+/// What one thread measured in one run
+struct kv_thread_stats
+{
+    /// the latency of each operation, in nanoseconds, by type
+    std::vector<uint64_t> lat[NUM_OPS];
+
+    /// the time the thread took, in nanoseconds
+    unsigned long long ns;
+
+    /// reads, updates and read-modify-writes that found no record
+    unsigned long misses;
+};
+
+/// configured via the command line
+extern int  num_threads;
+extern int  num_records;
+extern int  num_ops;
+extern int  max_scan;
+extern bool workload_flags[NUM_WORKLOADS];
+extern const char* key_dist_arg;
+
+/// one per thread
+extern kv_thread_stats* thread_stats;
+
+// the containers, from map.cc and unordered_map.cc
+void map_tests(int id);
+void unordered_map_tests(int id);
@@ -0,0 +1,31 @@
+#include <unordered_map>
+#include "ycsb.h"
+
+/// An unordered_map has no key order, so a scan starts at the bucket of its
+/// key, and reads the records in that bucket and in the ones after it, as
+/// the hash-table stores that offer scans do
+struct unordered_map_scan
+{
+    typedef std::unordered_map<unsigned long long, kv_value> map_t;
+
+    static unsigned long scan(map_t& c, unsigned long long key, int len)
+    {
+        unsigned long r = 0;
+        size_t buckets = c.bucket_count();
+        size_t b = c.bucket(key);
+        for (size_t n = 0; len > 0 && n < buckets; ++n) {
+            for (auto i = c.begin(b); len > 0 && i != c.end(b); --len, ++i)
+                r += i->second.field[0];
+            b = b + 1 < buckets ? b + 1 : 0;
+        }
+        return r;
+    }
+};
+
+/// Lookups are a hash and a bucket walk, but every insert writes the
+/// element count, and can rehash the whole table
+void unordered_map_tests(int id)
+{
+    run_ycsb<unordered_map_scan::map_t, unordered_map_scan>
+        (id, "unordered_map");
+}
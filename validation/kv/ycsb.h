@@ -0,0 +1,246 @@
+// -*-c++-*-
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include "tests.h"
+
+/// A record: YCSB's ten fields, at 8 bytes instead of 100 each, so that a
+/// read or a read-modify-write of a whole record fits in an STM's read set
+const int KV_FIELDS = 10;
+struct kv_value
+{
+    unsigned long long field[KV_FIELDS];
+};
+
+/// Record number k is stored under a scrambled key (the splitmix64
+/// finalizer, which is a bijection), so that, as in YCSB, the records are
+/// not inserted in key order, and a scan does not visit them in the order
+/// that they were numbered
+inline unsigned long long kv_key(unsigned long long k)
+{
+    k ^= k >> 30;
+    k *= 0xbf58476d1ce4e5b9ULL;
+    k ^= k >> 27;
+    k *= 0x94d049bb133111ebULL;
+    k ^= k >> 31;
+    return k;
+}
+
+/**
+ * The operations on one container type.  Ops only has to supply scan(),
+ * which depends on whether the container is ordered:
+ *
+ *   static unsigned long scan(C&, unsigned long long k, int len)
+ *
+ * scans up to len records from record k, and returns a sum of what it read.
+ */
+template <class C, class Ops>
+struct kv_ops : Ops
+{
+    /// read a whole record
+    static bool read(C& c, unsigned long long key, unsigned long& sink)
+    {
+        auto i = c.find(key);
+        if (i == c.end())
+            return false;
+        kv_value v = i->second;
+        for (int f = 0; f < KV_FIELDS; ++f)
+            sink += v.field[f];
+        return true;
+    }
+
+    /// write one field of a record
+    static bool update(C& c, unsigned long long key, int f,
+                       unsigned long long x)
+    {
+        auto i = c.find(key);
+        if (i == c.end())
+            return false;
+        i->second.field[f] = x;
+        return true;
+    }
+
+    /// read a whole record, and write one field of it
+    static bool rmw(C& c, unsigned long long key, int f)
+    {
+        auto i = c.find(key);
+        if (i == c.end())
+            return false;
+        unsigned long long sum = 0;
+        for (int g = 0; g < KV_FIELDS; ++g)
+            sum += i->second.field[g];
+        i->second.field[f] = sum;
+        return true;
+    }
+
+    static void insert(C& c, unsigned long long key, const kv_value& v)
+    {
+        c.insert(std::make_pair(key, v));
+    }
+};
+
+/// the value at quantile q of sorted latencies, in microseconds
+inline double kv_percentile(const std::vector<uint64_t>& lat, double q)
+{
+    if (lat.empty())
+        return 0;
+    size_t i = (size_t)(q * (lat.size() - 1) + 0.5);
+    return lat[i] / 1e3;
+}
+
+/**
+ * Run each requested YCSB workload on one shared container.  For each
+ * workload, the threads load num_records records, each insert a
+ * transaction of its own, and then each thread runs num_ops operations
+ * from the workload's mix, again each a transaction.  Thread 0 reports the
+ * throughput of both phases, and the latency percentiles of each type of
+ * operation, over all threads.  A latency includes the time spent on
+ * retries, or waiting for the lock in the notm build.
+ *
+ * Keys come from the workload's distribution over the records inserted so
+ * far (or from -K's, when it is given).  Inserts take the next record
+ * number from a shared counter, so a key can be drawn just before its
+ * record is inserted: those operations count as misses.
+ */
+template <class C, class Ops>
+void run_ycsb(int id, const char* name)
+{
+    typedef std::chrono::steady_clock clock;
+    typedef kv_ops<C, Ops> ops;
+    static C* store = NULL;
+    static key_generator proto;
+    static std::atomic<unsigned long> next_record;
+    static std::atomic<unsigned long> sink;
+
+    for (int w = 0; w < NUM_WORKLOADS; ++w) {
+        if (!workload_flags[w])
+            continue;
+        const ycsb_workload& wl = workloads[w];
+        kv_thread_stats& st = thread_stats[id];
+
+        if (id == 0) {
+            store = new C();
+            next_record = num_records;
+            proto = key_generator(wl.dist, num_records);
+            if (key_dist_arg)
+                proto.parse(key_dist_arg, num_records);
+        }
+        global_barrier->arrive(id);
+
+        // load: each thread inserts its share of the records
+        kv_value v;
+        for (int f = 0; f < KV_FIELDS; ++f)
+            v.field[f] = f;
+        auto start = clock::now();
+        for (int k = id; k < num_records; k += num_threads) {
+            BEGIN_TX;
+            ops::insert(*store, kv_key(k), v);
+            END_TX;
+        }
+        st.ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (clock::now() - start).count();
+        global_barrier->arrive(id);
+        if (id == 0) {
+            unsigned long long ns = 0;
+            for (int i = 0; i < num_threads; ++i)
+                ns = std::max(ns, thread_stats[i].ns);
+            printf("  %-14s %c load %10d records      %10.3f ms %8.3f Mops/s\n",
+                   name, wl.name, num_records, ns / 1e6,
+                   ns ? num_records * 1e3 / ns : 0.0);
+        }
+
+        // run: a fixed seed per thread, so that every run draws the same
+        // keys and operations
+        key_generator gen = proto;
+        gen.seed(id + 1);
+        for (int o = 0; o < NUM_OPS; ++o) {
+            st.lat[o].clear();
+            st.lat[o].reserve(num_ops * wl.mix[o] / 100 + 16);
+        }
+        st.misses = 0;
+        unsigned long r = 0;
+        start = clock::now();
+        for (int i = 0; i < num_ops; ++i) {
+            // choose the operation and its arguments outside of the
+            // transaction: drawing a key is not transaction-safe
+            int p = gen.percent(), o = 0;
+            while (o < NUM_OPS - 1 && p >= wl.mix[o]) {
+                p -= wl.mix[o];
+                ++o;
+            }
+            unsigned long long key;
+            if (o == op_insert) {
+                unsigned long k = next_record++;
+                key = kv_key(k);
+                v.field[0] = k;
+            }
+            else
+                key = kv_key(gen.next());
+            int f = gen.percent() % KV_FIELDS;
+            int len = 1 + gen.percent() * max_scan / 100;
+            bool found = true;
+
+            auto op_start = clock::now();
+            BEGIN_TX;
+            switch (o) {
+              case op_read:   found = ops::read(*store, key, r);  break;
+              case op_update: found = ops::update(*store, key, f, i); break;
+              case op_insert: ops::insert(*store, key, v);        break;
+              case op_scan:   r += ops::scan(*store, key, len);   break;
+              case op_rmw:    found = ops::rmw(*store, key, f);   break;
+            }
+            END_TX;
+            st.lat[o].push_back(std::chrono::duration_cast
+                                <std::chrono::nanoseconds>
+                                (clock::now() - op_start).count());
+            st.misses += !found;
+            // the records inserted so far are the ones to draw from
+            if (o == op_insert)
+                gen.grow(next_record);
+        }
+        st.ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (clock::now() - start).count();
+        // keep the reads from being optimized away
+        sink.fetch_add(r, std::memory_order_relaxed);
+        global_barrier->arrive(id);
+
+        // the run took as long as its slowest thread
+        if (id == 0) {
+            unsigned long long ns = 0;
+            unsigned long misses = 0;
+            for (int i = 0; i < num_threads; ++i) {
+                ns = std::max(ns, thread_stats[i].ns);
+                misses += thread_stats[i].misses;
+            }
+            double total = (double)num_ops * num_threads;
+            char dist[64];
+            proto.describe(dist, sizeof(dist));
+            printf("  %-14s %c run  %10d ops/thread   %10.3f ms %8.3f Mops/s"
+                   "  (%s; %s keys, %lu misses)\n", name, wl.name, num_ops,
+                   ns / 1e6, ns ? total * 1e3 / ns : 0.0, wl.about, dist,
+                   misses);
+            for (int o = 0; o < NUM_OPS; ++o) {
+                std::vector<uint64_t> all;
+                for (int i = 0; i < num_threads; ++i)
+                    all.insert(all.end(), thread_stats[i].lat[o].begin(),
+                               thread_stats[i].lat[o].end());
+                if (all.empty())
+                    continue;
+                std::sort(all.begin(), all.end());
+                printf("      %-7s %10zu ops   latency (us): p50 %8.2f  "
+                       "p90 %8.2f  p99 %8.2f  p99.9 %8.2f  max %9.2f\n",
+                       op_names[o], all.size(), kv_percentile(all, 0.5),
+                       kv_percentile(all, 0.9), kv_percentile(all, 0.99),
+                       kv_percentile(all, 0.999), all.back() / 1e3);
+            }
+        }
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete store;
+            store = NULL;
+        }
+    }
+}
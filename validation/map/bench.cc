@@ -82,6 +82,13 @@
 |                   | clear                 | 1                  |                      1 |
 |                   | emplace               | 1                  |                      1 |
 |                   | emplace_hint          | 1                  |                      1 |
+|                   | try_emplace (C++17)   |                    |                   1, 2 |
+|                   | insert_or_assign      |                    |                   1, 2 |
+|                   | (C++17)               |                    |                        |
+|                   | extract (C++17)       |                    |                      1 |
+|                   | insert node_type      |                    |                   1, 2 |
+|                   | (C++17)               |                    |                        |
+|                   | merge (C++17)         |                    |                      1 |
 |-------------------+-----------------------+--------------------+------------------------|
 | Observers         | get_allocator         | 1                  |                      1 |
 | (DONE)            | key_comp              | 1                  |                      1 |
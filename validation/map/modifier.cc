@@ -15,12 +15,181 @@ struct Foo
 };
 std::map<int, Foo>* modifier_map_special = NULL;
 
+#ifdef USE_TM
+/// try_emplace and insert_or_assign are from C++17, and of the libraries
+/// we build with, only the TM one has them
+void try_emplace_tests(int id)
+{
+    // test try_emplace (1): only a missing key makes a pair, and the mapped
+    // type need not be default constructible
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {2, 2}, {3, 3}});
+        auto r1 = modifier_map->try_emplace(8, 8);
+        auto r2 = modifier_map->try_emplace(2, 20);
+        ok = r1.second && !r2.second && r2.first->second == 2;
+        modifier_map_special = new std::map<int, Foo>();
+        ok = ok && modifier_map_special->try_emplace(5, 5).second
+                && modifier_map_special->at(5).x == 5;
+        delete(modifier_map_special);
+        v.insert_all(modifier_map);
+        delete(modifier_map);
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in try_emplace()" << std::endl;
+        v.check("try_emplace (1)", id, 8, {1, 1, 2, 2, 3, 3, 8, 8});
+    }
+
+    // test try_emplace with hint (2)
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {8, 8}, {7, 7}});
+        auto i = modifier_map->try_emplace(modifier_map->end(), 30, 30);
+        auto j = modifier_map->try_emplace(modifier_map->begin(), 7, 70);
+        ok = i->first == 30 && j->second == 7;
+        v.insert_all(modifier_map);
+        delete(modifier_map);
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in try_emplace()" << std::endl;
+        v.check("try_emplace (2)", id, 8, {1, 1, 7, 7, 8, 8, 30, 30});
+    }
+
+    // test insert_or_assign (1)
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {2, 2}, {3, 3}});
+        auto r1 = modifier_map->insert_or_assign(2, 20);
+        auto r2 = modifier_map->insert_or_assign(8, 8);
+        ok = !r1.second && r2.second;
+        v.insert_all(modifier_map);
+        delete(modifier_map);
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in insert_or_assign()" << std::endl;
+        v.check("insert_or_assign (1)", id, 8, {1, 1, 2, 20, 3, 3, 8, 8});
+    }
+
+    // test insert_or_assign with hint (2)
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {8, 8}, {7, 7}});
+        modifier_map->insert_or_assign(modifier_map->end(), 30, 30);
+        modifier_map->insert_or_assign(modifier_map->begin(), 7, 70);
+        v.insert_all(modifier_map);
+        delete(modifier_map);
+        END_TX;
+        v.check("insert_or_assign (2)", id, 8, {1, 1, 7, 70, 8, 8, 30, 30});
+    }
+}
+
+/// Node handles are from C++17 too: extract, insert of a node_type, and
+/// merge move elements between maps by relinking their nodes
+void node_handle_tests(int id)
+{
+    // test extract, by key and by position (1)
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {2, 2}, {3, 3}, {8, 8}});
+        auto n1 = modifier_map->extract(2);
+        auto n2 = modifier_map->extract(modifier_map->find(8));
+        auto n3 = modifier_map->extract(5);
+        ok = !n1.empty() && n1.key() == 2 && n1.mapped() == 2
+          && !n2.empty() && n2.key() == 8 && n3.empty();
+        v.insert_all(modifier_map);
+        delete(modifier_map);
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in extract()" << std::endl;
+        v.check("extract (1)", id, 4, {1, 1, 3, 3});
+    }
+
+    // test insert of a node_type (1): the node goes in if its key is new,
+    // and otherwise comes back in the result
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {2, 2}, {3, 3}});
+        std::map<int, int>* other = new std::map<int, int>({{3, 30}});
+        auto r1 = other->insert(modifier_map->extract(2));
+        auto r2 = other->insert(modifier_map->extract(3));
+        ok = r1.inserted && r1.node.empty() && r1.position->first == 2
+          && !r2.inserted && r2.node.mapped() == 3
+          && r2.position->second == 30 && modifier_map->size() == 1;
+        v.insert_all(other);
+        delete(other);
+        delete(modifier_map);
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in insert(node_type&&)" << std::endl;
+        v.check("insert node_type (1)", id, 4, {2, 2, 3, 30});
+    }
+
+    // test insert of a node_type with hint (2), after changing its key
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {8, 8}, {7, 7}});
+        auto n = modifier_map->extract(1);
+        n.key() = 30;
+        modifier_map->insert(modifier_map->end(), std::move(n));
+        v.insert_all(modifier_map);
+        delete(modifier_map);
+        END_TX;
+        v.check("insert node_type (2)", id, 6, {7, 7, 8, 8, 30, 1});
+    }
+
+    // test merge (1), from a map with the opposite order: keys that are
+    // already here stay in the source
+    global_barrier->arrive(id);
+    {
+        map_verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        modifier_map = new std::map<int, int>({{1, 1}, {2, 2}, {7, 7}});
+        std::map<int, int, std::greater<int>>* other =
+            new std::map<int, int, std::greater<int>>({{2, 20}, {5, 50}});
+        modifier_map->merge(*other);
+        ok = other->size() == 1 && other->begin()->second == 20;
+        v.insert_all(modifier_map);
+        delete(other);
+        delete(modifier_map);
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in merge()" << std::endl;
+        v.check("merge (1)", id, 8, {1, 1, 2, 2, 5, 50, 7, 7});
+    }
+}
+#endif
+
 void modifier_tests(int id)
 {
     global_barrier->arrive(id);
     if (id == 0)
         printf("Testing map modifier functions: insert(6), erase(4), "
-               "swap(1), clear(1), emplace(1), emplace_hint(1)\n");
+               "swap(1), clear(1), emplace(1), emplace_hint(1)"
+#ifdef USE_TM
+               ", try_emplace(2), insert_or_assign(2), extract(1),"
+               " insert node_type(2), merge(1)"
+#endif
+               "\n");
 
     // test insert of single element value_type (1a)
     //
@@ -221,5 +390,10 @@ void modifier_tests(int id)
         END_TX;
         v.check("emplace_hint (1)", id, 8, {1, 1, 7, 7, 8, 8, 30, 30});
     }
+
+#ifdef USE_TM
+    try_emplace_tests(id);
+    node_handle_tests(id);
+#endif
 }
 
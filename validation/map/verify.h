@@ -2,38 +2,34 @@
 #pragma once
 
 #include <initializer_list>
+#include "../common/fingerprint.h"
 using std::initializer_list;
 
+/// Checks the keys and values of a map, interleaved, against the expected
+/// list, in key order
 class map_verifier
 {
-    /// max number of things we can store in the verifier
-    static const int SIZE = 256;
-
-    /// storage for stuff we need to verify
-    int data[SIZE];
+    /// fingerprint of the values inserted so far
+    fingerprint seen;
     int count;
 
   public:
-    /// construct by filling with -2 and setting count to 0
-    map_verifier() : count(0)
-    {
-        for (int i = 0; i < SIZE; ++i) {
-            data[i] = -2;
-        }
-    }
+    /// construct with nothing seen and count at 0
+    map_verifier() : count(0) { }
 
     /// add something to the verifier
     void insert(int i)
     {
-        data[count++] = i;
+        seen.add(i);
+        ++count;
     }
 
     template <class T>
     void insert_all(T* in)
     {
         for (auto i : *in) {
-            data[count++] = i.first;
-            data[count++] = i.second;
+            insert(i.first);
+            insert(i.second);
         }
     }
 
@@ -41,14 +37,13 @@ class map_verifier
     void check(const char* test_name, int thread_id, int expected_size,
                initializer_list<int> expected_data)
     {
-        bool ok = true;
-        int  c  = 0;
-        for (auto i : expected_data)
-            ok &= (i == data[c++]);
+        fingerprint expected;
+        bool ok = expected.add_expected(expected_data, expected_size)
+               && seen.same_sequence(expected);
         if (count != expected_size)
             printf(" [%d] size did not match %d != %d\n", thread_id, count, expected_size);
         else if (!ok)
-            printf(" [%d] array copy did not match\n");
+            printf(" [%d] contents did not match\n", thread_id);
         else if (thread_id == 0)
             printf(" [OK::count+data] %s\n", test_name);
     }
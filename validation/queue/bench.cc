@@ -0,0 +1,132 @@
+/*
+  Producer-consumer benchmark for std::queue
+
+  Producer threads push items into a std::queue<T, std::deque<T>> that all
+  threads share, and consumer threads pop them, a batch of items per
+  critical section.  It reports the throughput, and the time from the push
+  of each item to its pop.  This tells whether a TM-protected deque is
+  viable as a work queue: run the same test in bench_tm and bench_notm, or
+  compare the two tests of bench_tm, whose second test always uses a lock.
+
+|------+--------------+------------------------------------------------------|
+| Test | Name         | Critical sections                                    |
+|------+--------------+------------------------------------------------------|
+|    1 | transactions | BEGIN_TX/END_TX (global_mutex in the notm build)     |
+|    2 | mutex        | a std::mutex, in every build                         |
+|------+--------------+------------------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// number of threads: the producers, and then the consumers
+int  num_threads;
+
+/// configured via command line args: number of producer threads
+int  num_producers = 1;
+
+/// configured via command line args: number of consumer threads
+int  num_consumers = 1;
+
+/// configured via command line args: items that each producer pushes
+int  num_items = 100000;
+
+/// configured via command line args: items per push or pop transaction
+int  batch_size = 1;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -p <int> : specify the number of producer threads" << endl
+         << "  -c <int> : specify the number of consumer threads" << endl
+         << "  -i <int> : specify the number of items per producer" << endl
+         << "  -b <int> : specify the most items per push or pop" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 transactions" << endl
+         << "               2 mutex" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 3;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    tx_queue_tests,                                     // pipe.cc
+    mutex_queue_tests                                   // pipe.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "p:c:i:b:hTt:")) != -1) {
+        switch (opt) {
+          case 'p': num_producers = atoi(optarg); break;
+          case 'c': num_consumers = atoi(optarg); break;
+          case 'i': num_items = atoi(optarg);     break;
+          case 'b': batch_size = atoi(optarg);    break;
+          case 'h': usage();                      break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (num_producers < 1 || num_consumers < 1 || num_items < 1
+        || batch_size < 1)
+        usage();
+    num_threads = num_producers + num_consumers;
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
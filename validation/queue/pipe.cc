@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "tests.h"
+
+/// An item carries the time that it was pushed, for its end-to-end latency,
+/// and a number that is unique over all producers, to check that every item
+/// is popped exactly once
+struct queue_item
+{
+    unsigned long long pushed_ns;
+    unsigned long      seq;
+};
+
+typedef std::queue<queue_item, std::deque<queue_item>> item_queue;
+
+/// The queue that every thread shares
+item_queue* the_queue = NULL;
+
+/// The lock of the mutex runs, which is not the one that BEGIN_TX takes
+std::mutex queue_mutex;
+
+/// The items of the current run that are yet to be popped
+std::atomic<long> items_left;
+
+/// What one consumer measured in the current run
+struct consumer_stats
+{
+    std::vector<uint64_t> lat;          // of each item, in nanoseconds
+    unsigned long         count;        // items popped
+    unsigned long         seq_sum;      // sum of their numbers
+    unsigned long         empty_pops;   // pops that found the queue empty
+};
+
+consumer_stats*     stats = NULL;
+unsigned long long* thread_ns = NULL;
+
+namespace
+{
+    unsigned long long now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+            (std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// push n items, in order
+    void push_batch(item_queue& q, const queue_item* items, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            q.push(items[i]);
+    }
+
+    /// pop up to n items; returns how many there were
+    int pop_batch(item_queue& q, queue_item* items, int n)
+    {
+        int i = 0;
+        for (; i < n && !q.empty(); ++i) {
+            items[i] = q.front();
+            q.pop();
+        }
+        return i;
+    }
+
+    /// the value at quantile q of sorted latencies, in microseconds
+    double percentile(const std::vector<uint64_t>& lat, double q)
+    {
+        if (lat.empty())
+            return 0;
+        return lat[(size_t)(q * (lat.size() - 1) + 0.5)] / 1e3;
+    }
+
+    /**
+     * One producer-consumer run.  The first num_producers threads each
+     * push num_items items, batch_size per critical section, and the
+     * others pop up to batch_size per critical section until every item
+     * has been popped.  A critical section is a transaction if USE_TX
+     * (which, in the notm build, takes global_mutex), and otherwise holds
+     * queue_mutex, whatever the build.  Thread 0 reports the throughput,
+     * the latency from push to pop of every item, and whether every item
+     * was popped once.
+     */
+    template <bool USE_TX>
+    void run_queue_test(int id, const char* name)
+    {
+        if (id == 0) {
+            the_queue = new item_queue();
+            items_left = (long)num_producers * num_items;
+            stats = new consumer_stats[num_consumers];
+            thread_ns = new unsigned long long[num_threads];
+        }
+        global_barrier->arrive(id);
+
+        std::vector<queue_item> buf(batch_size);
+        unsigned long long start = now_ns();
+        if (id < num_producers) {
+            for (int i = 0; i < num_items; i += batch_size) {
+                int n = std::min(batch_size, num_items - i);
+                unsigned long long t = now_ns();
+                for (int j = 0; j < n; ++j) {
+                    buf[j].pushed_ns = t;
+                    buf[j].seq = (unsigned long)id * num_items + i + j;
+                }
+                if (USE_TX) {
+                    BEGIN_TX;
+                    push_batch(*the_queue, buf.data(), n);
+                    END_TX;
+                }
+                else {
+                    std::lock_guard<std::mutex> g(queue_mutex);
+                    push_batch(*the_queue, buf.data(), n);
+                }
+            }
+        }
+        else {
+            consumer_stats& st = stats[id - num_producers];
+            st.lat.reserve((size_t)num_producers * num_items / num_consumers);
+            st.count = st.seq_sum = st.empty_pops = 0;
+            while (items_left > 0) {
+                int n;
+                if (USE_TX) {
+                    BEGIN_TX;
+                    n = pop_batch(*the_queue, buf.data(), batch_size);
+                    END_TX;
+                }
+                else {
+                    std::lock_guard<std::mutex> g(queue_mutex);
+                    n = pop_batch(*the_queue, buf.data(), batch_size);
+                }
+                if (n == 0) {
+                    ++st.empty_pops;
+                    std::this_thread::yield();
+                    continue;
+                }
+                unsigned long long t = now_ns();
+                for (int j = 0; j < n; ++j) {
+                    st.lat.push_back(t - buf[j].pushed_ns);
+                    st.seq_sum += buf[j].seq;
+                }
+                st.count += n;
+                items_left -= n;
+            }
+        }
+        thread_ns[id] = now_ns() - start;
+        global_barrier->arrive(id);
+
+        // the run took as long as its slowest thread
+        if (id == 0) {
+            unsigned long long ns = *std::max_element(thread_ns,
+                                                      thread_ns + num_threads);
+            unsigned long total = (unsigned long)num_producers * num_items;
+            unsigned long count = 0, seq_sum = 0, empty_pops = 0;
+            std::vector<uint64_t> all;
+            for (int c = 0; c < num_consumers; ++c) {
+                count += stats[c].count;
+                seq_sum += stats[c].seq_sum;
+                empty_pops += stats[c].empty_pops;
+                all.insert(all.end(), stats[c].lat.begin(), stats[c].lat.end());
+            }
+            std::sort(all.begin(), all.end());
+            if (count != total || seq_sum != total * (total - 1) / 2)
+                printf(" [%s] popped %lu of %lu items, or some twice\n", name,
+                       count, total);
+            printf("  %-12s %2d producers %2d consumers batch %4d %10lu items "
+                   "%10.3f ms %8.3f Mitems/s %10lu empty pops\n", name,
+                   num_producers, num_consumers, batch_size, total, ns / 1e6,
+                   ns ? total * 1e3 / ns : 0.0, empty_pops);
+            printf("      latency (us): p50 %8.2f  p90 %8.2f  p99 %8.2f  "
+                   "p99.9 %8.2f  max %9.2f\n", percentile(all, 0.5),
+                   percentile(all, 0.9), percentile(all, 0.99),
+                   percentile(all, 0.999), all.empty() ? 0 : all.back() / 1e3);
+        }
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete the_queue;
+            the_queue = NULL;
+            delete[] stats;
+            delete[] thread_ns;
+        }
+    }
+}
+
+/// Every push and pop is a transaction (or holds global_mutex, in notm)
+void tx_queue_tests(int id)
+{
+    run_queue_test<true>(id, "transactions");
+}
+
+/// Every push and pop holds a mutex, in every build: the baseline that the
+/// transactions of the same binary are compared to
+void mutex_queue_tests(int id)
+{
+    run_queue_test<false>(id, "mutex");
+}
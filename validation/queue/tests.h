@@ -0,0 +1,20 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// configured via the command line
+extern int  num_threads;
+extern int  num_producers;
+extern int  num_consumers;
+extern int  num_items;
+extern int  batch_size;
+
+// producer-consumer runs, from pipe.cc
+void tx_queue_tests(int id);
+void mutex_queue_tests(int id);
@@ -0,0 +1,197 @@
+/*
+  Driver that replays a recorded trace log as a benchmark
+
+  Build any program against the trace library with "make TRACE_RECORD=1",
+  and run it, to get a log of every STL method that it calls (see
+  libstdc++_trace/trace.h and tracelog.h).  This program reads such a log,
+  and runs the same calls against whichever library it was built with, so
+  that one recorded workload can be compared across bench_tm, bench_notm
+  and bench_trace.  See replay.h for how calls are replayed.
+
+|--------------------+-------------------------------------------------------|
+| Container          | Methods replayed                                      |
+|--------------------+-------------------------------------------------------|
+| list, vector,      | push/emplace_back and _front, pop_back and _front,    |
+| deque              | insert, emplace, erase, find, count, at, operator[],  |
+|                    | front, back, size, empty, begin, clear, resize        |
+| list               | sort, reverse, unique                                 |
+| map, unordered_set | insert, emplace, emplace_hint, erase, find, count,    |
+| unordered_multiset | at, operator[], size, empty, begin, clear             |
+| unordered_map      |                                                       |
+|--------------------+-------------------------------------------------------|
+
+  begin, end, and their c and r forms, are all replayed as begin() != end().
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "../common/workload.h"
+#include "replay.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: the log to replay
+const char* log_file = NULL;
+
+/// configured via command line args: number of threads (0: one per
+/// recorded thread)
+int  num_threads = 0;
+
+/// configured via command line args: keys are drawn from [0, num_keys)
+int  num_keys = 1024;
+
+/// configured via command line args: the distribution of keys
+key_generator key_gen;
+
+/// configured via command line args: times to replay each thread's calls
+int  num_passes = 1;
+
+/// configured via command line args: print the log instead of replaying it
+bool dump_only = false;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// the log being replayed
+replay_log the_log;
+
+/// the time each thread took, in nanoseconds
+unsigned long long* thread_ns;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -f <file> : the log to replay (required)" << endl
+         << "  -n <int>  : specify the number of threads (default: one per"
+         << " recorded thread)" << endl
+         << "  -k <int>  : draw the keys that the log does not have from"
+         << " [0, k) (default 1024)" << endl
+         << "  -K <dist> : key distribution: uniform, zipf[:theta]," << endl
+         << "              hotspot[:keys:draws], sequential, latest[:theta]" << endl
+         << "              (default: uniform; see common/workload.h)" << endl
+         << "  -p <int>  : replay each thread's calls this many times" << endl
+         << "  -d        : print the log instead of replaying it" << endl
+         << "  -h        : display this message" << endl << endl;
+    exit(0);
+}
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    const char* dist = "uniform";
+    while ((opt = getopt(argc, argv, "f:n:k:K:p:dh")) != -1) {
+        switch (opt) {
+          case 'f': log_file = optarg;          break;
+          case 'n': num_threads = atoi(optarg); break;
+          case 'k': num_keys = atoi(optarg);    break;
+          case 'K': dist = optarg;              break;
+          case 'p': num_passes = atoi(optarg);  break;
+          case 'd': dump_only = true;           break;
+          case 'h': usage();                    break;
+        }
+    }
+    if (!log_file || !key_gen.parse(dist, num_keys))
+        usage();
+}
+
+/// Replay one recorded thread's calls.  Thread id replays recorded thread
+/// id modulo the number of recorded threads, with keys of its own for the
+/// calls that did not log one.
+void per_thread_test(int id)
+{
+    const std::vector<replay_op>& ops =
+        the_log.threads[id % the_log.threads.size()];
+
+    // a fixed seed per thread, so that every run draws the same keys
+    key_generator gen = key_gen;
+    gen.seed(id + 1);
+
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < num_passes; ++pass) {
+        for (const replay_op& op : ops)
+            run_op(op, gen.next());
+    }
+    thread_ns[id] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+/// main() reads the log, makes a barrier, starts threads, and reports
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+    if (dump_only)
+        return dump_log(log_file) ? 0 : 1;
+    if (!load_log(log_file, the_log) || the_log.threads.empty()) {
+        fprintf(stderr, "%s: nothing to replay\n", log_file);
+        return 1;
+    }
+    if (num_threads <= 0)
+        num_threads = the_log.threads.size();
+
+    unsigned long total = 0;
+    for (auto& t : the_log.threads)
+        total += t.size();
+    char dist[64];
+    key_gen.describe(dist, sizeof(dist));
+    printf("Replaying %lu calls from %zu recorded threads (%.3f ms recorded) "
+           "on %d threads, %d time(s), %s keys\n", total,
+           the_log.threads.size(), the_log.span_ns / 1e6, num_threads,
+           num_passes, dist);
+    for (int c = 0; c < RC_COUNT; ++c)
+        if (the_log.instances[c])
+            printf("  %u %s container(s)\n", the_log.instances[c],
+                   container_names[c]);
+    const size_t SHOW_SKIPPED = 10;
+    for (size_t i = 0; i < the_log.skipped.size() && i < SHOW_SKIPPED; ++i)
+        printf("  not replayed: %8lu x %s\n", the_log.skipped[i].calls,
+               the_log.skipped[i].label.c_str());
+    if (the_log.skipped.size() > SHOW_SKIPPED)
+        printf("  not replayed: %zu other methods\n",
+               the_log.skipped.size() - SHOW_SKIPPED);
+
+    // make the containers, and set up the barrier
+    make_containers(the_log);
+    global_barrier = new barrier(num_threads);
+    thread_ns = new unsigned long long[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+
+    // the run took as long as its slowest thread
+    unsigned long long ns = 0;
+    unsigned long calls = 0;
+    for (int i = 0; i < num_threads; ++i) {
+        size_t n = the_log.threads[i % the_log.threads.size()].size() * num_passes;
+        printf("  thread %2d: %10zu calls in %10.3f ms\n", i, n,
+               thread_ns[i] / 1e6);
+        ns = std::max(ns, thread_ns[i]);
+        calls += n;
+    }
+    printf("Total: %lu calls in %.3f ms, %.0f calls/s\n", calls, ns / 1e6,
+           ns ? calls * 1e9 / ns : 0.0);
+}
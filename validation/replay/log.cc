@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include "../../libstdc++_trace/tracelog.h"
+#include "replay.h"
+
+const char* const container_names[RC_COUNT] = {
+    "list", "vector", "deque", "map", "unordered_set", "unordered_multiset",
+    "unordered_map"
+};
+
+const char* const method_names[RM_COUNT] = {
+    "push_back", "push_front", "pop_back", "pop_front", "insert", "erase",
+    "find", "count", "operator[]", "front", "back", "size", "empty", "begin",
+    "clear", "resize", "sort", "reverse", "unique"
+};
+
+namespace
+{
+    /// A site from the sites chunk
+    struct site
+    {
+        std::string label;
+        std::string file;
+        int         line;
+    };
+
+    /// The contents of a log file
+    struct raw_log
+    {
+        std::vector<std::vector<tracelog_event>> threads;
+        std::map<unsigned, site>                 sites;
+    };
+
+    /// Read a whole log
+    bool read_log(const char* file, raw_log& log)
+    {
+        FILE* f = fopen(file, "rb");
+        if (!f) {
+            perror(file);
+            return false;
+        }
+        tracelog_header h;
+        if (fread(&h, sizeof(h), 1, f) != 1
+            || memcmp(h.magic, TRACELOG_MAGIC, sizeof(TRACELOG_MAGIC))) {
+            fprintf(stderr, "%s: not a trace log\n", file);
+            fclose(f);
+            return false;
+        }
+        tracelog_chunk c;
+        while (fread(&c, sizeof(c), 1, f) == 1) {
+            if (c.kind == tracelog_events) {
+                if (log.threads.size() <= c.thread)
+                    log.threads.resize(c.thread + 1);
+                std::vector<tracelog_event>& t = log.threads[c.thread];
+                size_t old = t.size();
+                t.resize(old + c.count);
+                if (fread(&t[old], sizeof(tracelog_event), c.count, f) != c.count)
+                    break;
+            }
+            else if (c.kind == tracelog_sites) {
+                for (uint64_t i = 0; i < c.count; ++i) {
+                    tracelog_site_record r;
+                    if (fread(&r, sizeof(r), 1, f) != 1)
+                        break;
+                    site& s = log.sites[r.index];
+                    s.label.resize(r.label_len);
+                    s.file.resize(r.file_len);
+                    s.line = r.line;
+                    if ((r.label_len && fread(&s.label[0], 1, r.label_len, f) != r.label_len)
+                        || (r.file_len && fread(&s.file[0], 1, r.file_len, f) != r.file_len))
+                        break;
+                }
+            }
+            else {
+                fprintf(stderr, "%s: unknown chunk kind %u\n", file, c.kind);
+                break;
+            }
+        }
+        fclose(f);
+        if (log.sites.empty()) {
+            fprintf(stderr, "%s: no sites (was the recording cut short?)\n",
+                    file);
+            return false;
+        }
+        return true;
+    }
+
+    /// The container whose TRACEs are in a header, or RC_COUNT
+    int container_of(const std::string& path)
+    {
+        static const struct { const char* file; replay_container c; } files[] = {
+            {"stl_list.h", rc_list}, {"list.tcc", rc_list},
+            {"stl_vector.h", rc_vector}, {"vector.tcc", rc_vector},
+            {"stl_deque.h", rc_deque}, {"deque.tcc", rc_deque},
+            {"stl_map.h", rc_map}, {"unordered_set.h", rc_unordered_set},
+            {"unordered_map.h", rc_unordered_map}
+        };
+        std::string base = path.substr(path.rfind('/') + 1);
+        for (auto& f : files)
+            if (base == f.file)
+                return f.c;
+        return RC_COUNT;
+    }
+
+    /// Does the label have this word in it, not as part of a longer name?
+    bool has_word(const std::string& label, const char* word)
+    {
+        size_t len = strlen(word);
+        for (size_t at = label.find(word); at != std::string::npos;
+             at = label.find(word, at + 1)) {
+            bool start = at == 0 || !(isalnum(label[at - 1]) || label[at - 1] == '_');
+            size_t end = at + len;
+            bool stop = end == label.size()
+                     || !(isalnum(label[end]) || label[end] == '_');
+            if (start && stop)
+                return true;
+        }
+        return false;
+    }
+
+    /// The method that a label names, or RM_COUNT.  Iterator methods, and
+    /// constructors, destructors and assignments, name none, and are not
+    /// replayed.
+    int method_of(const std::string& label)
+    {
+        static const struct { const char* word; replay_method m; } words[] = {
+            {"push_back", rm_push_back}, {"emplace_back", rm_push_back},
+            {"push_front", rm_push_front}, {"emplace_front", rm_push_front},
+            {"pop_back", rm_pop_back}, {"pop_front", rm_pop_front},
+            {"insert", rm_insert}, {"emplace", rm_insert},
+            {"emplace_hint", rm_insert}, {"erase", rm_erase},
+            {"find", rm_find}, {"count", rm_count}, {"at", rm_index},
+            {"operator[]", rm_index}, {"front", rm_front}, {"back", rm_back},
+            {"size", rm_size}, {"empty", rm_empty}, {"begin", rm_begin},
+            {"cbegin", rm_begin}, {"rbegin", rm_begin}, {"crbegin", rm_begin},
+            {"end", rm_begin}, {"cend", rm_begin}, {"rend", rm_begin},
+            {"crend", rm_begin}, {"clear", rm_clear}, {"resize", rm_resize},
+            {"sort", rm_sort}, {"reverse", rm_reverse}, {"unique", rm_unique}
+        };
+        for (auto& w : words) {
+            if (!has_word(label, w.word))
+                continue;
+            // an iterator's operator[] is not the container's
+            if (w.m == rm_index && label.find("iterator") != std::string::npos)
+                return RM_COUNT;
+            return w.m;
+        }
+        return RM_COUNT;
+    }
+
+    /// Can a method be replayed on a container?  Only sequences resize, and
+    /// only lists sort, reverse and unique themselves.
+    bool replayable(int c, int m)
+    {
+        if (m == rm_resize)
+            return c == rc_list || c == rc_vector || c == rc_deque;
+        if (m >= rm_sort)
+            return c == rc_list;
+        return true;
+    }
+}
+
+/// Read a log, and work out which call each top-level event is
+bool load_log(const char* file, replay_log& log)
+{
+    raw_log raw;
+    if (!read_log(file, raw))
+        return false;
+
+    // work out each site once
+    std::map<unsigned, replay_op> ops;
+    for (auto& s : raw.sites) {
+        int c = container_of(s.second.file);
+        int m = method_of(s.second.label);
+        if (c != RC_COUNT && m != RM_COUNT)
+            ops[s.first] = replay_op{(unsigned char)c, (unsigned char)m,
+                                     false, 0, 0};
+    }
+
+    // unordered_multiset shares its header with unordered_set
+    for (auto& s : raw.sites)
+        if (ops.count(s.first) && s.second.label.find("unordered_multiset") == 0)
+            ops[s.first].container = rc_unordered_multiset;
+
+    // a method that the replay cannot run on its container is not replayed
+    for (auto o = ops.begin(); o != ops.end(); )
+        if (replayable(o->second.container, o->second.method))
+            ++o;
+        else
+            o = ops.erase(o);
+
+    // number the containers of each type in the order they are first
+    // called; calls that did not log their container share one
+    std::map<uint64_t, unsigned> objects[RC_COUNT];
+    std::map<std::string, unsigned long> skipped;
+    unsigned long long first = ~0ull, last = 0;
+    log.threads.resize(raw.threads.size());
+    for (size_t t = 0; t < raw.threads.size(); ++t) {
+        for (const tracelog_event& e : raw.threads[t]) {
+            first = std::min(first, (unsigned long long)e.ns);
+            last = std::max(last, (unsigned long long)e.ns);
+            if (e.depth != 0)
+                continue;
+            auto op = ops.find(e.site);
+            if (op == ops.end()) {
+                ++skipped[raw.sites[e.site].label];
+                continue;
+            }
+            replay_op r = op->second;
+            r.has_key = e.flags & tracelog_has_arg;
+            r.key = e.arg;
+            // a size cannot be drawn like a key
+            if (r.method == rm_resize && !r.has_key) {
+                ++skipped[raw.sites[e.site].label];
+                continue;
+            }
+            std::map<uint64_t, unsigned>& seen = objects[r.container];
+            r.instance = seen.emplace(e.object, seen.size()).first->second;
+            log.threads[t].push_back(r);
+        }
+    }
+    for (int c = 0; c < RC_COUNT; ++c)
+        log.instances[c] = objects[c].size();
+    log.span_ns = last >= first ? last - first : 0;
+    for (auto& s : skipped)
+        log.skipped.push_back(replay_skipped{s.first, s.second});
+    std::stable_sort(log.skipped.begin(), log.skipped.end(),
+                     [](const replay_skipped& a, const replay_skipped& b) {
+                         return a.calls > b.calls;
+                     });
+    return true;
+}
+
+/// Print every event of a log, thread by thread
+bool dump_log(const char* file)
+{
+    raw_log raw;
+    if (!read_log(file, raw))
+        return false;
+    for (size_t t = 0; t < raw.threads.size(); ++t) {
+        printf("thread %zu: %zu events\n", t, raw.threads[t].size());
+        for (const tracelog_event& e : raw.threads[t]) {
+            const site& s = raw.sites[e.site];
+            printf("%14.3f us %*s%s (%s:%d)", e.ns / 1e3, 2 * e.depth, "",
+                   s.label.c_str(), s.file.substr(s.file.rfind('/') + 1).c_str(),
+                   s.line);
+            if (e.object)
+                printf(" on %#llx", (unsigned long long)e.object);
+            if (e.flags & tracelog_has_arg)
+                printf(" with %lld", (long long)e.arg);
+            printf("\n");
+        }
+    }
+    return true;
+}
@@ -0,0 +1,157 @@
+#include <deque>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "replay.h"
+
+/// The containers that every replay thread shares, one for each container
+/// that the log names
+std::vector<std::list<int>>               shared_list;
+std::vector<std::vector<int>>             shared_vector;
+std::vector<std::deque<int>>              shared_deque;
+std::vector<std::map<int, int>>           shared_map;
+std::vector<std::unordered_set<int>>      shared_unordered_set;
+std::vector<std::unordered_multiset<int>> shared_unordered_multiset;
+std::vector<std::unordered_map<int, int>> shared_unordered_map;
+
+/// Results that are read are added here, so that the reads are not
+/// optimized away
+thread_local unsigned long replay_sink;
+
+namespace
+{
+    /// A call on a list, vector or deque.  Keys are used as values, and,
+    /// modulo the size, as positions.
+    template <class Seq>
+    void seq_op(Seq& c, int method, unsigned key)
+    {
+        unsigned long r = 0;
+        BEGIN_TX;
+        switch (method) {
+          case rm_push_back:  c.push_back(key); break;
+          case rm_push_front: c.insert(c.begin(), key); break;
+          case rm_pop_back:   if (!c.empty()) c.pop_back(); break;
+          case rm_pop_front:  if (!c.empty()) c.erase(c.begin()); break;
+          case rm_insert:     c.insert(c.end(), key); break;
+          case rm_erase:      if (!c.empty()) c.erase(c.begin()); break;
+          case rm_find:
+          case rm_count:
+            for (auto i = c.begin(); i != c.end(); ++i)
+                if (*i == (int)key) {
+                    ++r;
+                    break;
+                }
+            break;
+          case rm_index:
+            if (!c.empty()) {
+                auto i = c.begin();
+                for (unsigned n = key % c.size(); n > 0; --n)
+                    ++i;
+                r = *i;
+            }
+            break;
+          case rm_front:      if (!c.empty()) r = c.front(); break;
+          case rm_back:       if (!c.empty()) r = c.back(); break;
+          case rm_size:       r = c.size(); break;
+          case rm_empty:      r = c.empty(); break;
+          case rm_begin:      r = c.begin() != c.end(); break;
+          case rm_clear:      c.clear(); break;
+          case rm_resize:     c.resize(key); break;
+        }
+        END_TX;
+        replay_sink += r;
+    }
+
+    /// The calls that only lists have
+    void list_op(std::list<int>& c, int method, unsigned key)
+    {
+        BEGIN_TX;
+        switch (method) {
+          case rm_push_front: c.push_front(key); break;
+          case rm_pop_front:  if (!c.empty()) c.pop_front(); break;
+          case rm_sort:       c.sort(); break;
+          case rm_reverse:    c.reverse(); break;
+          case rm_unique:     c.unique(); break;
+        }
+        END_TX;
+    }
+
+    /// A call on a map or an unordered container.  Sequence calls are
+    /// taken to mean their closest equivalent.
+    template <class Assoc, class Value>
+    void assoc_op(Assoc& c, int method, unsigned key, Value v)
+    {
+        unsigned long r = 0;
+        BEGIN_TX;
+        switch (method) {
+          case rm_push_back:
+          case rm_push_front:
+          case rm_insert:     c.insert(v); break;
+          case rm_pop_back:
+          case rm_pop_front:  if (!c.empty()) c.erase(c.begin()); break;
+          case rm_erase:      r = c.erase(key); break;
+          case rm_find:       r = c.find(key) != c.end(); break;
+          case rm_count:
+          case rm_index:      r = c.count(key); break;
+          case rm_front:
+          case rm_back:
+          case rm_begin:      r = c.begin() != c.end(); break;
+          case rm_size:       r = c.size(); break;
+          case rm_empty:      r = c.empty(); break;
+          case rm_clear:      c.clear(); break;
+        }
+        END_TX;
+        replay_sink += r;
+    }
+}
+
+/// Make the containers that a log names, before any thread replays it
+void make_containers(const replay_log& log)
+{
+    shared_list.resize(log.instances[rc_list]);
+    shared_vector.resize(log.instances[rc_vector]);
+    shared_deque.resize(log.instances[rc_deque]);
+    shared_map.resize(log.instances[rc_map]);
+    shared_unordered_set.resize(log.instances[rc_unordered_set]);
+    shared_unordered_multiset.resize(log.instances[rc_unordered_multiset]);
+    shared_unordered_map.resize(log.instances[rc_unordered_map]);
+}
+
+/// Run one call on the shared container that it names, with its logged
+/// argument if it has one, and key if not
+void run_op(const replay_op& op, unsigned key)
+{
+    if (op.has_key)
+        key = op.key;
+    int k = key;
+    unsigned i = op.instance;
+    switch (op.container) {
+      case rc_list:
+        if (op.method == rm_push_front || op.method == rm_pop_front
+            || op.method >= rm_sort)
+            list_op(shared_list[i], op.method, key);
+        else
+            seq_op(shared_list[i], op.method, key);
+        break;
+      case rc_vector:
+        seq_op(shared_vector[i], op.method, key);
+        break;
+      case rc_deque:
+        seq_op(shared_deque[i], op.method, key);
+        break;
+      case rc_map:
+        assoc_op(shared_map[i], op.method, key, std::make_pair(k, k));
+        break;
+      case rc_unordered_set:
+        assoc_op(shared_unordered_set[i], op.method, key, k);
+        break;
+      case rc_unordered_multiset:
+        assoc_op(shared_unordered_multiset[i], op.method, key, k);
+        break;
+      case rc_unordered_map:
+        assoc_op(shared_unordered_map[i], op.method, key, std::make_pair(k, k));
+        break;
+    }
+}
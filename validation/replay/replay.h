@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../common/tm.h"
+
+/**
+ * The replay driver runs a log recorded by a trace build (make
+ * TRACE_RECORD=1, see libstdc++_trace/trace.h) against this build of the
+ * library.  Each recorded thread becomes a replay thread, which performs
+ * the same sequence of container methods, in the same order, on containers
+ * that all threads share, each in a transaction of its own.
+ *
+ * Only the calls that the recorded program made itself are replayed: a
+ * traced call that is nested in another (the iterator methods that insert
+ * calls, say) is part of the outer call's cost.  The container methods log
+ * the address of their container, and each container that the log names
+ * gets a replay container of its own, which every thread that called it
+ * shares.  They also log their key, value, size or position argument, when
+ * it is an integer (or a pair of one), and the replay passes the same one.
+ * Calls without one (pop_back, or a range insert, say) draw their keys and
+ * values from the distribution given with -K (see common/workload.h), in a
+ * sequence that only depends on the thread, which keeps every run of a log
+ * the same.  A resize without its size, and a method that the replay does
+ * not have for its container (a sort that is not a list's), are not
+ * replayed, and are listed as such.
+ */
+
+/// The containers that a log can be replayed against, named after the
+/// library headers that their TRACEs are in
+enum replay_container
+{
+    rc_list, rc_vector, rc_deque, rc_map, rc_unordered_set,
+    rc_unordered_multiset, rc_unordered_map, RC_COUNT
+};
+
+/// What a replayed call does
+enum replay_method
+{
+    rm_push_back, rm_push_front, rm_pop_back, rm_pop_front, rm_insert,
+    rm_erase, rm_find, rm_count, rm_index, rm_front, rm_back, rm_size,
+    rm_empty, rm_begin, rm_clear, rm_resize, rm_sort, rm_reverse, rm_unique,
+    RM_COUNT
+};
+
+extern const char* const container_names[RC_COUNT];
+extern const char* const method_names[RM_COUNT];
+
+/// One replayed call
+struct replay_op
+{
+    unsigned char container;  // a replay_container
+    unsigned char method;     // a replay_method
+    bool          has_key;    // whether the call's argument was logged
+    unsigned      instance;   // which of the containers of its type
+    long long     key;        // the logged argument
+};
+
+/// A method that a log calls but that cannot be replayed
+struct replay_skipped
+{
+    std::string   label;
+    unsigned long calls;
+};
+
+/// A recorded log, ready to replay
+struct replay_log
+{
+    /// the calls of each recorded thread
+    std::vector<std::vector<replay_op>> threads;
+
+    /// the number of containers of each replay_container type
+    unsigned instances[RC_COUNT];
+
+    /// the time from the first event to the last, in nanoseconds
+    unsigned long long span_ns;
+
+    /// the methods that cannot be replayed, most frequent first
+    std::vector<replay_skipped> skipped;
+};
+
+// reading and printing logs, from log.cc
+bool load_log(const char* file, replay_log& log);
+bool dump_log(const char* file);
+
+// running the calls, from ops.cc
+void make_containers(const replay_log& log);
+void run_op(const replay_op& op, unsigned key);
@@ -0,0 +1,41 @@
+#include <map>
+#include <unordered_map>
+#include "run.h"
+
+/// Half of the keys are in the container at first; an update erases a key
+/// that is there and inserts one that is not, so it stays about half full
+template <class C>
+struct assoc_ops
+{
+    static C* make(int keys)
+    {
+        C* c = new C();
+        for (int k = 0; k < keys; k += 2)
+            c->insert(std::make_pair(k, k));
+        return c;
+    }
+
+    static unsigned long op(C& c, int key, bool read)
+    {
+        if (read)
+            return c.count(key);
+        if (c.erase(key) == 0)
+            c.insert(std::make_pair(key, key));
+        return 0;
+    }
+};
+
+/// Node-based, and rebalancing on update can reach far from the key
+void map_tests(int id)
+{
+    typedef std::map<int, int> map_t;
+    run_scale_test<map_t, assoc_ops<map_t>>(id, "map");
+}
+
+/// Disjoint keys fall in disjoint buckets, but every update writes the
+/// element count, and can rehash
+void unordered_map_tests(int id)
+{
+    typedef std::unordered_map<int, int> map_t;
+    run_scale_test<map_t, assoc_ops<map_t>>(id, "unordered_map");
+}
@@ -0,0 +1,176 @@
+/*
+  Benchmark for how container operations scale with threads
+
+  The other drivers have every thread use the same global container, so
+  their concurrent runs are serialized by construction.  This benchmark
+  times the same operations in three modes, to tell the cost of the
+  instrumentation apart from the cost of conflicts:
+
+|----------+--------------------------------------+---------------------------|
+| Mode     | Containers                           | Measures                  |
+|----------+--------------------------------------+---------------------------|
+| private  | one per thread                       | instrumentation alone     |
+|          |                                      | (notm takes no lock)      |
+| disjoint | one, each thread with its own keys   | conflicts on the shared   |
+|          |                                      | parts of the container    |
+| shared   | one, every thread with every key     | conflicts on the data too |
+|----------+--------------------------------------+---------------------------|
+
+|------+---------------+------------------------------------------------------|
+| Test | Container     | Operations                                           |
+|------+---------------+------------------------------------------------------|
+|    1 | map           | count; erase, or insert if erase found nothing       |
+|    2 | unordered_map | count; erase, or insert if erase found nothing       |
+|    3 | vector        | operator[] read; operator[] increment                |
+|    4 | deque         | operator[] read; operator[] increment                |
+|------+---------------+------------------------------------------------------|
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: operations per thread and mode
+int  num_ops = 100000;
+
+/// configured via command line args: keys per thread
+int  num_keys = 1024;
+
+/// configured via command line args: percentage of operations that are
+/// lookups
+int  read_pct = 80;
+
+/// configured via command line args: the distribution of keys, over the
+/// keys of a private container
+key_generator key_gen;
+
+/// configured via command line args: which modes to run
+bool mode_flags[NUM_MODES] = {false};
+
+const char* const mode_names[NUM_MODES] = {"private", "disjoint", "shared"};
+
+/// the time each thread took in the current run
+unsigned long long* thread_ns;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int>  : specify the number of threads" << endl
+         << "  -o <int>  : specify the number of operations per thread" << endl
+         << "  -k <int>  : specify the number of keys per thread" << endl
+         << "  -r <int>  : specify the percentage of lookups" << endl
+         << "  -K <dist> : key distribution: uniform, zipf[:theta]," << endl
+         << "              hotspot[:keys:draws], sequential, latest[:theta]" << endl
+         << "              (default: uniform; see common/workload.h)" << endl
+         << "  -m <mode> : run a mode: private, disjoint or shared" << endl
+         << "              (default: all three)" << endl
+         << "  -h        : display this message" << endl
+         << "  -T        : enable all tests" << endl
+         << "  -t <int>  : enable a specific test" << endl
+         << "               1 map" << endl
+         << "               2 unordered_map" << endl
+         << "               3 vector" << endl
+         << "               4 deque" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 5;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    map_tests,                                          // assoc.cc
+    unordered_map_tests,                                // assoc.cc
+    vector_tests,                                       // seq.cc
+    deque_tests                                         // seq.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    bool any_mode = false;
+    const char* dist = "uniform";
+    while ((opt = getopt(argc, argv, "n:o:k:r:K:m:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 'o': num_ops = atoi(optarg);     break;
+          case 'k': num_keys = atoi(optarg);    break;
+          case 'r': read_pct = atoi(optarg);    break;
+          case 'K': dist = optarg;              break;
+          case 'm':
+            for (int m = 0; m < NUM_MODES; ++m)
+                if (!strcmp(optarg, mode_names[m]))
+                    mode_flags[m] = any_mode = true;
+            break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (!any_mode)
+        for (int m = 0; m < NUM_MODES; ++m)
+            mode_flags[m] = true;
+    if (!key_gen.parse(dist, num_keys))
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+    char dist[64];
+    key_gen.describe(dist, sizeof(dist));
+    printf("%d keys per thread, %d%% lookups, %s keys\n", num_keys, read_pct,
+           dist);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_ns = new unsigned long long[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
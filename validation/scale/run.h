@@ -0,0 +1,104 @@
+// -*-c++-*-
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include "tests.h"
+
+/**
+ * A thread's container is its own in private mode, so the notm and trace
+ * builds need no lock to use it.  The TM build still runs every operation
+ * as a transaction: that is the instrumentation overhead being measured.
+ */
+#ifdef NO_TM
+#  define BEGIN_PRIVATE_TX {
+#  define END_PRIVATE_TX   }
+#else
+#  define BEGIN_PRIVATE_TX BEGIN_TX
+#  define END_PRIVATE_TX   END_TX
+#endif
+
+/**
+ * Run every requested mode for one container type.  Each thread does
+ * num_ops operations, each a transaction, on keys from key_gen's
+ * distribution: a read_pct share of lookups, and updates for the rest.
+ * Ops describes the container:
+ *
+ *   static C*            make(int keys)        a container with these keys
+ *   static unsigned long op(C&, int, bool)     one lookup or update of a key
+ *
+ * In private mode, every thread makes a container with num_keys keys.  In
+ * the other two, one container has num_keys keys per thread; in disjoint
+ * mode, each thread only uses the num_keys of them that are its own, and
+ * in shared mode, every thread uses all of them.  So private and disjoint
+ * runs differ only in what the threads share, and disjoint and shared runs
+ * only in whether their keys overlap.
+ */
+template <class C, class Ops>
+void run_scale_test(int id, const char* name)
+{
+    typedef std::chrono::steady_clock clock;
+    static C* shared = NULL;
+    static std::atomic<unsigned long> sink;
+
+    for (int m = 0; m < NUM_MODES; ++m) {
+        if (!mode_flags[m])
+            continue;
+
+        // make the containers outside of the timed part
+        C* mine = NULL;
+        if (m == mode_private)
+            mine = Ops::make(num_keys);
+        else if (id == 0)
+            shared = Ops::make(num_keys * num_threads);
+        global_barrier->arrive(id);
+        C& c = m == mode_private ? *mine : *shared;
+        int lo = m == mode_disjoint ? id * num_keys : 0;
+        int range = m == mode_shared ? num_keys * num_threads : num_keys;
+
+        // a fixed seed per thread, so that every run draws the same keys
+        key_generator gen = key_gen;
+        gen.grow(range);
+        gen.seed(id + 1);
+        unsigned long r = 0;
+        auto start = clock::now();
+        for (int i = 0; i < num_ops; ++i) {
+            int key = lo + gen.next();
+            bool read = gen.percent() < read_pct;
+            if (m == mode_private) {
+                BEGIN_PRIVATE_TX;
+                r += Ops::op(c, key, read);
+                END_PRIVATE_TX;
+            }
+            else {
+                BEGIN_TX;
+                r += Ops::op(c, key, read);
+                END_TX;
+            }
+        }
+        thread_ns[id] = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (clock::now() - start).count();
+        global_barrier->arrive(id);
+
+        // the run took as long as its slowest thread
+        if (id == 0) {
+            unsigned long long ns =
+                *std::max_element(thread_ns, thread_ns + num_threads);
+            double ops = (double)num_ops * num_threads;
+            printf("  %-14s %-9s %3d threads %10d ops/thread %10.3f ms "
+                   "%8.3f Mops/s\n", name, mode_names[m], num_threads,
+                   num_ops, ns / 1e6, ns ? ops * 1e3 / ns : 0.0);
+        }
+        // keep the lookups from being optimized away
+        sink.fetch_add(r, std::memory_order_relaxed);
+
+        delete mine;
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete shared;
+            shared = NULL;
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#include <deque>
+#include <vector>
+#include "run.h"
+
+/// Keys are positions; an update increments the element at its position
+template <class C>
+struct seq_ops
+{
+    static C* make(int keys)
+    {
+        return new C(keys);
+    }
+
+    static unsigned long op(C& c, int key, bool read)
+    {
+        if (read)
+            return c[key];
+        ++c[key];
+        return 0;
+    }
+};
+
+/// Disjoint positions are disjoint memory, so nothing is shared but the
+/// vector's own pointers, which are only read
+void vector_tests(int id)
+{
+    typedef std::vector<int> vector_t;
+    run_scale_test<vector_t, seq_ops<vector_t>>(id, "vector");
+}
+
+/// As for vector, but indexing reads the deque's map of blocks too
+void deque_tests(int id)
+{
+    typedef std::deque<int> deque_t;
+    run_scale_test<deque_t, seq_ops<deque_t>>(id, "deque");
+}
@@ -0,0 +1,40 @@
+#include <mutex>
+#include "../common/tm.h"
+#include "../common/workload.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// How the threads of a run use their containers
+enum scale_mode
+{
+    mode_private,   // each thread has a container of its own
+    mode_disjoint,  // one container, and each thread has its own keys in it
+    mode_shared,    // one container, and every thread uses every key
+    NUM_MODES
+};
+
+extern const char* const mode_names[NUM_MODES];
+
+/// configured via the command line
+extern int  num_threads;
+extern int  num_ops;
+extern int  num_keys;
+extern int  read_pct;
+extern bool mode_flags[NUM_MODES];
+extern key_generator key_gen;
+
+/// the time each thread took in the current run, in nanoseconds
+extern unsigned long long* thread_ns;
+
+// associative containers, from assoc.cc
+void map_tests(int id);
+void unordered_map_tests(int id);
+
+// sequence containers, from seq.cc
+void vector_tests(int id);
+void deque_tests(int id);
@@ -0,0 +1,136 @@
+/*
+  Abort test for the TM runtimes
+
+  Half of the threads write to a shared array of -w words and then cancel
+  their transactions, while the other half read the whole array in one
+  transaction each and check what they read once it has committed.  A
+  runtime that writes in place (libitm's ml_wt, or the undolog algorithm
+  of the STM in ../../libtm, with make TM_RUNTIME=stm and
+  STM_ALGORITHM=undolog) has to put the old values back on abort, and
+  must not let a reader commit a value that was only ever written by a
+  transaction that aborted, however the reader's loads interleave with
+  the writer's writes and its rollback.  A read is bad if it saw a
+  negative word, which only a cancelled transaction writes, or words
+  that differ, which no committed transaction leaves behind.
+
+  Thread 0 is always a reader, so at least two threads are needed for
+  there to be a writer.  The other builds undo the writes by hand, under
+  the lock, so that every build runs the same test.
+
+|------+---------------+-----------------------------------------------------|
+| Test | Name          | What the writers do                                 |
+|------+---------------+-----------------------------------------------------|
+|    1 | cancel        | write -1 to every word, then cancel                 |
+|    2 | cancel+commit | the same, but one transaction in 8 adds 1 to every  |
+|      |               | word and commits                                    |
+|------+---------------+-----------------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 2;
+
+/// configured via command line args: words in the shared array
+int  num_words = 16;
+
+/// configured via command line args: transactions per thread
+long num_txns = 100000;
+
+/// what each thread did in the current test
+abort_stats* thread_stats;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int> : specify the number of threads" << endl
+         << "  -w <int> : specify the words in the shared array" << endl
+         << "  -o <int> : specify the transactions per thread" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 cancel" << endl
+         << "               2 cancel+commit" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 3;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    cancel_tests,                                       // cancel.cc
+    cancel_commit_tests                                 // cancel.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:w:o:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 'w': num_words = atoi(optarg);   break;
+          case 'o': num_txns = atol(optarg);    break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (num_threads < 1 || num_words < 1 || num_txns < 1)
+        usage();
+}
+
+/// Run the requested tests.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_stats = new abort_stats[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
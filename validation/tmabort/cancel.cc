@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "tests.h"
+
+namespace
+{
+    /// The words that every thread works on, made by thread 0
+    long* shared_words;
+
+    /// What cancelled transactions write, and committed ones never do
+    const long POISON = -1;
+
+    /**
+     * Even threads read every word in a transaction, and check what they
+     * read after it commits.  Odd threads write POISON to every word and
+     * cancel, or, if commit and one transaction in 8, add 1 to every word
+     * and commit.
+     */
+    void run_cancel(int id, const char* name, bool commit)
+    {
+        typedef std::chrono::steady_clock clock;
+
+        if (id == 0)
+            shared_words = new long[num_words]();
+        global_barrier->arrive(id);
+        abort_stats& st = thread_stats[id];
+        st = abort_stats();
+        // without TM, what a cancelled write has to put back
+        std::vector<long> saved(num_words);
+
+        auto start = clock::now();
+        for (long t = 0; t < num_txns; ++t) {
+            if (id % 2 == 0) {
+                long lo, hi;
+                BEGIN_TX;
+                lo = hi = shared_words[0];
+                for (int i = 1; i < num_words; ++i) {
+                    long w = shared_words[i];
+                    lo = w < lo ? w : lo;
+                    hi = w > hi ? w : hi;
+                }
+                END_TX;
+                ++st.reads;
+                st.bad += lo < 0 || lo != hi;
+            }
+            else if (commit && t % 8 == 7) {
+                BEGIN_TX;
+                for (int i = 0; i < num_words; ++i)
+                    shared_words[i] += 1;
+                END_TX;
+                ++st.commits;
+            }
+            else {
+                BEGIN_TX;
+                for (int i = 0; i < num_words; ++i) {
+#ifdef USE_TM
+                    shared_words[i] = POISON;
+                    // cancel after the last write, from inside the loop:
+                    // gcc can lose a __transaction_cancel that follows the
+                    // loop, or that is in a template, and not roll back
+                    if (i == num_words - 1)
+                        __transaction_cancel;
+#else
+                    saved[i] = shared_words[i];
+                    shared_words[i] = POISON;
+#endif
+                }
+#ifndef USE_TM
+                for (int i = 0; i < num_words; ++i)
+                    shared_words[i] = saved[i];
+#endif
+                END_TX;
+                ++st.cancels;
+            }
+        }
+        st.ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (clock::now() - start).count();
+        global_barrier->arrive(id);
+
+        if (id == 0) {
+            abort_stats all = abort_stats();
+            unsigned long long ns = 0;
+            for (int t = 0; t < num_threads; ++t) {
+                all.reads += thread_stats[t].reads;
+                all.bad += thread_stats[t].bad;
+                all.cancels += thread_stats[t].cancels;
+                all.commits += thread_stats[t].commits;
+                ns = std::max(ns, thread_stats[t].ns);
+            }
+            // every committed transaction added 1 to every word
+            bool final_ok = true;
+            for (int i = 0; i < num_words; ++i)
+                final_ok &= shared_words[i] == (long)all.commits;
+            printf("  %-14s %3d threads %10lu reads %10lu cancels"
+                   " %10lu commits %10.3f ms\n", name, num_threads,
+                   all.reads, all.cancels, all.commits, ns / 1e6);
+            if (all.bad)
+                printf(" [%s] %lu reads saw a value that was never"
+                       " committed\n", name, all.bad);
+            if (!final_ok)
+                printf(" [%s] the words do not hold the committed values at"
+                       " the end\n", name);
+            if (!all.bad && final_ok)
+                printf(" [OK] %s\n", name);
+            delete[] shared_words;
+            shared_words = NULL;
+        }
+        global_barrier->arrive(id);
+    }
+}
+
+void cancel_tests(int id)
+{
+    run_cancel(id, "cancel", false);
+}
+
+void cancel_commit_tests(int id)
+{
+    run_cancel(id, "cancel+commit", true);
+}
@@ -0,0 +1,31 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// What one thread did in one test
+struct abort_stats
+{
+    unsigned long long ns;
+    unsigned long      reads;     // read transactions, on the readers
+    unsigned long      bad;       // reads that saw a value never committed
+    unsigned long      cancels;   // on the writers
+    unsigned long      commits;   // on the writers
+};
+
+/// configured via the command line
+extern int  num_threads;
+extern int  num_words;
+extern long num_txns;
+
+/// one per thread
+extern abort_stats* thread_stats;
+
+// readers against writers that cancel, from cancel.cc
+void cancel_tests(int id);
+void cancel_commit_tests(int id);
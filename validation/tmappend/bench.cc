@@ -0,0 +1,153 @@
+/*
+  Append benchmark for the TM containers
+
+  Every thread appends to one shared container, an element per
+  transaction.  When a std::vector is full, the push_back that does not
+  fit reallocates it in its transaction, which copies every element and
+  conflicts with every other append, so that under contention the
+  reallocating transaction is the one that aborts, and aborts again.  In
+  the TM build, the grow ahead tests instead check whether the element
+  fits first, and if it does not, grow the vector in a transaction that
+  does nothing else, with __gnu_cxx::grow_for_append (see libstdc++_tm's
+  ext/grow_ahead.h), so that no append ever reallocates.  The paged tests
+  give the vector 1.5x growth in whole pages instead of doubling, with a
+  std::__vector_growth_policy (see libstdc++_tm's bits/stl_vector.h).  The
+  other builds use push_back for every test.  For comparison, a std::deque
+  never moves its elements, but reallocates its map of nodes as it grows,
+  and the TM library's __gnu_cxx::segmented_vector (see
+  ext/segmented_vector.h) never reallocates anything: its appends write
+  the new element and the size, and a segment pointer once per segment.
+
+  The report gives the rate of appends over all threads, the retries per
+  append transaction, and the transactions per round that only grew the
+  vector.
+
+|------+-------------------------+-------------------------------------------|
+| Test | Name                    | Append                                    |
+|------+-------------------------+-------------------------------------------|
+|    1 | vector push_back        | std::vector<long>::push_back()            |
+|    2 | vector grow ahead       | grow_for_append(), then push_back()       |
+|    3 | paged vector push_back  | the same as 1, with 1.5x paged growth     |
+|    4 | paged vector grow ahead | the same as 2, with 1.5x paged growth     |
+|    5 | deque push_back         | std::deque<long>::push_back()             |
+|    6 | segmented push_back     | segmented_vector<long>::push_back(), TM   |
+|      |                         | build only                                |
+|------+-------------------------+-------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "run.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: appends per thread and round
+long num_appends = 100000;
+
+/// configured via command line args: rounds, each from an empty container
+int  num_rounds = 10;
+
+/// what each thread measured of the current test
+append_stats* thread_stats;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int> : specify the number of threads" << endl
+         << "  -o <int> : specify the appends per thread and round" << endl
+         << "  -r <int> : specify the number of rounds" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 vector push_back" << endl
+         << "               2 vector grow ahead" << endl
+         << "               3 paged vector push_back" << endl
+         << "               4 paged vector grow ahead" << endl
+         << "               5 deque push_back" << endl
+         << "               6 segmented push_back" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 7;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    vector_push_back_tests,                             // vector.cc
+    vector_grow_ahead_tests,                            // vector.cc
+    vector_paged_push_back_tests,                       // vector.cc
+    vector_paged_grow_ahead_tests,                      // vector.cc
+    deque_push_back_tests,                              // deque.cc
+    segmented_vector_push_back_tests                    // segmented.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:o:r:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 'o': num_appends = atol(optarg); break;
+          case 'r': num_rounds = atoi(optarg);  break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (num_threads < 1 || num_appends < 1 || num_rounds < 1)
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_stats = new append_stats[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
@@ -0,0 +1,26 @@
+#include <deque>
+#include "run.h"
+
+namespace
+{
+    /// push_back(), which adds a node, and sometimes reallocates the map of
+    /// nodes, but never moves an element
+    struct deque_append
+    {
+        typedef std::deque<long> container;
+
+        static void append(container& c, long x, append_stats&)
+        {
+            BEGIN_TX;
+            c.push_back(x);
+            END_TX;
+        }
+
+        static long value(long v) { return v; }
+    };
+}
+
+void deque_push_back_tests(int id)
+{
+    run_append<deque_append>(id, "deque push_back");
+}
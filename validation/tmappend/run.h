@@ -0,0 +1,89 @@
+// -*-c++-*-
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include "tests.h"
+
+/// What one thread measured of one kind of append, over all rounds
+struct append_stats
+{
+    unsigned long long ns;          // of all rounds, on thread 0
+    unsigned long      retries;     // of the append transactions
+    unsigned long      grows;       // transactions that only made room
+    unsigned long      bad;         // rounds that left the wrong contents
+};
+
+/// One per thread, made by main()
+extern append_stats* thread_stats;
+
+/**
+ * Time num_threads threads appending num_appends elements each to one
+ * shared container, every append in a transaction of its own, in each of
+ * num_rounds rounds that start from an empty container.  Thread t appends
+ * the numbers from t * num_appends on, so that a round must leave every
+ * number below num_threads * num_appends in the container, once.
+ *
+ * A supplies the container and the append:
+ *
+ *   typedef ... container;
+ *   static void append(container&, long x, append_stats&);
+ *   static long value(const container::value_type&);
+ *
+ * append() runs the transactions that it takes, and counts the ones that
+ * only grow the container in grows.
+ */
+template <class A>
+void run_append(int id, const char* name)
+{
+    typedef std::chrono::steady_clock clock;
+    typedef typename A::container C;
+    static C* shared;
+
+    append_stats& st = thread_stats[id];
+    st = append_stats();
+    for (int r = 0; r < num_rounds; ++r) {
+        if (id == 0)
+            shared = new C();
+        global_barrier->arrive(id);
+
+        auto start = clock::now();
+        unsigned long retries = tm_thread_retries();
+        for (long i = 0; i < num_appends; ++i)
+            A::append(*shared, id * num_appends + i, st);
+        st.retries += tm_thread_retries() - retries;
+        global_barrier->arrive(id);
+
+        if (id == 0) {
+            st.ns += std::chrono::duration_cast<std::chrono::nanoseconds>
+                (clock::now() - start).count();
+            long total = num_threads * num_appends;
+            long long sum = 0;
+            for (auto& v : *shared)
+                sum += A::value(v);
+            st.bad += (long)shared->size() != total
+                || sum != (long long)total * (total - 1) / 2;
+            delete shared;
+        }
+    }
+    global_barrier->arrive(id);
+
+    if (id == 0) {
+        append_stats all = append_stats();
+        for (int t = 0; t < num_threads; ++t) {
+            all.retries += thread_stats[t].retries;
+            all.grows += thread_stats[t].grows;
+            all.bad += thread_stats[t].bad;
+        }
+        double appends = (double)num_appends * num_threads * num_rounds;
+        if (all.bad)
+            printf(" [%s] %lu rounds left the wrong contents\n", name,
+                   all.bad);
+        printf("  %-23s %3d threads %12.0f appends/s %8.3f retries/append"
+               " %8.1f grows/round\n", name, num_threads,
+               appends / (st.ns / 1e9), all.retries / appends,
+               all.grows / (double)num_rounds);
+    }
+    // thread 0 may still be reading the others' stats
+    global_barrier->arrive(id);
+}
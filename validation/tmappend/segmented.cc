@@ -0,0 +1,37 @@
+#include <cstdio>
+#ifdef USE_TM
+#  include <ext/segmented_vector.h>
+#endif
+#include "run.h"
+
+#ifdef USE_TM
+namespace
+{
+    /// push_back(), which writes the new element and the size, and a
+    /// segment pointer once per segment
+    struct segmented_append
+    {
+        typedef __gnu_cxx::segmented_vector<long> container;
+
+        static void append(container& c, long x, append_stats&)
+        {
+            BEGIN_TX;
+            c.push_back(x);
+            END_TX;
+        }
+
+        static long value(long v) { return v; }
+    };
+}
+#endif
+
+void segmented_vector_push_back_tests(int id)
+{
+#ifdef USE_TM
+    run_append<segmented_append>(id, "segmented push_back");
+#else
+    // segmented_vector is only in the TM library
+    if (id == 0)
+        printf("  %-23s TM build only\n", "segmented push_back");
+#endif
+}
@@ -0,0 +1,26 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// configured via the command line
+extern int  num_threads;
+extern long num_appends;
+extern int  num_rounds;
+
+// appending to a shared vector, from vector.cc
+void vector_push_back_tests(int id);
+void vector_grow_ahead_tests(int id);
+void vector_paged_push_back_tests(int id);
+void vector_paged_grow_ahead_tests(int id);
+
+// appending to a shared deque, from deque.cc
+void deque_push_back_tests(int id);
+
+// appending to a shared segmented_vector, from segmented.cc
+void segmented_vector_push_back_tests(int id);
@@ -0,0 +1,99 @@
+#include <vector>
+#ifdef USE_TM
+#  include <ext/grow_ahead.h>
+#endif
+#include "run.h"
+
+namespace
+{
+    /// An element of its own type, for a vector with another growth policy
+    struct paged_long
+    {
+        long v;
+    };
+
+    long value_of(long v) { return v; }
+
+    long value_of(const paged_long& v) { return v.v; }
+}
+
+#ifdef USE_TM
+namespace std
+{
+    /// 1.5x growth, in whole pages
+    template <>
+    struct __vector_growth_policy<paged_long, std::allocator<paged_long>>
+        : std::__vector_growth<3, 2, 0, 4096>
+    { };
+}
+#endif
+
+namespace
+{
+    /// push_back(), which reallocates in the appending transaction
+    template <class T>
+    struct push_back_append
+    {
+        typedef std::vector<T> container;
+
+        static void append(container& c, long x, append_stats&)
+        {
+            BEGIN_TX;
+            c.push_back(T{x});
+            END_TX;
+        }
+
+        static long value(const T& v) { return value_of(v); }
+    };
+
+    /// push_back() once there is room, which a transaction of its own
+    /// makes first when there is not
+    template <class T>
+    struct grow_ahead_append : push_back_append<T>
+    {
+        typedef std::vector<T> container;
+
+        static void append(container& c, long x, append_stats& st)
+        {
+#ifdef USE_TM
+            for (bool appended = false; !appended; ) {
+                BEGIN_TX;
+                appended = __gnu_cxx::append_fits(c);
+                if (appended)
+                    c.push_back(T{x});
+                END_TX;
+                if (!appended) {
+                    bool grew;
+                    BEGIN_TX;
+                    grew = __gnu_cxx::grow_for_append(c);
+                    END_TX;
+                    st.grows += grew;
+                }
+            }
+#else
+            // the other libraries have no grow_for_append
+            push_back_append<T>::append(c, x, st);
+#endif
+        }
+    };
+}
+
+void vector_push_back_tests(int id)
+{
+    run_append<push_back_append<long>>(id, "vector push_back");
+}
+
+void vector_grow_ahead_tests(int id)
+{
+    run_append<grow_ahead_append<long>>(id, "vector grow ahead");
+}
+
+void vector_paged_push_back_tests(int id)
+{
+    run_append<push_back_append<paged_long>>(id, "paged vector push_back");
+}
+
+void vector_paged_grow_ahead_tests(int id)
+{
+    run_append<grow_ahead_append<paged_long>>(id, "paged vector grow ahead");
+}
@@ -0,0 +1,207 @@
+/*
+  Bulk operation benchmark for the TM containers
+
+  Clearing or destroying a container in a transaction touches every node:
+  each one joins the read set, and each free is logged.  In the TM build,
+  containers of trivially destructible values, like the ones here, instead
+  unlink what they drop in a few writes, and free it at commit (see
+  libstdc++_tm's bits/tm_defer.h); build with
+  make TM_NO_DEFER=1 for the baseline that frees in place.  The list sort
+  test measures the TM build's list::sort, which relinks the nodes in a
+  natural merge sort instead of splicing them through temporary lists.
+  The prefill tests build a set of sorted keys from nothing, with the range
+  constructor, which the TM build turns into one pass that builds a
+  balanced tree, and with an insert of every key at end(), as the baseline.
+  The upsert tests set the value of every key in a map that has about seven
+  in eight of them: with insert_or_assign, which only makes a node for a
+  missing key, and with emplace and then assignment, which makes and frees
+  one for every key, as the baseline.
+  The migrate tests move every element to a new container, one at a time,
+  with extract and insert of the node, which the TM build relinks without
+  allocating, and with an insert of a copy and an erase, as the baseline.
+
+  Every test times one bulk operation, as one transaction, on containers
+  of every size from -s to -S, 10x apart.  Each thread fills and empties
+  containers of its own, so the only conflicts are between a thread's bulk
+  transaction and the others' fills, which is enough to make a long
+  transaction abort under NOrec (make TM_RUNTIME=stm).  The report gives
+  the average and the worst time of a bulk transaction, including its
+  retries and its commit, and the retries per transaction.
+
+|------+-------------------+-----------------------------------------------|
+| Test | Name              | Bulk transaction                              |
+|------+-------------------+-----------------------------------------------|
+|    1 | list clear        | std::list<long>::clear()                      |
+|    2 | list destroy      | delete of a std::list<long>                   |
+|    3 | list = {}         | assignment of an empty initializer list       |
+|    4 | map clear         | std::map<long, long>::clear()                 |
+|    5 | map destroy       | delete of a std::map<long, long>              |
+|    6 | map replace       | move assignment of a one-element map          |
+|    7 | unordered clear   | std::unordered_map<long, long>::clear()       |
+|    8 | unordered destroy | delete of a std::unordered_map<long, long>    |
+|    9 | list sort         | std::list<long>::sort(), in random order      |
+|   10 | set prefill       | std::set<long> of a sorted range              |
+|   11 | set hinted insert | emplace_hint(end()) of each sorted key        |
+|   12 | map emp+set       | std::map<long, long> emplace, then assignment |
+|   13 | map upsert        | std::map<long, long>::insert_or_assign()      |
+|   14 | unordered emp+set | emplace, then assignment, on an unordered_map |
+|   15 | unordered upsert  | unordered_map<long, long>::insert_or_assign() |
+|   16 | map copy          | insert a copy, erase, per element of a map    |
+|   17 | map migrate       | insert(extract(begin())), per element         |
+|   18 | unordered copy    | the same as 16, on an unordered_map           |
+|   19 | unordered migrate | the same as 17, on an unordered_map           |
+|------+-------------------+-----------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "run.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 1;
+
+/// configured via command line args: the smallest container size
+long min_size = 1000;
+
+/// configured via command line args: the largest container size
+long max_size = 100000;
+
+/// configured via command line args: rounds per thread at each size
+int  num_rounds = 10;
+
+/// configured via command line args: elements per fill transaction
+int  fill_batch = 64;
+
+/// what each thread measured at the current size
+bulk_stats* thread_stats;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int> : specify the number of threads" << endl
+         << "  -s <int> : specify the smallest container size" << endl
+         << "  -S <int> : specify the largest container size" << endl
+         << "  -r <int> : specify the rounds per thread at each size" << endl
+         << "  -b <int> : specify the elements per fill transaction" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 list clear" << endl
+         << "               2 list destroy" << endl
+         << "               3 list = {}" << endl
+         << "               4 map clear" << endl
+         << "               5 map destroy" << endl
+         << "               6 map replace" << endl
+         << "               7 unordered clear" << endl
+         << "               8 unordered destroy" << endl
+         << "               9 list sort" << endl
+         << "              10 set prefill" << endl
+         << "              11 set hinted insert" << endl
+         << "              12 map emp+set" << endl
+         << "              13 map upsert" << endl
+         << "              14 unordered emp+set" << endl
+         << "              15 unordered upsert" << endl
+         << "              16 map copy" << endl
+         << "              17 map migrate" << endl
+         << "              18 unordered copy" << endl
+         << "              19 unordered migrate" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 20;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    list_clear_tests,                                   // list.cc
+    list_destroy_tests,                                 // list.cc
+    list_assign_tests,                                  // list.cc
+    map_clear_tests,                                    // map.cc
+    map_destroy_tests,                                  // map.cc
+    map_replace_tests,                                  // map.cc
+    unordered_map_clear_tests,                          // unordered_map.cc
+    unordered_map_destroy_tests,                        // unordered_map.cc
+    list_sort_tests,                                    // list.cc
+    set_prefill_tests,                                  // set.cc
+    set_hinted_tests,                                   // set.cc
+    map_emplace_upsert_tests,                           // map.cc
+    map_upsert_tests,                                   // map.cc
+    unordered_map_emplace_upsert_tests,                 // unordered_map.cc
+    unordered_map_upsert_tests,                         // unordered_map.cc
+    map_copy_migrate_tests,                             // map.cc
+    map_migrate_tests,                                  // map.cc
+    unordered_map_copy_migrate_tests,                   // unordered_map.cc
+    unordered_map_migrate_tests                         // unordered_map.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:S:r:b:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 's': min_size = atol(optarg);    break;
+          case 'S': max_size = atol(optarg);    break;
+          case 'r': num_rounds = atoi(optarg);  break;
+          case 'b': fill_batch = atoi(optarg);  break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (min_size < 1 || num_rounds < 1 || fill_batch < 1)
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_stats = new bulk_stats[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <list>
+#include "run.h"
+
+namespace
+{
+    /// The operations that every list test shares
+    struct list_bulk
+    {
+        typedef std::list<long> container;
+        static const bool FILL = true;
+
+        static void prepare(std::vector<long>&) { }
+
+        static void add(container& c, long key) { c.push_back(key); }
+    };
+
+    /// clear(): in the TM build, three writes, and the nodes are freed at
+    /// commit
+    struct list_clear : list_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            c->clear();
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c->empty();
+        }
+    };
+
+    /// delete, which runs ~list() in the transaction
+    struct list_destroy : list_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            delete c;
+            c = NULL;
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c == NULL;
+        }
+    };
+
+    /// assignment of {}, which erases every element as one range
+    struct list_assign : list_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            *c = {};
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c->empty();
+        }
+    };
+
+    /// sort(), on a list in random order
+    struct list_sort : list_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            c->sort();
+        }
+
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            std::vector<long> sorted(keys);
+            std::sort(sorted.begin(), sorted.end());
+            return c->size() == sorted.size()
+                && std::equal(c->begin(), c->end(), sorted.begin());
+        }
+    };
+}
+
+void list_clear_tests(int id)
+{
+    run_bulk<list_clear>(id, "list clear");
+}
+
+void list_destroy_tests(int id)
+{
+    run_bulk<list_destroy>(id, "list destroy");
+}
+
+void list_assign_tests(int id)
+{
+    run_bulk<list_assign>(id, "list = {}");
+}
+
+void list_sort_tests(int id)
+{
+    run_bulk<list_sort>(id, "list sort");
+}
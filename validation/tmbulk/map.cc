@@ -0,0 +1,197 @@
+#include <map>
+#include "run.h"
+
+namespace
+{
+    /// The operations that every map test shares
+    struct map_bulk
+    {
+        typedef std::map<long, long> container;
+        static const bool FILL = true;
+
+        static void prepare(std::vector<long>&) { }
+
+        static void add(container& c, long key) { c.insert({key, key}); }
+    };
+
+    /// clear(): in the TM build, four writes to the header, and the nodes
+    /// are freed at commit
+    struct map_clear : map_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            c->clear();
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c->empty();
+        }
+    };
+
+    /// delete, which runs ~map() in the transaction
+    struct map_destroy : map_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            delete c;
+            c = NULL;
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c == NULL;
+        }
+    };
+
+    /// replace the whole map with a new one-element map, by move
+    /// assignment, which clears it first
+    struct map_replace : map_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            *c = container{{keys[0], 0}};
+        }
+
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            return c->size() == 1 && c->begin()->first == keys[0];
+        }
+    };
+
+    /// The upsert tests fill the container with all but about one key in
+    /// eight, and then set the value of every key, so that most updates
+    /// find their key already there
+    struct map_upsert_bulk : map_bulk
+    {
+        static void add(container& c, long key)
+        {
+            if (key % 8)
+                c.insert({key, key});
+        }
+
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            for (long k : keys) {
+                auto i = c->find(k);
+                if (i == c->end() || i->second != k + 1)
+                    return false;
+            }
+            return c->size() == keys.size();
+        }
+    };
+
+    /// emplace, and assign if the key was there: the usual way to upsert
+    /// before C++17, which makes (and frees) a node for every update
+    struct map_emplace_upsert : map_upsert_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            for (long k : keys) {
+                auto r = c->emplace(k, k + 1);
+                if (!r.second)
+                    r.first->second = k + 1;
+            }
+        }
+    };
+
+    /// insert_or_assign, which looks the key up once and only makes a node
+    /// on a miss.  Only the TM library has it, so the other builds use
+    /// operator[], which does the same for a long
+    struct map_upsert : map_upsert_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            for (long k : keys)
+#ifdef USE_TM
+                c->insert_or_assign(k, k + 1);
+#else
+                (*c)[k] = k + 1;
+#endif
+        }
+    };
+
+    /// The migrate tests move every element of the container to a new one,
+    /// one at a time, as an archiving pass would, and then delete the old
+    /// one
+    struct map_migrate_bulk : map_bulk
+    {
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            for (long k : keys) {
+                auto i = c->find(k);
+                if (i == c->end() || i->second != k)
+                    return false;
+            }
+            return c->size() == keys.size();
+        }
+    };
+
+    /// insert a copy of each element into the new container, and erase it
+    /// from the old one: a malloc and a free per element
+    struct map_copy_migrate : map_migrate_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            container* dst = new container();
+            for (auto i = c->begin(); i != c->end(); i = c->erase(i))
+                dst->insert(*i);
+            delete c;
+            c = dst;
+        }
+    };
+
+    /// extract each element, and insert its node into the new container,
+    /// which relinks it.  Only the TM library has node handles, so the
+    /// other builds copy, as above
+    struct map_migrate : map_migrate_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+#ifdef USE_TM
+            container* dst = new container();
+            while (!c->empty())
+                dst->insert(c->extract(c->begin()));
+            delete c;
+            c = dst;
+#else
+            map_copy_migrate::run(c, keys);
+#endif
+        }
+    };
+}
+
+void map_clear_tests(int id)
+{
+    run_bulk<map_clear>(id, "map clear");
+}
+
+void map_destroy_tests(int id)
+{
+    run_bulk<map_destroy>(id, "map destroy");
+}
+
+void map_replace_tests(int id)
+{
+    run_bulk<map_replace>(id, "map replace");
+}
+
+void map_emplace_upsert_tests(int id)
+{
+    run_bulk<map_emplace_upsert>(id, "map emp+set");
+}
+
+void map_upsert_tests(int id)
+{
+    run_bulk<map_upsert>(id, "map upsert");
+}
+
+void map_copy_migrate_tests(int id)
+{
+    run_bulk<map_copy_migrate>(id, "map copy");
+}
+
+void map_migrate_tests(int id)
+{
+    run_bulk<map_migrate>(id, "map migrate");
+}
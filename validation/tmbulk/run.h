@@ -0,0 +1,106 @@
+// -*-c++-*-
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "tests.h"
+#include "../common/workload.h"
+
+/// What one thread measured of one bulk operation, over the rounds at one
+/// size
+struct bulk_stats
+{
+    unsigned long long ns;          // of all rounds
+    unsigned long long max_ns;      // of the slowest round
+    unsigned long      retries;     // of the bulk transactions
+    unsigned long      bad;         // rounds that left the wrong contents
+};
+
+/// One per thread, made by main()
+extern bulk_stats* thread_stats;
+
+/**
+ * Time one bulk operation, as one transaction, at every size from min_size
+ * to max_size, 10x apart.  Every thread works on containers of its own: in
+ * each of num_rounds rounds, it makes a container, fills it with random
+ * keys in transactions of fill_batch elements, and then times the bulk
+ * operation.  The threads do not share data, but their fills commit while
+ * the others' bulk transactions run, which is what makes a long
+ * transaction abort under a runtime like NOrec.  The time of a bulk
+ * transaction includes its retries, and whatever runs at its commit.
+ *
+ * B supplies the container and the operation:
+ *
+ *   typedef ... container;
+ *   static const bool FILL;    // whether to fill the container first
+ *   static void prepare(std::vector<long>& keys);   // before the round
+ *   static void add(container&, long key);          // in a fill batch
+ *   static void run(container*&, const std::vector<long>& keys);
+ *   static bool check(const container*, const std::vector<long>& keys);
+ *
+ * run() may delete the container and set it to NULL, or make one.
+ */
+template <class B>
+void run_bulk(int id, const char* name)
+{
+    typedef std::chrono::steady_clock clock;
+    typedef typename B::container C;
+    fastrand rng(id + 1);
+    std::vector<long> keys;
+
+    for (long size = min_size; size <= max_size; size *= 10) {
+        // thread 0 may still be reporting the last size
+        global_barrier->arrive(id);
+        bulk_stats& st = thread_stats[id];
+        st = bulk_stats();
+
+        for (int r = 0; r < num_rounds; ++r) {
+            keys.resize(size);
+            for (long i = 0; i < size; ++i)
+                keys[i] = rng.next() >> 1;
+            B::prepare(keys);
+            C* c = new C();
+            for (long i = 0; B::FILL && i < size; i += fill_batch) {
+                long end = std::min(size, i + fill_batch);
+                BEGIN_TX;
+                for (long j = i; j < end; ++j)
+                    B::add(*c, keys[j]);
+                END_TX;
+            }
+
+            unsigned long retries = tm_thread_retries();
+            auto start = clock::now();
+            BEGIN_TX;
+            B::run(c, keys);
+            END_TX;
+            unsigned long long ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>
+                (clock::now() - start).count();
+            st.retries += tm_thread_retries() - retries;
+            st.ns += ns;
+            st.max_ns = std::max(st.max_ns, ns);
+            st.bad += !B::check(c, keys);
+            delete c;
+        }
+        global_barrier->arrive(id);
+
+        if (id == 0) {
+            bulk_stats all = bulk_stats();
+            for (int t = 0; t < num_threads; ++t) {
+                all.ns += thread_stats[t].ns;
+                all.max_ns = std::max(all.max_ns, thread_stats[t].max_ns);
+                all.retries += thread_stats[t].retries;
+                all.bad += thread_stats[t].bad;
+            }
+            double txns = (double)num_rounds * num_threads;
+            if (all.bad)
+                printf(" [%s] %lu rounds left the wrong contents\n", name,
+                       all.bad);
+            printf("  %-17s %9ld elements %3d threads %10.3f ms avg %10.3f ms"
+                   " max %8.2f retries/tx\n", name, size, num_threads,
+                   all.ns / txns / 1e6, all.max_ns / 1e6, all.retries / txns);
+        }
+    }
+}
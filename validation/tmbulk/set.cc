@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <set>
+#include "run.h"
+
+namespace
+{
+    /// The operations that every set test shares: each builds a set of
+    /// every key, in order, from nothing
+    struct set_bulk
+    {
+        typedef std::set<long> container;
+        static const bool FILL = false;
+
+        /// sort the keys, and make them distinct
+        static void prepare(std::vector<long>& keys)
+        {
+            std::sort(keys.begin(), keys.end());
+            for (size_t i = 1; i < keys.size(); ++i)
+                keys[i] = std::max(keys[i], keys[i - 1] + 1);
+        }
+
+        static void add(container&, long) { }
+
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            return c->size() == keys.size()
+                && std::equal(keys.begin(), keys.end(), c->begin());
+        }
+    };
+
+    /// the range constructor, which, in the TM build, makes a sorted range
+    /// into a balanced tree in one pass
+    struct set_prefill : set_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            delete c;
+            c = new container(keys.begin(), keys.end());
+        }
+    };
+
+    /// the same set, built by inserting each key at end(), one rebalance
+    /// at a time, which is what the range constructor does otherwise
+    struct set_hinted : set_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            for (long k : keys)
+                c->emplace_hint(c->end(), k);
+        }
+    };
+}
+
+void set_prefill_tests(int id)
+{
+    run_bulk<set_prefill>(id, "set prefill");
+}
+
+void set_hinted_tests(int id)
+{
+    run_bulk<set_hinted>(id, "set hinted insert");
+}
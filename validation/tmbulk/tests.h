@@ -0,0 +1,44 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// configured via the command line
+extern int  num_threads;
+extern long min_size;
+extern long max_size;
+extern int  num_rounds;
+extern int  fill_batch;
+
+// clearing, destroying and sorting lists, from list.cc
+void list_clear_tests(int id);
+void list_destroy_tests(int id);
+void list_assign_tests(int id);
+void list_sort_tests(int id);
+
+// clearing, destroying, replacing, updating and migrating maps, from map.cc
+void map_clear_tests(int id);
+void map_destroy_tests(int id);
+void map_replace_tests(int id);
+void map_emplace_upsert_tests(int id);
+void map_upsert_tests(int id);
+void map_copy_migrate_tests(int id);
+void map_migrate_tests(int id);
+
+// building sets from sorted keys, from set.cc
+void set_prefill_tests(int id);
+void set_hinted_tests(int id);
+
+// clearing, destroying, updating and migrating unordered_maps, from
+// unordered_map.cc
+void unordered_map_clear_tests(int id);
+void unordered_map_destroy_tests(int id);
+void unordered_map_emplace_upsert_tests(int id);
+void unordered_map_upsert_tests(int id);
+void unordered_map_copy_migrate_tests(int id);
+void unordered_map_migrate_tests(int id);
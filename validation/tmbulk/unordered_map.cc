@@ -0,0 +1,177 @@
+#include <unordered_map>
+#include "run.h"
+
+namespace
+{
+    /// The operations that every unordered_map test shares
+    struct unordered_map_bulk
+    {
+        typedef std::unordered_map<long, long> container;
+        static const bool FILL = true;
+
+        static void prepare(std::vector<long>&) { }
+
+        static void add(container& c, long key) { c.insert({key, key}); }
+    };
+
+    /// clear(): in the TM build, the bucket array is swapped for the
+    /// single bucket, and the nodes are freed at commit
+    struct unordered_map_clear : unordered_map_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            c->clear();
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c->empty() && c->begin() == c->end();
+        }
+    };
+
+    /// delete, which runs ~unordered_map() in the transaction
+    struct unordered_map_destroy : unordered_map_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            delete c;
+            c = NULL;
+        }
+
+        static bool check(const container* c, const std::vector<long>&)
+        {
+            return c == NULL;
+        }
+    };
+
+    /// The upsert tests fill the container with all but about one key in
+    /// eight, and then set the value of every key, so that most updates
+    /// find their key already there
+    struct unordered_map_upsert_bulk : unordered_map_bulk
+    {
+        static void add(container& c, long key)
+        {
+            if (key % 8)
+                c.insert({key, key});
+        }
+
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            for (long k : keys) {
+                auto i = c->find(k);
+                if (i == c->end() || i->second != k + 1)
+                    return false;
+            }
+            return c->size() == keys.size();
+        }
+    };
+
+    /// emplace, and assign if the key was there: the usual way to upsert
+    /// before C++17, which makes (and frees) a node for every update
+    struct unordered_map_emplace_upsert : unordered_map_upsert_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            for (long k : keys) {
+                auto r = c->emplace(k, k + 1);
+                if (!r.second)
+                    r.first->second = k + 1;
+            }
+        }
+    };
+
+    /// insert_or_assign, which looks the key up once and only makes a node
+    /// on a miss.  Only the TM library has it, so the other builds use
+    /// operator[], which does the same for a long
+    struct unordered_map_upsert : unordered_map_upsert_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+            for (long k : keys)
+#ifdef USE_TM
+                c->insert_or_assign(k, k + 1);
+#else
+                (*c)[k] = k + 1;
+#endif
+        }
+    };
+
+    /// The migrate tests move every element of the container to a new one,
+    /// one at a time, as an archiving pass would, and then delete the old
+    /// one
+    struct unordered_map_migrate_bulk : unordered_map_bulk
+    {
+        static bool check(const container* c, const std::vector<long>& keys)
+        {
+            for (long k : keys) {
+                auto i = c->find(k);
+                if (i == c->end() || i->second != k)
+                    return false;
+            }
+            return c->size() == keys.size();
+        }
+    };
+
+    /// insert a copy of each element into the new container, and erase it
+    /// from the old one: a malloc and a free per element
+    struct unordered_map_copy_migrate : unordered_map_migrate_bulk
+    {
+        static void run(container*& c, const std::vector<long>&)
+        {
+            container* dst = new container();
+            for (auto i = c->begin(); i != c->end(); i = c->erase(i))
+                dst->insert(*i);
+            delete c;
+            c = dst;
+        }
+    };
+
+    /// extract each element, and insert its node into the new container,
+    /// which relinks it.  Only the TM library has node handles, so the
+    /// other builds copy, as above
+    struct unordered_map_migrate : unordered_map_migrate_bulk
+    {
+        static void run(container*& c, const std::vector<long>& keys)
+        {
+#ifdef USE_TM
+            container* dst = new container();
+            while (!c->empty())
+                dst->insert(c->extract(c->begin()));
+            delete c;
+            c = dst;
+#else
+            unordered_map_copy_migrate::run(c, keys);
+#endif
+        }
+    };
+}
+
+void unordered_map_clear_tests(int id)
+{
+    run_bulk<unordered_map_clear>(id, "unordered clear");
+}
+
+void unordered_map_destroy_tests(int id)
+{
+    run_bulk<unordered_map_destroy>(id, "unordered destroy");
+}
+
+void unordered_map_emplace_upsert_tests(int id)
+{
+    run_bulk<unordered_map_emplace_upsert>(id, "unordered emp+set");
+}
+
+void unordered_map_upsert_tests(int id)
+{
+    run_bulk<unordered_map_upsert>(id, "unordered upsert");
+}
+
+void unordered_map_copy_migrate_tests(int id)
+{
+    run_bulk<unordered_map_copy_migrate>(id, "unordered copy");
+}
+
+void unordered_map_migrate_tests(int id)
+{
+    run_bulk<unordered_map_migrate>(id, "unordered migrate");
+}
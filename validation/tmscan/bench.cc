@@ -0,0 +1,148 @@
+/*
+  Scan benchmark for the TM containers
+
+  One thread scans a std::map<long, long> of -r records from end to end,
+  while every other thread updates it in short transactions.  A scan in
+  one transaction reads every node, so that any update that commits while
+  it runs aborts it, and under contention it hardly ever finishes.  In the
+  TM build, the scan instead goes through a __gnu_cxx::scan_cursor (see
+  libstdc++_tm's ext/scan_cursor.h), a batch of elements per transaction,
+  and each batch resumes at upper_bound() of the last key that the one
+  before it saw.  The smaller the batch, the less a batch conflicts with,
+  and the more lookups and commits a scan takes.
+
+  Every test runs num_scans scans at every batch size from -b to -B, 10x
+  apart; a batch of -r or more records is the whole map in one
+  transaction.  The report gives the time of a scan, the retries per batch
+  transaction, the share of batch transactions that aborted, and the rate
+  of the other threads' updates while the scans ran.  The other builds
+  scan with a plain loop, in the same batches.
+
+|------+--------------+------------------------------------------------------|
+| Test | Name         | What the other threads do                            |
+|------+--------------+------------------------------------------------------|
+|    1 | map update   | assign to the value of a random key: every scan must |
+|      |              | see every record                                     |
+|    2 | map churn    | erase a random key, or put it back: every scan must  |
+|      |              | see keys in increasing order                         |
+|------+--------------+------------------------------------------------------|
+*/
+
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+
+#include "../common/barrier.h"
+#include "tests.h"
+
+using std::cout;
+using std::endl;
+
+/// configured via command line args: number of threads
+int  num_threads = 2;
+
+/// configured via command line args: records in the map
+long num_records = 100000;
+
+/// configured via command line args: the smallest batch
+long min_batch = 10;
+
+/// configured via command line args: the largest batch
+long max_batch = 100000;
+
+/// configured via command line args: full scans at each batch size
+int  num_scans = 10;
+
+/// what each thread measured at the current batch size
+scan_stats* thread_stats;
+
+/// the barrier to use when we are in concurrent mode
+barrier* global_barrier;
+
+/// the mutex to use when we are in concurrent mode with tm turned off
+std::mutex global_mutex;
+
+/// Report on how to use the command line to configure this program
+void usage()
+{
+    cout << "Command-Line Options:" << endl
+         << "  -n <int> : specify the number of threads (one scans)" << endl
+         << "  -r <int> : specify the number of records in the map" << endl
+         << "  -b <int> : specify the smallest batch" << endl
+         << "  -B <int> : specify the largest batch" << endl
+         << "  -s <int> : specify the full scans at each batch size" << endl
+         << "  -h       : display this message" << endl
+         << "  -T       : enable all tests" << endl
+         << "  -t <int> : enable a specific test" << endl
+         << "               1 map update" << endl
+         << "               2 map churn" << endl
+         << endl;
+    exit(0);
+}
+
+const int NUM_TESTS = 3;
+
+bool test_flags[NUM_TESTS] = {false};
+
+void (*test_names[NUM_TESTS])(int) = {
+    NULL,
+    map_update_scan_tests,                              // map.cc
+    map_churn_scan_tests                                // map.cc
+};
+
+/// Parse command line arguments using getopt()
+void parseargs(int argc, char** argv)
+{
+    // parse the command-line options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:b:B:s:hTt:")) != -1) {
+        switch (opt) {
+          case 'n': num_threads = atoi(optarg); break;
+          case 'r': num_records = atol(optarg); break;
+          case 'b': min_batch = atol(optarg);   break;
+          case 'B': max_batch = atol(optarg);   break;
+          case 's': num_scans = atoi(optarg);   break;
+          case 'h': usage();                    break;
+          case 't': test_flags[atoi(optarg)] = true; break;
+          case 'T': for (int i = 1; i < NUM_TESTS; ++i) test_flags[i] = true; break;
+        }
+    }
+    if (num_threads < 1 || num_records < 1 || min_batch < 1 || num_scans < 1)
+        usage();
+}
+
+/// Run the requested benchmarks.  This is called by every thread
+void per_thread_test(int id)
+{
+    // wait for all threads to be ready
+    global_barrier->arrive(id);
+
+    // run the tests that were requested on the command line
+    for (int i = 0; i < NUM_TESTS; ++i)
+        if (test_flags[i])
+            test_names[i](id);
+}
+
+/// main() just parses arguments, makes a barrier, and starts threads
+int main(int argc, char** argv)
+{
+    // figure out what we're doing
+    parseargs(argc, argv);
+
+    // set up the barrier
+    global_barrier = new barrier(num_threads);
+    thread_stats = new scan_stats[num_threads];
+
+    // make threads
+    std::thread* threads = new std::thread[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = std::thread(per_thread_test, i);
+
+    // wait for the threads to finish
+    for (int i = 0; i < num_threads; ++i)
+        threads[i].join();
+}
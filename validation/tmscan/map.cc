@@ -0,0 +1,185 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#ifdef USE_TM
+#  include <ext/scan_cursor.h>
+#endif
+#include "tests.h"
+#include "../common/workload.h"
+
+namespace
+{
+    typedef std::map<long, long> container;
+
+#ifdef USE_TM
+    typedef __gnu_cxx::scan_cursor<container> cursor;
+#else
+    /// The other libraries have no scan_cursor: the same batches, by hand
+    class cursor
+    {
+        long last;
+        long batch;
+        bool started;
+        bool finished;
+
+      public:
+        explicit cursor(long b)
+            : last(), batch(b), started(false), finished(false) { }
+
+        bool done() const { return finished; }
+
+        template <class F>
+        long next(const container& c, F f)
+        {
+            container::const_iterator i =
+                started ? c.upper_bound(last) : c.begin();
+            long n = 0;
+            for (; i != c.end() && n < batch; ++i, ++n) {
+                f(*i);
+                last = i->first;
+                started = true;
+            }
+            finished = (i == c.end());
+            return n;
+        }
+    };
+#endif
+
+    /// The map that every thread works on, made by thread 0
+    container* shared_map;
+
+    /// Whether thread 0 is still scanning at the current batch size
+    std::atomic<bool> scanning;
+
+    /// What a scan has seen so far.  Each attempt at a batch starts over
+    /// from what the committed batches saw.
+    struct scan_state
+    {
+        long prev = -1;
+        long seen = 0;
+        bool ordered = true;
+    };
+
+    /// Assign to the value of a random key, which is always there
+    struct update_op
+    {
+        static void run(container& m, long key) { m[key] += 1; }
+
+        static bool check(const scan_state& s)
+        {
+            return s.ordered && s.seen == num_records;
+        }
+    };
+
+    /// Erase a random key, or put it back if it was gone
+    struct churn_op
+    {
+        static void run(container& m, long key)
+        {
+            if (!m.erase(key))
+                m.emplace(key, key);
+        }
+
+        static bool check(const scan_state& s) { return s.ordered; }
+    };
+
+    /**
+     * At every batch size, thread 0 scans the shared map num_scans times,
+     * a batch per transaction, while the other threads run O on random
+     * keys, a transaction each, until it is done.
+     */
+    template <class O>
+    void run_scan(int id, const char* name)
+    {
+        typedef std::chrono::steady_clock clock;
+        fastrand rng(id + 1);
+
+        if (id == 0) {
+            shared_map = new container();
+            for (long k = 0; k < num_records; ++k)
+                shared_map->emplace_hint(shared_map->end(), k, k);
+        }
+
+        for (long batch = min_batch; batch <= max_batch; batch *= 10) {
+            // thread 0 may still be reporting the last batch size
+            global_barrier->arrive(id);
+            scan_stats& st = thread_stats[id];
+            st = scan_stats();
+            if (id == 0)
+                scanning = true;
+            global_barrier->arrive(id);
+
+            if (id != 0) {
+                while (scanning.load(std::memory_order_relaxed)) {
+                    long key = rng.next() % num_records;
+                    BEGIN_TX;
+                    O::run(*shared_map, key);
+                    END_TX;
+                    ++st.updates;
+                }
+            }
+            else {
+                auto start = clock::now();
+                for (int s = 0; s < num_scans; ++s) {
+                    cursor cur(batch);
+                    scan_state seen, chunk;
+                    auto visit = [&chunk](const container::value_type& v) {
+                        if (v.first <= chunk.prev)
+                            chunk.ordered = false;
+                        chunk.prev = v.first;
+                        ++chunk.seen;
+                    };
+                    do {
+                        unsigned long retries = tm_thread_retries();
+                        BEGIN_TX;
+                        chunk = seen;
+                        cur.next(*shared_map, visit);
+                        END_TX;
+                        seen = chunk;
+                        st.retries += tm_thread_retries() - retries;
+                        ++st.batches;
+                    } while (!cur.done());
+                    ++st.scans;
+                    st.bad += !O::check(seen);
+                }
+                st.ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+                    (clock::now() - start).count();
+                scanning = false;
+            }
+            global_barrier->arrive(id);
+
+            if (id == 0) {
+                unsigned long updates = 0;
+                for (int t = 1; t < num_threads; ++t)
+                    updates += thread_stats[t].updates;
+                double tries = st.batches + st.retries;
+                if (st.bad)
+                    printf(" [%s] %lu scans saw the wrong contents\n", name,
+                           st.bad);
+                printf("  %-10s %8ld batch %3d threads %10.3f ms/scan"
+                       " %8.2f retries/batch %6.2f%% aborted"
+                       " %12.0f updates/s\n", name, batch, num_threads,
+                       st.ns / (double)st.scans / 1e6,
+                       st.retries / (double)st.batches,
+                       100.0 * st.retries / tries, updates / (st.ns / 1e9));
+            }
+        }
+
+        global_barrier->arrive(id);
+        if (id == 0) {
+            delete shared_map;
+            shared_map = NULL;
+        }
+    }
+}
+
+void map_update_scan_tests(int id)
+{
+    run_scan<update_op>(id, "map update");
+}
+
+void map_churn_scan_tests(int id)
+{
+    run_scan<churn_op>(id, "map churn");
+}
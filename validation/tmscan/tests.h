@@ -0,0 +1,34 @@
+#include <mutex>
+#include "../common/tm.h"
+
+#pragma once
+
+/**
+ * This header is just a convenience for listing all the different
+ * benchmarks that we might run.
+ */
+
+/// What one thread measured at one batch size
+struct scan_stats
+{
+    unsigned long long ns;          // of the scans, on the scanning thread
+    unsigned long      scans;       // full scans
+    unsigned long      batches;     // scan transactions that committed
+    unsigned long      retries;     // of the scan transactions
+    unsigned long      bad;         // scans that saw the wrong contents
+    unsigned long      updates;     // on the other threads
+};
+
+/// configured via the command line
+extern int  num_threads;
+extern long num_records;
+extern long min_batch;
+extern long max_batch;
+extern int  num_scans;
+
+/// one per thread
+extern scan_stats* thread_stats;
+
+// scanning a map while the other threads update it, from map.cc
+void map_update_scan_tests(int id);
+void map_churn_scan_tests(int id);
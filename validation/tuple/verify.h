@@ -2,54 +2,48 @@
 #pragma once
 
 #include <initializer_list>
-
+#include "../common/fingerprint.h"
 using std::initializer_list;
 
+/// Checks the three members of a tuple against the expected values, in
+/// order
 class verifier
 {
-    /// max number of things we can store in the verifier
-    static const int SIZE = 256;
-
-    /// storage for stuff we need to verify
-    int data[SIZE];
+    /// fingerprint of the values inserted so far
+    fingerprint seen;
     int count;
 
   public:
-    /// construct by filling with -2 and setting count to 0
-    verifier() : count(0)
-    {
-        for (int i = 0; i < SIZE; ++i) {
-            data[i] = -2;
-        }
-    }
+    /// construct with nothing seen and count at 0
+    verifier() : count(0) { }
 
     /// add something to the verifier
     void insert(int i)
     {
-        data[count++] = i;
+        seen.add(i);
+        ++count;
     }
 
     template <class T>
     void insert_all(T* i)
     {
-        data[count++] = std::get<0>(*i);
-        data[count++] = std::get<1>(*i);
-        data[count++] = std::get<2>(*i);
+        insert(std::get<0>(*i));
+        insert(std::get<1>(*i));
+        insert(std::get<2>(*i));
     }
 
     void check(const char* test_name, int thread_id, int expected_size,
                initializer_list<int> expected_data)
     {
-        bool ok = true;
-        int  c  = 0;
-        for (auto i : expected_data)
-            ok &= (i == data[c++]);
+        fingerprint expected;
+        bool ok = expected.add_expected(expected_data, expected_size)
+               && seen.same_sequence(expected);
         if (count != expected_size)
             printf(" [%d] size did not match %d != %d\n", thread_id, count, expected_size);
         else if (!ok)
-            printf(" [%d] array copy did not match\n", c);
+            printf(" [%d] contents did not match\n", thread_id);
         else if (thread_id == 0)
-            printf(" [OK::count] %s\n", test_name);
+            printf(" [OK::count+data] %s\n", test_name);
     }
 
     void check_size(const char* test_name, int thread_id, int expected_size)
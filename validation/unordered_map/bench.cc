@@ -77,6 +77,13 @@
 |                  | clear                 |                1 |                1 |
 |                  | emplace               |                1 |                1 |
 |                  | emplace_hint          |                1 |                1 |
+|                  | try_emplace (C++17)   |                  |             1, 2 |
+|                  | insert_or_assign      |                  |             1, 2 |
+|                  | (C++17)               |                  |                  |
+|                  | extract (C++17)       |                  |                1 |
+|                  | insert node_type      |                  |          1, 2, 3 |
+|                  | (C++17)               |                  |                  |
+|                  | merge (C++17)         |                  |                1 |
 |------------------+-----------------------+------------------+------------------|
 | Buckets          | bucket_count          |                1 |                1 |
 | (DONE)           | max_bucket_count      |                1 |                1 |
@@ -12,6 +12,200 @@ typedef map_verifier verifier;
 
 static intmap* member_map = NULL;
 
+#ifdef USE_TM
+/// try_emplace and insert_or_assign are from C++17, and of the libraries
+/// we build with, only the TM one has them
+void try_emplace_tests(int id)
+{
+    // test try_emplace: only a missing key makes a pair
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}});
+        auto r1 = member_map->try_emplace(42, 42);
+        auto r2 = member_map->try_emplace(2, 20);
+        ok = r1.second && !r2.second && r2.first->second == 2;
+        v.insert_all<intmap>(member_map);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in try_emplace()" << std::endl;
+        v.check("try_emplace (1)", id, 6, {1, 1, 2, 2, 42, 42});
+    }
+
+    // test try_emplace with hint
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}});
+        member_map->try_emplace(member_map->begin(), 42, 42);
+        member_map->try_emplace(member_map->begin(), 1, 10);
+        v.insert_all<intmap>(member_map);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        v.check("try_emplace (2)", id, 4, {1, 1, 42, 42});
+    }
+
+    // test insert_or_assign
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}});
+        auto r1 = member_map->insert_or_assign(2, 20);
+        auto r2 = member_map->insert_or_assign(42, 42);
+        ok = !r1.second && r2.second;
+        v.insert_all<intmap>(member_map);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in insert_or_assign()" << std::endl;
+        v.check("insert_or_assign (1)", id, 6, {1, 1, 2, 20, 42, 42});
+    }
+
+    // test insert_or_assign with hint
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}});
+        member_map->insert_or_assign(member_map->begin(), 42, 42);
+        member_map->insert_or_assign(member_map->begin(), 1, 10);
+        v.insert_all<intmap>(member_map);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        v.check("insert_or_assign (2)", id, 4, {1, 10, 42, 42});
+    }
+}
+
+/// A hash that spreads keys over other buckets than std::hash does, for
+/// merging between maps that hash differently
+struct shifted_hash
+{
+    size_t operator()(int k) const noexcept { return std::hash<int>()(k) + 1; }
+};
+
+/// Node handles are from C++17 too: extract, insert of a node_type, and
+/// merge move pairs between maps by relinking their nodes
+void node_handle_tests(int id)
+{
+    // test extract, by key and by position
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}, {3, 3}, {42, 42}});
+        auto n1 = member_map->extract(2);
+        auto n2 = member_map->extract(member_map->find(42));
+        auto n3 = member_map->extract(5);
+        ok = !n1.empty() && n1.key() == 2 && n1.mapped() == 2
+          && !n2.empty() && n2.key() == 42 && n3.empty();
+        v.insert_all<intmap>(member_map);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in extract()" << std::endl;
+        v.check("extract (1)", id, 4, {1, 1, 3, 3});
+    }
+
+    // test insert of a node_type: the node goes in if its key is new, and
+    // otherwise comes back in the result
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}, {3, 3}});
+        intmap* other = new intmap({{3, 30}});
+        auto r1 = other->insert(member_map->extract(2));
+        auto r2 = other->insert(member_map->extract(3));
+        ok = r1.inserted && r1.node.empty() && r1.position->first == 2
+          && !r2.inserted && r2.node.mapped() == 3
+          && r2.position->second == 30 && member_map->size() == 1;
+        v.insert_all<intmap>(other);
+        delete(other);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in insert(node_type&&)" << std::endl;
+        v.check("insert node_type (1)", id, 4, {2, 2, 3, 30});
+    }
+
+    // test insert of a node_type with hint, after changing its key
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}});
+        auto n = member_map->extract(1);
+        n.key() = 42;
+        member_map->insert(member_map->begin(), std::move(n));
+        v.insert_all<intmap>(member_map);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        v.check("insert node_type (2)", id, 4, {2, 2, 42, 1});
+    }
+
+    // test insert of a node_type with hint, when the key is there already:
+    // the handle keeps the node
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}});
+        intmap* other = new intmap({{2, 20}});
+        auto n = other->extract(2);
+        auto i = member_map->insert(member_map->begin(), std::move(n));
+        ok = !n.empty() && n.key() == 2 && n.mapped() == 20
+          && i->second == 2 && member_map->size() == 2;
+        v.insert_all<intmap>(member_map);
+        delete(other);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in insert(hint, node_type&&)"
+                      << std::endl;
+        v.check("insert node_type (3)", id, 4, {1, 1, 2, 2});
+    }
+
+    // test merge, from a map that hashes differently: keys that are
+    // already here stay in the source
+    global_barrier->arrive(id);
+    {
+        typedef std::unordered_map<int, int, shifted_hash> othermap;
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        member_map = new intmap({{1, 1}, {2, 2}, {42, 42}});
+        othermap* other = new othermap({{2, 20}, {5, 50}});
+        member_map->merge(*other);
+        ok = other->size() == 1 && other->begin()->second == 20;
+        v.insert_all<intmap>(member_map);
+        delete(other);
+        delete(member_map);
+        member_map = NULL;
+        END_TX;
+        if (!ok)
+            std::cout << "["<<id<<"] error in merge()" << std::endl;
+        v.check("merge (1)", id, 8, {1, 1, 2, 2, 5, 50, 42, 42});
+    }
+}
+#endif
+
 void modifier_tests(int id)
 {
     // test emplace
@@ -133,7 +327,7 @@ void modifier_tests(int id)
         verifier v;
         BEGIN_TX;
         member_map = new intmap({{1, 1}, {2, 2}, {3, 3}});
-        member_map->erase(member_map->begin());
+        member_map->erase(member_map->find(1));
         v.insert_all<intmap>(member_map);
         delete(member_map);
         member_map = NULL;
@@ -198,4 +392,8 @@ void modifier_tests(int id)
         v.check_size("clear (1)", id, 0);
     }
 
+#ifdef USE_TM
+    try_emplace_tests(id);
+    node_handle_tests(id);
+#endif
 }
@@ -2,37 +2,33 @@
 #pragma once
 
 #include <initializer_list>
+#include "../common/fingerprint.h"
 using std::initializer_list;
 
+/// Checks the elements of an unordered_set against the expected values, in
+/// any order
 class verifier
 {
-    /// max number of things we can store in the verifier
-    static const int SIZE = 256;
-
-    /// storage for stuff we need to verify
-    int data[SIZE];
+    /// fingerprint of the values inserted so far
+    fingerprint seen;
     int count;
 
   public:
-    /// construct by filling with -2 and setting count to 0
-    verifier() : count(0)
-    {
-        for (int i = 0; i < SIZE; ++i) {
-            data[i] = -2;
-        }
-    }
+    /// construct with nothing seen and count at 0
+    verifier() : count(0) { }
 
     /// add something to the verifier
     void insert(int i)
     {
-        data[count++] = i;
+        seen.add(i);
+        ++count;
     }
 
     template <class T>
     void insert_all(T* in)
     {
         for (auto i : *in)
-            data[count++] = i;
+            insert(i);
     }
 
     template <class T>
@@ -44,12 +40,13 @@ class verifier
     void check(const char* test_name, int thread_id, int expected_size,
                initializer_list<int> expected_data)
     {
-        bool ok = true;
-        int  c  = 0;
+        fingerprint expected;
+        bool ok = expected.add_expected(expected_data, expected_size)
+               && seen.same_multiset(expected);
         if (count != expected_size)
             printf(" [%d] size did not match %d != %d\n", thread_id, count, expected_size);
         else if (!ok)
-            printf(" [%d] array copy did not match\n");
+            printf(" [%d] contents did not match\n", thread_id);
         else if (thread_id == 0)
             printf(" [OK::count+data] %s\n", test_name);
     }
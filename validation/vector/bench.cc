@@ -107,6 +107,11 @@
 |                   | '>='            |  5b               | 5b             |
 |                   | swap            |  1                | 1              |
 |-------------------+-----------------+-------------------+----------------|
+
+  Test 14 runs the subset of these that the TM library's
+  __gnu_cxx::segmented_vector has (see ext/segmented_vector.h) on one: the
+  constructors, operator=, iterators, capacity, element access, and the
+  modifiers at the end.
 */
 
 #include <cstdio>
@@ -153,6 +158,7 @@ void usage()
          << "              11 observer methods" << endl
          << "              12 relational operator use" << endl
          << "              13 swap use" << endl
+         << "              14 __gnu_cxx::segmented_vector (TM build only)" << endl
          << endl
          << "  Note: const, reverse, and const reverse iterators not tested"
          << endl
@@ -160,7 +166,7 @@ void usage()
     exit(0);
 }
 
-#define NUM_TESTS 14
+#define NUM_TESTS 15
 bool test_flags[NUM_TESTS] = {false};
 
 void (*test_names[NUM_TESTS])(int) = {
@@ -177,7 +183,8 @@ void (*test_names[NUM_TESTS])(int) = {
     modifier_tests,                                     // modifier.cc
     observer_tests,                                     // observer.cc
     relational_operator_tests,                          // overloads.cc
-    swap_tests                                          // overloads.cc
+    swap_tests,                                         // overloads.cc
+    segmented_vector_tests                              // segmented.cc
 };
 
 /// Parse command line arguments using getopt()
@@ -0,0 +1,142 @@
+#include <iostream>
+#include "tests.h"
+#include "verify.h"
+
+#ifdef USE_TM
+#include <ext/segmented_vector.h>
+
+using __gnu_cxx::segmented_vector;
+
+/// The segmented_vector we will use for our tests
+segmented_vector<int>* segmented_vec = NULL;
+#endif
+
+void segmented_vector_tests(int id)
+{
+#ifdef USE_TM
+    global_barrier->arrive(id);
+    if (id == 0)
+        printf("Testing __gnu_cxx::segmented_vector: ctor(4), push_back(2), "
+               "emplace_back(1), pop_back(1), resize(2), clear(1), "
+               "shrink_to_fit(1), operator[](1), at(1), front(1), back(1), "
+               "iterators(1), operator=(3), swap(1), relational(2)\n");
+
+    // Test construction and push_back past the first segments
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        BEGIN_TX;
+        segmented_vec = new segmented_vector<int>({1, 2, 3});
+        for (int i = 4; i <= 40; ++i)
+            segmented_vec->push_back(i);
+        segmented_vec->emplace_back(41);
+        v.insert_all(segmented_vec);
+        delete(segmented_vec);
+        END_TX;
+        v.check("ilist ctor, push_back, emplace_back", id, 41,
+                {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17,
+                 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32,
+                 33, 34, 35, 36, 37, 38, 39, 40, 41});
+    }
+
+    // Test that elements do not move as the container grows
+    global_barrier->arrive(id);
+    {
+        bool ok = true;
+        BEGIN_TX;
+        segmented_vec = new segmented_vector<int>(5, 7);
+        int* first = &(*segmented_vec)[0];
+        int* last = &segmented_vec->back();
+        auto i = segmented_vec->begin() + 4;
+        for (int j = 0; j < 1000; ++j)
+            segmented_vec->push_back(j);
+        ok &= first == &segmented_vec->front();
+        ok &= last == &(*segmented_vec)[4];
+        ok &= &*i == last;
+        ok &= segmented_vec->size() == 1005;
+        ok &= segmented_vec->capacity() >= 1005;
+        delete(segmented_vec);
+        END_TX;
+        if (!ok)
+            printf(" [%d] segmented_vector stability test failed\n", id);
+        else if (id == 0)
+            printf(" [OK] %s\n", "segmented_vector element stability");
+    }
+
+    // Test resize, pop_back, clear and shrink_to_fit
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        segmented_vec = new segmented_vector<int>(100);
+        segmented_vec->resize(2);
+        segmented_vec->resize(5, 6);
+        segmented_vec->pop_back();
+        v.insert_all(segmented_vec);
+        segmented_vec->clear();
+        ok &= segmented_vec->empty() && segmented_vec->capacity() >= 100;
+        segmented_vec->shrink_to_fit();
+        ok &= segmented_vec->capacity() == 0;
+        delete(segmented_vec);
+        END_TX;
+        v.check("resize (1) and (2), pop_back", id, 4, {0, 0, 6, 6});
+        if (!ok)
+            printf(" [%d] segmented_vector clear test failed\n", id);
+        else if (id == 0)
+            printf(" [OK] %s\n", "segmented_vector clear, shrink_to_fit");
+    }
+
+    // Test element access and iterator arithmetic
+    global_barrier->arrive(id);
+    {
+        bool ok = true;
+        BEGIN_TX;
+        segmented_vec = new segmented_vector<int>();
+        for (int j = 0; j < 100; ++j)
+            segmented_vec->push_back(j);
+        ok &= segmented_vec->front() == 0 && segmented_vec->back() == 99;
+        ok &= segmented_vec->at(50) == 50 && (*segmented_vec)[17] == 17;
+        auto i = segmented_vec->cbegin() + 30;
+        ok &= i[3] == 33 && *(i - 14) == 16;
+        ok &= segmented_vec->cend() - i == 70 && i < segmented_vec->end();
+        ok &= *segmented_vec->rbegin() == 99;
+        delete(segmented_vec);
+        END_TX;
+        if (!ok)
+            printf(" [%d] segmented_vector element access test failed\n", id);
+        else if (id == 0)
+            printf(" [OK] %s\n", "segmented_vector element access");
+    }
+
+    // Test copy, move, assignment, swap and comparison
+    global_barrier->arrive(id);
+    {
+        verifier v;
+        bool ok = true;
+        BEGIN_TX;
+        segmented_vec = new segmented_vector<int>({5, 6, 7});
+        segmented_vector<int> copy(*segmented_vec);
+        segmented_vector<int> moved(std::move(copy));
+        ok &= copy.empty() && moved == *segmented_vec;
+        moved.push_back(8);
+        ok &= *segmented_vec < moved && moved != *segmented_vec;
+        copy = moved;
+        *segmented_vec = {1, 2};
+        swap(*segmented_vec, copy);
+        copy = std::move(*segmented_vec);
+        v.insert_all(&copy);
+        delete(segmented_vec);
+        END_TX;
+        v.check("copy, move, operator=, swap", id, 4, {5, 6, 7, 8});
+        if (!ok)
+            printf(" [%d] segmented_vector relational test failed\n", id);
+        else if (id == 0)
+            printf(" [OK] %s\n", "segmented_vector ==, !=, <");
+    }
+#else
+    // segmented_vector is only in the TM library
+    if (id == 0)
+        printf("Skipping __gnu_cxx::segmented_vector: TM build only\n");
+#endif
+}
@@ -39,3 +39,6 @@ void relational_operator_tests(int id);
 
 // test swap operation
 void swap_tests(int id);
+
+// the TM library's segmented_vector, from segmented.cc
+void segmented_vector_tests(int id);